@@ -0,0 +1,210 @@
+#pragma once
+
+#include <library/network/packet/buffer_heap.h>
+#include <library/network/packet/packet.h>
+
+#include <concepts>
+#include <cstdlib>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+
+namespace bcpp::network::benchmark
+{
+
+    //=========================================================================
+    // every allocator under test hands out buffers of buffer_heap::buffer_capacity
+    // bytes through the same interface so that the scenarios are independent of
+    // the allocator.  'handle' is whatever the allocator hands out (a raw buffer
+    // or a packet) and is invalid if the allocation failed.
+    template <typename T>
+    concept allocator_concept = requires (T t, typename T::handle h)
+    {
+        {t.allocate()} -> std::same_as<typename T::handle>;
+        {t.release(std::move(h))};
+        {T::is_valid(h)} -> std::same_as<bool>;
+        {T::touch(h)};
+    };
+
+
+    //=========================================================================
+    // common handle operations for allocators of raw buffers
+    struct buffer_handle
+    {
+        using handle = std::span<char>;
+
+        static bool is_valid(handle const & buffer){return (buffer.data() != nullptr);}
+
+        static void touch(handle & buffer){buffer[0] = 0;}
+    };
+
+
+    //=========================================================================
+    // common handle operations for allocators of packets
+    struct packet_handle
+    {
+        using handle = packet;
+
+        static bool is_valid(handle const & p){return (bool)p;}
+
+        static void touch(handle & p){p.data()[0] = 0;}
+
+        static void release(handle && p){handle discard(std::move(p));}
+    };
+
+
+    //=========================================================================
+    // the library's lock free buffer heap
+    class buffer_heap_allocator :
+        public buffer_handle
+    {
+    public:
+
+        static auto constexpr name = "buffer_heap";
+
+        buffer_heap_allocator
+        (
+            std::size_t capacity
+        ):
+            bufferHeap_(std::make_unique<buffer_heap>(buffer_heap::configuration{.capacity_ = capacity}))
+        {
+        }
+
+        std::span<char> allocate(){return bufferHeap_->pop();}
+
+        void release(std::span<char> buffer){bufferHeap_->push(buffer);}
+
+    private:
+
+        std::unique_ptr<buffer_heap>    bufferHeap_;
+    };
+
+
+    //=========================================================================
+    // the general purpose allocator (whichever malloc the benchmark is linked with)
+    class malloc_allocator :
+        public buffer_handle
+    {
+    public:
+
+        static auto constexpr name = "malloc";
+
+        malloc_allocator
+        (
+            std::size_t
+        )
+        {
+        }
+
+        std::span<char> allocate()
+        {
+            auto * buffer = static_cast<char *>(std::malloc(buffer_heap::buffer_capacity));
+            return (buffer != nullptr) ? std::span<char>(buffer, buffer_heap::buffer_capacity) : std::span<char>{};
+        }
+
+        void release(std::span<char> buffer){std::free(buffer.data());}
+    };
+
+
+    //=========================================================================
+    // a per thread cache in front of malloc.  buffers are returned to the cache
+    // of the releasing thread (not the allocating thread) and a cache which grows
+    // beyond 'max_cached' returns the excess to malloc.  this is the usual
+    // alternative to a shared lock free heap.
+    class thread_local_pool_allocator :
+        public buffer_handle
+    {
+    public:
+
+        static auto constexpr name = "thread_local_pool";
+        static auto constexpr max_cached = 1024;
+
+        thread_local_pool_allocator
+        (
+            std::size_t
+        )
+        {
+        }
+
+        std::span<char> allocate()
+        {
+            auto & cache = get_cache();
+            if (cache.empty())
+                return malloc_allocator(0).allocate();
+            auto buffer = cache.back();
+            cache.pop_back();
+            return buffer;
+        }
+
+        void release(std::span<char> buffer)
+        {
+            if (auto & cache = get_cache(); cache.size() < max_cached)
+                cache.push_back(buffer);
+            else
+                std::free(buffer.data());
+        }
+
+    private:
+
+        struct cache_type : std::vector<std::span<char>>
+        {
+            cache_type(){reserve(max_cached);}
+            ~cache_type(){for (auto buffer : *this) std::free(buffer.data());}
+        };
+
+        static cache_type & get_cache()
+        {
+            static thread_local cache_type cache;
+            return cache;
+        }
+    };
+
+
+    //=========================================================================
+    // packet construction from a buffer heap (which falls back to new char[] when
+    // the heap is exhausted) and destruction
+    class heap_packet_allocator :
+        public packet_handle
+    {
+    public:
+
+        static auto constexpr name = "packet_buffer_heap";
+
+        heap_packet_allocator
+        (
+            std::size_t capacity
+        ):
+            bufferHeap_(std::make_unique<buffer_heap>(buffer_heap::configuration{.capacity_ = capacity}))
+        {
+        }
+
+        packet allocate(){return packet(*bufferHeap_);}
+
+    private:
+
+        std::unique_ptr<buffer_heap>    bufferHeap_;
+    };
+
+
+    //=========================================================================
+    // packet construction from process memory (new char[]) and destruction
+    class new_packet_allocator :
+        public packet_handle
+    {
+    public:
+
+        static auto constexpr name = "packet_new";
+
+        new_packet_allocator
+        (
+            std::size_t
+        )
+        {
+        }
+
+        packet allocate(){return packet(buffer_heap::buffer_capacity);}
+    };
+
+} // namespace bcpp::network::benchmark
@@ -0,0 +1,136 @@
+#include "./scenarios.h"
+#include "../common/command_line.h"
+
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+
+
+namespace
+{
+
+    using namespace bcpp::network::benchmark;
+    using run_function = std::function<benchmark_result(run_configuration const &)>;
+
+
+    //=========================================================================
+    template <allocator_concept A>
+    std::map<std::string, run_function> get_scenarios
+    (
+    )
+    {
+        return {
+                {"allocate_release", allocate_release<A>},
+                {"batch", batch<A>},
+                {"producer_consumer", producer_consumer<A>},
+                {"exhaustion", exhaustion<A>}
+            };
+    }
+
+
+    //=========================================================================
+    void print_usage
+    (
+    )
+    {
+        std::cout << "usage: buffer_heap_benchmark [options]\n"
+                "  --allocators=<list>      buffer_heap,malloc,thread_local_pool,packet_buffer_heap,packet_new (default all)\n"
+                "  --scenarios=<list>       allocate_release,batch,producer_consumer,exhaustion (default all)\n"
+                "  --threads=<list>         thread counts (default 1,2,4,8,16,32,64)\n"
+                "  --duration-ms=<n>        duration of each run (default 1000)\n"
+                "  --heap-capacity=<n>      buffers per heap (default " << bcpp::network::buffer_heap::default_heap_capacity << ")\n"
+                "  --batch-size=<n>         buffers held per thread in the batch scenario (default 64)\n"
+                "  --format=<format>        text, json or csv (default text)\n"
+                "  --output=<path>          write the report to a file rather than stdout\n";
+    }
+
+} // namespace
+
+
+//=============================================================================
+int main
+(
+    int argc,
+    char ** argv
+)
+{
+    static std::map<std::string, std::map<std::string, run_function>> const allocators
+    {
+        {buffer_heap_allocator::name, get_scenarios<buffer_heap_allocator>()},
+        {malloc_allocator::name, get_scenarios<malloc_allocator>()},
+        {thread_local_pool_allocator::name, get_scenarios<thread_local_pool_allocator>()},
+        {heap_packet_allocator::name, get_scenarios<heap_packet_allocator>()},
+        {new_packet_allocator::name, get_scenarios<new_packet_allocator>()}
+    };
+
+    command_line commandLine(argc, argv);
+    if (commandLine.has("help"))
+    {
+        print_usage();
+        return 0;
+    }
+
+    auto outputFormat = parse_output_format(commandLine.get("format", "text"));
+    if (outputFormat == output_format::undefined)
+    {
+        std::cerr << "unknown output format\n";
+        print_usage();
+        return -1;
+    }
+
+    std::vector<benchmark_result> results;
+    for (auto const & allocatorName : commandLine.get_list("allocators", "buffer_heap,malloc,thread_local_pool,packet_buffer_heap,packet_new"))
+    {
+        auto allocator = allocators.find(allocatorName);
+        if (allocator == allocators.end())
+        {
+            std::cerr << "unknown allocator: " << allocatorName << "\n";
+            print_usage();
+            return -1;
+        }
+        for (auto const & scenarioName : commandLine.get_list("scenarios", "allocate_release,batch,producer_consumer,exhaustion"))
+        {
+            auto scenario = allocator->second.find(scenarioName);
+            if (scenario == allocator->second.end())
+            {
+                std::cerr << "unknown scenario: " << scenarioName << "\n";
+                print_usage();
+                return -1;
+            }
+            // exhaustion is single threaded
+            auto threadCounts = (scenarioName == "exhaustion") ? std::vector<std::uint64_t>{1} : commandLine.get_integer_list("threads", "1,2,4,8,16,32,64");
+            for (auto threads : threadCounts)
+            {
+                run_configuration runConfiguration
+                {
+                    .threads_ = std::max(threads, std::uint64_t{1}),
+                    .duration_ = std::chrono::milliseconds(commandLine.get_integer("duration-ms", 1000)),
+                    .heapCapacity_ = commandLine.get_integer("heap-capacity", bcpp::network::buffer_heap::default_heap_capacity),
+                    .batchSize_ = std::max(commandLine.get_integer("batch-size", 64), std::uint64_t{1})
+                };
+                std::cerr << "running " << allocatorName << " " << scenarioName << " threads = " << runConfiguration.threads_ << "\n";
+                auto result = scenario->second(runConfiguration);
+                result.name_ = allocatorName + "/" + result.name_;
+                result.add_parameter("threads", runConfiguration.threads_);
+                results.push_back(std::move(result));
+            }
+        }
+    }
+
+    if (commandLine.has("output"))
+    {
+        std::ofstream stream(commandLine.get("output", {}));
+        if (!stream)
+        {
+            std::cerr << "failed to open " << commandLine.get("output", {}) << "\n";
+            return -1;
+        }
+        write_report(stream, results, outputFormat);
+    }
+    else
+    {
+        write_report(std::cout, results, outputFormat);
+    }
+    return 0;
+}
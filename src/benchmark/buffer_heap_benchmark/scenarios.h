@@ -0,0 +1,311 @@
+#pragma once
+
+#include "./allocators.h"
+#include "../common/benchmark_report.h"
+#include "../common/latency_recorder.h"
+
+#include <library/network/queue/fixed_queue.h>
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <latch>
+#include <thread>
+#include <vector>
+
+
+namespace bcpp::network::benchmark
+{
+
+    //=========================================================================
+    struct run_configuration
+    {
+        std::size_t                 threads_;
+        std::chrono::nanoseconds    duration_;
+        std::size_t                 heapCapacity_;
+        std::size_t                 batchSize_;
+    };
+
+
+    //=========================================================================
+    // per thread tallies.  latency is sampled (one operation in 'sample_interval')
+    // so that reading the clock does not dominate the cost being measured.
+    struct thread_statistics
+    {
+        static auto constexpr sample_interval = 16;
+
+        std::uint64_t       operations_{0};
+        std::uint64_t       failedAllocations_{0};
+        latency_recorder    allocateLatency_;
+        latency_recorder    releaseLatency_;
+    };
+
+
+    //=========================================================================
+    inline void add_statistics
+    (
+        benchmark_result & result,
+        std::deque<thread_statistics> & statistics,
+        double elapsed
+    )
+    {
+        thread_statistics total;
+        for (auto const & s : statistics)
+        {
+            total.operations_ += s.operations_;
+            total.failedAllocations_ += s.failedAllocations_;
+            total.allocateLatency_.merge(s.allocateLatency_);
+            total.releaseLatency_.merge(s.releaseLatency_);
+        }
+        result.add_metric("operations", total.operations_);
+        result.add_metric("operations_per_second", total.operations_ / elapsed);
+        result.add_metric("failed_allocations", total.failedAllocations_);
+        result.add_latency("allocate", total.allocateLatency_.summarize());
+        result.add_latency("release", total.releaseLatency_.summarize());
+    }
+
+
+    //=========================================================================
+    // run 'numThreads' threads, each invoking 'work(index, stopFlag)', for the
+    // configured duration.  returns the elapsed time in seconds.
+    inline double run_threads
+    (
+        std::size_t numThreads,
+        std::chrono::nanoseconds duration,
+        auto work
+    )
+    {
+        using namespace std::chrono;
+        std::atomic<bool> stop{false};
+        std::latch ready(numThreads + 1);
+        steady_clock::time_point start;
+        {
+            std::vector<std::jthread> threads;
+            for (auto i = 0u; i < numThreads; ++i)
+                threads.emplace_back([&, i](){ready.arrive_and_wait(); work(i, stop);});
+            ready.arrive_and_wait();
+            start = steady_clock::now();
+            std::this_thread::sleep_for(duration);
+            stop = true;
+        }
+        return duration_cast<std::chrono::duration<double>>(steady_clock::now() - start).count();
+    }
+
+
+    //=========================================================================
+    // each thread repeatedly allocates, touches and releases one buffer.  the
+    // best case for every allocator (the buffer is hot and never changes thread).
+    template <allocator_concept A>
+    benchmark_result allocate_release
+    (
+        run_configuration const & runConfiguration
+    )
+    {
+        using namespace std::chrono;
+        benchmark_result result{.name_ = "allocate_release"};
+        A allocator(runConfiguration.heapCapacity_);
+        std::deque<thread_statistics> statistics(runConfiguration.threads_);
+
+        auto elapsed = run_threads(runConfiguration.threads_, runConfiguration.duration_, [&](auto index, auto const & stop)
+                {
+                    auto & s = statistics[index];
+                    while (!stop.load(std::memory_order_relaxed))
+                    {
+                        auto sample = ((s.operations_ % thread_statistics::sample_interval) == 0);
+                        auto t0 = sample ? steady_clock::now() : steady_clock::time_point{};
+                        auto h = allocator.allocate();
+                        auto t1 = sample ? steady_clock::now() : steady_clock::time_point{};
+                        if (!A::is_valid(h))
+                        {
+                            ++s.failedAllocations_;
+                            continue;
+                        }
+                        A::touch(h);
+                        auto t2 = sample ? steady_clock::now() : steady_clock::time_point{};
+                        allocator.release(std::move(h));
+                        if (sample)
+                        {
+                            s.allocateLatency_.record(t1 - t0);
+                            s.releaseLatency_.record(steady_clock::now() - t2);
+                        }
+                        ++s.operations_;
+                    }
+                });
+        add_statistics(result, statistics, elapsed);
+        return result;
+    }
+
+
+    //=========================================================================
+    // each thread allocates 'batchSize_' buffers and then releases them all.
+    // keeps many buffers outstanding which exercises the heap beyond the hot
+    // front (and exhausts it if threads * batchSize_ exceeds its capacity).
+    template <allocator_concept A>
+    benchmark_result batch
+    (
+        run_configuration const & runConfiguration
+    )
+    {
+        using namespace std::chrono;
+        benchmark_result result{.name_ = "batch"};
+        result.add_parameter("batch_size", runConfiguration.batchSize_);
+        A allocator(runConfiguration.heapCapacity_);
+        std::deque<thread_statistics> statistics(runConfiguration.threads_);
+
+        auto elapsed = run_threads(runConfiguration.threads_, runConfiguration.duration_, [&](auto index, auto const & stop)
+                {
+                    auto & s = statistics[index];
+                    std::vector<typename A::handle> handles;
+                    handles.reserve(runConfiguration.batchSize_);
+                    while (!stop.load(std::memory_order_relaxed))
+                    {
+                        auto t0 = steady_clock::now();
+                        for (auto i = 0u; i < runConfiguration.batchSize_; ++i)
+                        {
+                            if (auto h = allocator.allocate(); A::is_valid(h))
+                            {
+                                A::touch(h);
+                                handles.push_back(std::move(h));
+                            }
+                            else
+                            {
+                                ++s.failedAllocations_;
+                            }
+                        }
+                        auto t1 = steady_clock::now();
+                        for (auto & h : handles)
+                            allocator.release(std::move(h));
+                        auto t2 = steady_clock::now();
+                        if (!handles.empty())
+                        {
+                            // record the average per buffer for the batch
+                            s.allocateLatency_.record((t1 - t0) / handles.size());
+                            s.releaseLatency_.record((t2 - t1) / handles.size());
+                        }
+                        s.operations_ += handles.size();
+                        handles.clear();
+                    }
+                });
+        add_statistics(result, statistics, elapsed);
+        return result;
+    }
+
+
+    //=========================================================================
+    // half of the threads allocate and hand the buffers to the other half which
+    // release them.  this is the pattern of a receive thread handing packets to
+    // a worker and is the worst case for per thread caches (buffers migrate).
+    template <allocator_concept A>
+    benchmark_result producer_consumer
+    (
+        run_configuration const & runConfiguration
+    )
+    {
+        using namespace std::chrono;
+        static auto constexpr queue_capacity = 1024;
+
+        benchmark_result result{.name_ = "producer_consumer"};
+        auto numProducers = std::max(runConfiguration.threads_ / 2, std::size_t{1});
+        auto numConsumers = std::max(runConfiguration.threads_ - numProducers, std::size_t{1});
+        result.add_parameter("producers", numProducers);
+        result.add_parameter("consumers", numConsumers);
+
+        A allocator(runConfiguration.heapCapacity_);
+        std::deque<thread_statistics> statistics(numProducers + numConsumers);
+        std::deque<fixed_queue<typename A::handle>> queues;
+        for (auto i = 0u; i < numConsumers; ++i)
+            queues.emplace_back(queue_capacity, producer_mode::multi_producer);
+        std::atomic<std::size_t> producersRunning{numProducers};
+
+        auto elapsed = run_threads(numProducers + numConsumers, runConfiguration.duration_, [&](auto index, auto const & stop)
+                {
+                    auto & s = statistics[index];
+                    if (index < numProducers)
+                    {
+                        for (auto next = index; !stop.load(std::memory_order_relaxed); ++next)
+                        {
+                            auto sample = ((s.operations_ % thread_statistics::sample_interval) == 0);
+                            auto t0 = sample ? steady_clock::now() : steady_clock::time_point{};
+                            auto h = allocator.allocate();
+                            if (sample)
+                                s.allocateLatency_.record(steady_clock::now() - t0);
+                            if (!A::is_valid(h))
+                            {
+                                ++s.failedAllocations_;
+                                continue;
+                            }
+                            A::touch(h);
+                            auto queued = false;
+                            while ((!(queued = queues[next % numConsumers].emplace(std::move(h)))) && (!stop.load(std::memory_order_relaxed)))
+                                ;
+                            if (!queued)
+                                allocator.release(std::move(h)); // stopped while the queue was full
+                        }
+                        --producersRunning;
+                    }
+                    else
+                    {
+                        // operations are counted by the consumers only
+                        auto & queue = queues[index - numProducers];
+                        while ((producersRunning > 0) || (!queue.empty()))
+                        {
+                            if (auto * h = queue.front(); h != nullptr)
+                            {
+                                auto sample = ((s.operations_ % thread_statistics::sample_interval) == 0);
+                                auto t0 = sample ? steady_clock::now() : steady_clock::time_point{};
+                                allocator.release(std::move(*h));
+                                if (sample)
+                                    s.releaseLatency_.record(steady_clock::now() - t0);
+                                queue.discard();
+                                ++s.operations_;
+                            }
+                        }
+                    }
+                });
+        add_statistics(result, statistics, elapsed);
+        return result;
+    }
+
+
+    //=========================================================================
+    // a single thread allocates (without releasing) twice the heap's capacity.
+    // reports how many allocations succeeded and the cost of allocation before
+    // and after the heap is exhausted.  the packet allocator falls back to
+    // process memory once its heap is exhausted.
+    template <allocator_concept A>
+    benchmark_result exhaustion
+    (
+        run_configuration const & runConfiguration
+    )
+    {
+        using namespace std::chrono;
+        benchmark_result result{.name_ = "exhaustion"};
+        result.add_parameter("heap_capacity", runConfiguration.heapCapacity_);
+
+        A allocator(runConfiguration.heapCapacity_);
+        std::vector<typename A::handle> handles;
+        handles.reserve(runConfiguration.heapCapacity_ * 2);
+        latency_recorder before;
+        latency_recorder after;
+        std::uint64_t failed = 0;
+        for (auto i = 0u; i < runConfiguration.heapCapacity_ * 2; ++i)
+        {
+            auto t0 = steady_clock::now();
+            auto h = allocator.allocate();
+            ((i < runConfiguration.heapCapacity_) ? before : after).record(steady_clock::now() - t0);
+            if (A::is_valid(h))
+                handles.push_back(std::move(h));
+            else
+                ++failed;
+        }
+        for (auto & h : handles)
+            allocator.release(std::move(h));
+
+        result.add_metric("successful_allocations", handles.size());
+        result.add_metric("failed_allocations", failed);
+        result.add_latency("allocate_within_capacity", before.summarize());
+        result.add_latency("allocate_beyond_capacity", after.summarize());
+        return result;
+    }
+
+} // namespace bcpp::network::benchmark
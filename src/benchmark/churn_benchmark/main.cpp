@@ -0,0 +1,396 @@
+#include "../common/benchmark_report.h"
+#include "../common/command_line.h"
+#include "../common/latency_recorder.h"
+
+#include <library/network.h>
+#include <library/network/socket/private/socket_impl_allocator.h>
+
+#include <include/non_copyable.h>
+#include <include/non_movable.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <latch>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+namespace
+{
+
+    using namespace bcpp::network;
+    using namespace bcpp::network::benchmark;
+
+
+    //=========================================================================
+    struct run_configuration
+    {
+        std::size_t                 threads_;           // threads opening and closing sockets
+        std::size_t                 serviceThreads_;    // threads servicing sockets (polling is always one thread)
+        std::chrono::nanoseconds    duration_;
+        std::size_t                 greetingSize_;      // bytes sent by the server upon accept (tcp only)
+        std::size_t                 sendQueueSize_;     // send queue capacity (packets) of every socket
+    };
+
+
+    //=========================================================================
+    // a virtual network interface with one dedicated polling thread and
+    // 'serviceThreads_' threads servicing its sockets
+    struct churn_environment : bcpp::non_movable, bcpp::non_copyable
+    {
+        churn_environment
+        (
+            run_configuration const & runConfiguration
+        ):
+            networkInterface_({.networkInterfaceConfiguration_ = {.ipAddress_ = local_host}})
+        {
+            threads_.emplace_back([this](std::stop_token const & stopToken){while (!stopToken.stop_requested()) networkInterface_.poll();});
+            for (auto i = 0u; i < std::max(runConfiguration.serviceThreads_, std::size_t{1}); ++i)
+                threads_.emplace_back([this](std::stop_token const & stopToken){while (!stopToken.stop_requested()) networkInterface_.service_sockets();});
+        }
+
+        virtual_network_interface       networkInterface_;
+        std::vector<std::jthread>       threads_;
+    };
+
+
+    //=========================================================================
+    // the per thread results of a churn run
+    struct churn_statistics
+    {
+        latency_recorder    openLatency_;       // time spent creating (and, for tcp, connecting) the socket
+        latency_recorder    connectLatency_;    // open through the receipt of the server's greeting
+        latency_recorder    closeLatency_;      // time spent in the socket's destructor
+        std::uint64_t       cycles_{0};
+        std::uint64_t       failures_{0};
+    };
+
+
+    //=========================================================================
+    inline bool wait_until
+    (
+        auto condition,
+        std::chrono::nanoseconds timeout
+    )
+    {
+        for (auto deadline = std::chrono::steady_clock::now() + timeout; !condition(); std::this_thread::yield())
+            if (std::chrono::steady_clock::now() >= deadline)
+                return false;
+        return true;
+    }
+
+
+    //=========================================================================
+    // run 'cycle' on each of 'threads_' threads until the duration has elapsed
+    // and report the combined results.  'cycle' returns false on failure.
+    void run_threads
+    (
+        benchmark_result & result,
+        run_configuration const & runConfiguration,
+        auto cycle
+    )
+    {
+        using namespace std::chrono;
+        auto allocatorStatistics = socket_impl_allocator::get().get_statistics();
+        std::deque<churn_statistics> threadStatistics(runConfiguration.threads_);
+        std::latch startLatch(runConfiguration.threads_ + 1);
+        steady_clock::time_point deadline;
+        {
+            std::vector<std::jthread> threads;
+            for (auto i = 0u; i < runConfiguration.threads_; ++i)
+                threads.emplace_back([&, i]()
+                        {
+                            auto & statistics = threadStatistics[i];
+                            startLatch.arrive_and_wait();
+                            while (steady_clock::now() < deadline)
+                            {
+                                if (cycle(statistics))
+                                    ++statistics.cycles_;
+                                else
+                                    ++statistics.failures_;
+                            }
+                        });
+            deadline = steady_clock::now() + runConfiguration.duration_;
+            startLatch.arrive_and_wait();
+        }
+        auto elapsed = duration<double>(runConfiguration.duration_).count();
+
+        churn_statistics total;
+        for (auto const & statistics : threadStatistics)
+        {
+            total.openLatency_.merge(statistics.openLatency_);
+            total.connectLatency_.merge(statistics.connectLatency_);
+            total.closeLatency_.merge(statistics.closeLatency_);
+            total.cycles_ += statistics.cycles_;
+            total.failures_ += statistics.failures_;
+        }
+        result.add_metric("cycles", total.cycles_);
+        result.add_metric("cycles_per_second", total.cycles_ / elapsed);
+        result.add_metric("failures", total.failures_);
+        result.add_latency("open", total.openLatency_.summarize());
+        if (total.connectLatency_.size() > 0)
+            result.add_latency("connect", total.connectLatency_.summarize());
+        result.add_latency("close", total.closeLatency_.summarize());
+
+        auto endAllocatorStatistics = socket_impl_allocator::get().get_statistics();
+        auto allocations = (endAllocatorStatistics.allocations_ - allocatorStatistics.allocations_);
+        result.add_metric("impl_pool_hit_ratio", (allocations > 0) ? 
+                (static_cast<double>(endAllocatorStatistics.poolHits_ - allocatorStatistics.poolHits_) / allocations) : 0.0);
+    }
+
+
+    //=========================================================================
+    // the server side of the tcp churn.  each accepted connection is sent a 
+    // greeting and is destroyed (by the reaper thread) once the client has 
+    // closed the connection.
+    struct tcp_churn_server : bcpp::non_movable, bcpp::non_copyable
+    {
+        tcp_churn_server
+        (
+            virtual_network_interface & networkInterface,
+            std::size_t greetingSize,
+            std::size_t sendQueueSize
+        )
+        {
+            listenerSocket_ = networkInterface.create_tcp_socket({.portId_ = port_id_any, .backlog_ = 4096}, 
+                    {
+                        .acceptHandler_ = [&, greetingSize, sendQueueSize](auto, auto fileDescriptor)
+                        {
+                            auto tcpSocket = networkInterface.accept_tcp_socket(std::move(fileDescriptor), {.sendQueueSize_ = sendQueueSize}, 
+                                    {.closeHandler_ = [this](auto socketId){std::lock_guard lockGuard(mutex_); closed_.push_back(socketId.get());}});
+                            if (!tcpSocket.is_valid())
+                                return;
+                            ++accepted_;
+                            packet greeting(greetingSize);
+                            greeting.resize(greetingSize);
+                            std::memset(greeting.data(), 0, greetingSize);
+                            tcpSocket.send(std::move(greeting));
+                            std::lock_guard lockGuard(mutex_);
+                            connections_.emplace(tcpSocket.get_id().get(), std::move(tcpSocket));
+                        }
+                    });
+
+            reaperThread_ = std::jthread([this](std::stop_token const & stopToken)
+                    {
+                        while (!stopToken.stop_requested())
+                        {
+                            reap();
+                            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                        }
+                    });
+        }
+
+        ~tcp_churn_server()
+        {
+            reaperThread_.request_stop();
+            reaperThread_.join();
+            std::lock_guard lockGuard(mutex_);
+            connections_.clear();
+        }
+
+        void reap()
+        {
+            std::vector<tcp_socket> reaped; // destroyed outside of the lock
+            std::lock_guard lockGuard(mutex_);
+            // a connection can close before it is added to connections_ so only discard 
+            // the ids of connections which were found
+            std::erase_if(closed_, [&](auto socketId)
+                    {
+                        auto iter = connections_.find(socketId);
+                        if (iter == connections_.end())
+                            return false;
+                        reaped.push_back(std::move(iter->second));
+                        connections_.erase(iter);
+                        return true;
+                    });
+        }
+
+        tcp_listener_socket                                         listenerSocket_;
+        std::atomic<std::uint64_t>                                  accepted_{0};
+        std::mutex                                                  mutex_;
+        std::unordered_map<socket_id::value_type, tcp_socket>       connections_;
+        std::vector<socket_id::value_type>                          closed_;
+        std::jthread                                                reaperThread_;
+    };
+
+
+    //=========================================================================
+    // short lived tcp clients.  each cycle connects to a local listener, waits
+    // for the server's greeting and then closes the connection (the client 
+    // closes first as an http/1.0 style client would).
+    benchmark_result tcp_churn
+    (
+        run_configuration const & runConfiguration
+    )
+    {
+        using namespace std::chrono;
+
+        benchmark_result result{.name_ = "tcp_churn"};
+        churn_environment environment(runConfiguration);
+        auto & networkInterface = environment.networkInterface_;
+
+        tcp_churn_server server(networkInterface, runConfiguration.greetingSize_, runConfiguration.sendQueueSize_);
+        if (!server.listenerSocket_.is_valid())
+        {
+            result.error_ = "failed to create tcp listener socket";
+            return result;
+        }
+        auto serverSocketAddress = server.listenerSocket_.get_socket_address();
+        auto greetingSize = runConfiguration.greetingSize_;
+
+        run_threads(result, runConfiguration, [&](churn_statistics & statistics)
+                {
+                    std::atomic<std::size_t> received{0};
+                    auto start = steady_clock::now();
+                    auto tcpSocket = networkInterface.create_tcp_socket(serverSocketAddress, {.sendQueueSize_ = runConfiguration.sendQueueSize_}, 
+                            {.receiveHandler_ = [&](auto, auto message, auto){received += message.size();}});
+                    auto opened = steady_clock::now();
+                    auto success = ((tcpSocket.is_valid()) && (wait_until([&](){return (received >= greetingSize);}, 1s)));
+                    auto connected = steady_clock::now();
+                    tcpSocket = {};
+                    auto closed = steady_clock::now();
+                    if (!success)
+                        return false;
+                    statistics.openLatency_.record(opened - start);
+                    statistics.connectLatency_.record(connected - start);
+                    statistics.closeLatency_.record(closed - connected);
+                    return true;
+                });
+        result.add_metric("accepts_per_second", server.accepted_ / duration<double>(runConfiguration.duration_).count());
+        return result;
+    }
+
+
+    //=========================================================================
+    // create and destroy udp sockets as quickly as possible.  isolates the cost
+    // of the socket open and destroy paths (impl allocation, work contracts,
+    // poller registration, socket options) from any handshake.
+    benchmark_result udp_churn
+    (
+        run_configuration const & runConfiguration
+    )
+    {
+        using namespace std::chrono;
+
+        benchmark_result result{.name_ = "udp_churn"};
+        churn_environment environment(runConfiguration);
+        auto & networkInterface = environment.networkInterface_;
+
+        run_threads(result, runConfiguration, [&](churn_statistics & statistics)
+                {
+                    auto start = steady_clock::now();
+                    auto udpSocket = networkInterface.create_udp_socket({.sendQueueSize_ = runConfiguration.sendQueueSize_}, {});
+                    auto opened = steady_clock::now();
+                    auto success = udpSocket.is_valid();
+                    udpSocket = {};
+                    auto closed = steady_clock::now();
+                    if (!success)
+                        return false;
+                    statistics.openLatency_.record(opened - start);
+                    statistics.closeLatency_.record(closed - opened);
+                    return true;
+                });
+        return result;
+    }
+
+
+    //=========================================================================
+    void print_usage
+    (
+    )
+    {
+        std::cout << "usage: churn_benchmark [options]\n"
+                "  --benchmarks=<list>      any of tcp_churn,udp_churn (default all)\n"
+                "  --threads=<list>         threads opening and closing sockets (default 1,4)\n"
+                "  --service-threads=<n>    threads servicing sockets (default 1)\n"
+                "  --duration-ms=<n>        duration of each run (default 1000).  note that the client side\n"
+                "                           of each tcp connection remains in TIME_WAIT which limits the\n"
+                "                           number of connections per run to the ephemeral port range\n"
+                "  --greeting-size=<n>      bytes sent by the server upon accept (default 64)\n"
+                "  --send-queue-size=<n>    send queue capacity of each socket in packets (default 16).  the\n"
+                "                           send queue is allocated (and zeroed) as each socket is created\n"
+                "  --format=<format>        text, json or csv (default text)\n"
+                "  --output=<path>          write the report to a file rather than stdout\n";
+    }
+
+} // namespace
+
+
+//=============================================================================
+int main
+(
+    int argc,
+    char ** argv
+)
+{
+    command_line commandLine(argc, argv);
+    if (commandLine.has("help"))
+    {
+        print_usage();
+        return 0;
+    }
+
+    auto outputFormat = parse_output_format(commandLine.get("format", "text"));
+    if (outputFormat == output_format::undefined)
+    {
+        std::cerr << "unknown output format\n";
+        print_usage();
+        return -1;
+    }
+
+    std::vector<benchmark_result> results;
+    for (auto const & benchmarkName : commandLine.get_list("benchmarks", "tcp_churn,udp_churn"))
+    {
+        auto benchmark = (benchmarkName == "tcp_churn") ? tcp_churn : (benchmarkName == "udp_churn") ? udp_churn : nullptr;
+        if (benchmark == nullptr)
+        {
+            std::cerr << "unknown benchmark: " << benchmarkName << "\n";
+            print_usage();
+            return -1;
+        }
+        for (auto threads : commandLine.get_integer_list("threads", "1,4"))
+        {
+            run_configuration runConfiguration
+            {
+                .threads_ = std::max(threads, std::uint64_t{1}),
+                .serviceThreads_ = std::max(commandLine.get_integer("service-threads", 1), std::uint64_t{1}),
+                .duration_ = std::chrono::milliseconds(commandLine.get_integer("duration-ms", 1000)),
+                .greetingSize_ = std::max(commandLine.get_integer("greeting-size", 64), std::uint64_t{1}),
+                .sendQueueSize_ = std::max(commandLine.get_integer("send-queue-size", 16), std::uint64_t{1})
+            };
+            std::cerr << "running " << benchmarkName << " threads = " << runConfiguration.threads_ << "\n";
+            auto result = benchmark(runConfiguration);
+            result.add_parameter("threads", runConfiguration.threads_);
+            result.add_parameter("service_threads", runConfiguration.serviceThreads_);
+            result.add_parameter("duration_ms", commandLine.get_integer("duration-ms", 1000));
+            result.add_parameter("send_queue_size", runConfiguration.sendQueueSize_);
+            results.push_back(std::move(result));
+        }
+    }
+
+    if (commandLine.has("output"))
+    {
+        std::ofstream stream(commandLine.get("output", {}));
+        if (!stream)
+        {
+            std::cerr << "failed to open " << commandLine.get("output", {}) << "\n";
+            return -1;
+        }
+        write_report(stream, results, outputFormat);
+    }
+    else
+    {
+        write_report(std::cout, results, outputFormat);
+    }
+    for (auto const & result : results)
+        if (!result.error_.empty())
+            return -1;
+    return 0;
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "./latency_recorder.h"
+
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace bcpp::network::benchmark
+{
+
+    enum class output_format : std::uint32_t
+    {
+        undefined   = 0,
+        text        = 1,
+        json        = 2,
+        csv         = 3
+    };
+
+
+    //=========================================================================
+    // the outcome of one benchmark run.  parameters describe the run (message
+    // size, thread count etc) and metrics are the measured values.  both are
+    // kept in insertion order so that output is stable from run to run.
+    struct benchmark_result
+    {
+        void add_parameter
+        (
+            std::string name,
+            auto const & value
+        )
+        {
+            if constexpr (std::is_convertible_v<decltype(value), std::string>)
+                parameters_.emplace_back(std::move(name), value);
+            else
+                parameters_.emplace_back(std::move(name), std::to_string(value));
+        }
+
+        void add_metric
+        (
+            std::string name,
+            double value
+        )
+        {
+            metrics_.emplace_back(std::move(name), value);
+        }
+
+        void add_latency
+        (
+            std::string const & prefix,
+            latency_summary const & latencySummary
+        )
+        {
+            add_metric(prefix + "_samples", latencySummary.count_);
+            add_metric(prefix + "_min_ns", latencySummary.min_);
+            add_metric(prefix + "_mean_ns", latencySummary.mean_);
+            add_metric(prefix + "_p50_ns", latencySummary.p50_);
+            add_metric(prefix + "_p90_ns", latencySummary.p90_);
+            add_metric(prefix + "_p99_ns", latencySummary.p99_);
+            add_metric(prefix + "_p999_ns", latencySummary.p999_);
+            add_metric(prefix + "_max_ns", latencySummary.max_);
+        }
+
+        std::string                                         name_;
+        std::vector<std::pair<std::string, std::string>>    parameters_;
+        std::vector<std::pair<std::string, double>>         metrics_;
+        std::string                                         error_;     // non empty if the run could not be completed
+    };
+
+
+    output_format parse_output_format
+    (
+        std::string_view
+    );
+
+    void write_report
+    (
+        std::ostream &,
+        std::vector<benchmark_result> const &,
+        output_format
+    );
+
+} // namespace bcpp::network::benchmark
+
+
+//=============================================================================
+inline auto bcpp::network::benchmark::parse_output_format
+(
+    std::string_view value
+) -> output_format
+{
+    if (value == "text")
+        return output_format::text;
+    if (value == "json")
+        return output_format::json;
+    if (value == "csv")
+        return output_format::csv;
+    return output_format::undefined;
+}
+
+
+//=============================================================================
+inline void bcpp::network::benchmark::write_report
+(
+    // json is a single document with one object per run.  csv is in 'long'
+    // form (one row per metric) so that the columns are the same regardless of
+    // which benchmarks were run.
+    std::ostream & stream,
+    std::vector<benchmark_result> const & results,
+    output_format outputFormat
+)
+{
+    auto quoted = [](std::string_view value)
+            {
+                std::string s("\"");
+                for (auto c : value)
+                {
+                    if ((c == '"') || (c == '\\'))
+                        s += '\\';
+                    s += c;
+                }
+                return s + '"';
+            };
+
+    stream << std::fixed << std::setprecision(2);
+    switch (outputFormat)
+    {
+        case output_format::json:
+        {
+            stream << "{\n  \"benchmarks\": [";
+            for (auto i = 0u; i < results.size(); ++i)
+            {
+                auto const & result = results[i];
+                stream << ((i == 0) ? "\n" : ",\n") << "    {\n      \"name\": " << quoted(result.name_) << ",\n      \"parameters\": {";
+                for (auto j = 0u; j < result.parameters_.size(); ++j)
+                    stream << ((j == 0) ? "" : ", ") << quoted(result.parameters_[j].first) << ": " << quoted(result.parameters_[j].second);
+                stream << "},\n      \"metrics\": {";
+                for (auto j = 0u; j < result.metrics_.size(); ++j)
+                    stream << ((j == 0) ? "" : ", ") << quoted(result.metrics_[j].first) << ": " << result.metrics_[j].second;
+                stream << "}";
+                if (!result.error_.empty())
+                    stream << ",\n      \"error\": " << quoted(result.error_);
+                stream << "\n    }";
+            }
+            stream << "\n  ]\n}\n";
+            break;
+        }
+        case output_format::csv:
+        {
+            stream << "benchmark,parameters,metric,value\n";
+            for (auto const & result : results)
+            {
+                std::string parameters;
+                for (auto const & [name, value] : result.parameters_)
+                    parameters += ((parameters.empty()) ? "" : ";") + name + "=" + value;
+                if (!result.error_.empty())
+                    stream << result.name_ << "," << quoted(parameters) << ",error," << quoted(result.error_) << "\n";
+                for (auto const & [name, value] : result.metrics_)
+                    stream << result.name_ << "," << quoted(parameters) << "," << name << "," << value << "\n";
+            }
+            break;
+        }
+        default:
+        {
+            for (auto const & result : results)
+            {
+                stream << result.name_;
+                for (auto const & [name, value] : result.parameters_)
+                    stream << " " << name << "=" << value;
+                stream << "\n";
+                if (!result.error_.empty())
+                    stream << "    error: " << result.error_ << "\n";
+                for (auto const & [name, value] : result.metrics_)
+                    stream << "    " << std::left << std::setw(36) << name << " " << std::right << value << "\n";
+            }
+            break;
+        }
+    }
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <vector>
+
+
+namespace bcpp::network::benchmark
+{
+
+    //=========================================================================
+    // minimal parser for arguments of the form --name=value (or --name which
+    // is equivalent to --name=true).  lists are comma separated.
+    class command_line
+    {
+    public:
+
+        command_line
+        (
+            int,
+            char **
+        );
+
+        bool has
+        (
+            std::string const &
+        ) const;
+
+        std::string get
+        (
+            std::string const &,
+            std::string const &
+        ) const;
+
+        std::uint64_t get_integer
+        (
+            std::string const &,
+            std::uint64_t
+        ) const;
+
+        std::vector<std::string> get_list
+        (
+            std::string const &,
+            std::string const &
+        ) const;
+
+        std::vector<std::uint64_t> get_integer_list
+        (
+            std::string const &,
+            std::string const &
+        ) const;
+
+    private:
+
+        std::map<std::string, std::string>  arguments_;
+
+    }; // class command_line
+
+} // namespace bcpp::network::benchmark
+
+
+//=============================================================================
+inline bcpp::network::benchmark::command_line::command_line
+(
+    int argc,
+    char ** argv
+)
+{
+    for (auto i = 1; i < argc; ++i)
+    {
+        std::string_view argument(argv[i]);
+        if (!argument.starts_with("--"))
+            continue;
+        argument.remove_prefix(2);
+        if (auto separator = argument.find('='); separator != std::string_view::npos)
+            arguments_[std::string(argument.substr(0, separator))] = argument.substr(separator + 1);
+        else
+            arguments_[std::string(argument)] = "true";
+    }
+}
+
+
+//=============================================================================
+inline bool bcpp::network::benchmark::command_line::has
+(
+    std::string const & name
+) const
+{
+    return arguments_.contains(name);
+}
+
+
+//=============================================================================
+inline std::string bcpp::network::benchmark::command_line::get
+(
+    std::string const & name,
+    std::string const & defaultValue
+) const
+{
+    if (auto iter = arguments_.find(name); iter != arguments_.end())
+        return iter->second;
+    return defaultValue;
+}
+
+
+//=============================================================================
+inline std::uint64_t bcpp::network::benchmark::command_line::get_integer
+(
+    std::string const & name,
+    std::uint64_t defaultValue
+) const
+{
+    return has(name) ? std::stoull(get(name, {})) : defaultValue;
+}
+
+
+//=============================================================================
+inline std::vector<std::string> bcpp::network::benchmark::command_line::get_list
+(
+    std::string const & name,
+    std::string const & defaultValue
+) const
+{
+    std::vector<std::string> list;
+    std::string_view value;
+    auto s = get(name, defaultValue);
+    for (value = s; !value.empty(); )
+    {
+        auto separator = value.find(',');
+        if (auto item = value.substr(0, separator); !item.empty())
+            list.emplace_back(item);
+        value = (separator == std::string_view::npos) ? std::string_view{} : value.substr(separator + 1);
+    }
+    return list;
+}
+
+
+//=============================================================================
+inline std::vector<std::uint64_t> bcpp::network::benchmark::command_line::get_integer_list
+(
+    std::string const & name,
+    std::string const & defaultValue
+) const
+{
+    std::vector<std::uint64_t> list;
+    for (auto const & item : get_list(name, defaultValue))
+        list.push_back(std::stoull(item));
+    return list;
+}
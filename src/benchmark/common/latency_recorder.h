@@ -0,0 +1,95 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+
+namespace bcpp::network::benchmark
+{
+
+    //=========================================================================
+    // summary of a set of latency samples (all values in nanoseconds)
+    struct latency_summary
+    {
+        std::size_t     count_{0};
+        std::uint64_t   min_{0};
+        std::uint64_t   mean_{0};
+        std::uint64_t   p50_{0};
+        std::uint64_t   p90_{0};
+        std::uint64_t   p99_{0};
+        std::uint64_t   p999_{0};
+        std::uint64_t   max_{0};
+    };
+
+
+    //=========================================================================
+    // collects raw latency samples.  samples are stored (rather than binned) so
+    // that percentiles are exact.  not thread safe.  use one recorder per flow
+    // and merge them once the run is complete.
+    class latency_recorder
+    {
+    public:
+
+        static auto constexpr default_capacity = (1 << 20);
+
+        latency_recorder
+        (
+            std::size_t capacity = default_capacity
+        )
+        {
+            samples_.reserve(capacity);
+        }
+
+        void record
+        (
+            std::chrono::nanoseconds latency
+        )
+        {
+            samples_.push_back(static_cast<std::uint64_t>(latency.count()));
+        }
+
+        void merge
+        (
+            latency_recorder const & other
+        )
+        {
+            samples_.insert(samples_.end(), other.samples_.begin(), other.samples_.end());
+        }
+
+        std::size_t size() const{return samples_.size();}
+
+        latency_summary summarize();
+
+    private:
+
+        std::vector<std::uint64_t>  samples_;
+
+    }; // class latency_recorder
+
+} // namespace bcpp::network::benchmark
+
+
+//=============================================================================
+inline auto bcpp::network::benchmark::latency_recorder::summarize
+(
+) -> latency_summary
+{
+    if (samples_.empty())
+        return {};
+    std::sort(samples_.begin(), samples_.end());
+    auto percentile = [&](double p){return samples_[std::min(samples_.size() - 1, static_cast<std::size_t>(p * samples_.size()))];};
+    return {
+            .count_ = samples_.size(),
+            .min_ = samples_.front(),
+            .mean_ = std::accumulate(samples_.begin(), samples_.end(), std::uint64_t{0}) / samples_.size(),
+            .p50_ = percentile(0.50),
+            .p90_ = percentile(0.90),
+            .p99_ = percentile(0.99),
+            .p999_ = percentile(0.999),
+            .max_ = samples_.back()
+        };
+}
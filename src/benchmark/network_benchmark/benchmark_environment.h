@@ -0,0 +1,135 @@
+#pragma once
+
+#include "../common/benchmark_report.h"
+#include "../common/latency_recorder.h"
+
+#include <library/network.h>
+
+#include <include/non_movable.h>
+#include <include/non_copyable.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <string>
+#include <vector>
+
+
+namespace bcpp::network::benchmark
+{
+
+    //=========================================================================
+    // the parameters of a single benchmark run
+    struct run_configuration
+    {
+        network_interface_configuration     networkInterfaceConfiguration_;
+        std::size_t                         messageSize_;
+        std::size_t                         threads_;       // worker threads (and concurrent flows)
+        std::chrono::nanoseconds            duration_;
+        std::size_t                         multicastRate_; // packets per second (multicast only)
+    };
+
+
+    //=========================================================================
+    // a virtual network interface with one dedicated polling thread and
+    // 'threads_' threads servicing its sockets.  the threads are stopped
+    // before the interface is destroyed.
+    struct benchmark_environment : non_movable, non_copyable
+    {
+        benchmark_environment
+        (
+            run_configuration const & runConfiguration
+        ):
+            networkInterface_({.networkInterfaceConfiguration_ = runConfiguration.networkInterfaceConfiguration_})
+        {
+            threads_.emplace_back([this](std::stop_token const & stopToken){while (!stopToken.stop_requested()) networkInterface_.poll();});
+            for (auto i = 0u; i < std::max(runConfiguration.threads_, std::size_t{1}); ++i)
+                threads_.emplace_back([this](std::stop_token const & stopToken){while (!stopToken.stop_requested()) networkInterface_.service_sockets();});
+        }
+
+        virtual_network_interface       networkInterface_;
+        std::vector<std::jthread>       threads_;
+    };
+
+
+    //=========================================================================
+    // the state of one ping pong flow.  the receive handler of the flow's client
+    // socket is the only writer of the recorder (work contracts never execute
+    // the same socket concurrently).
+    struct ping_pong_flow
+    {
+        latency_recorder                                    latencyRecorder_;
+        std::chrono::steady_clock::time_point               sendTime_;
+        std::size_t                                         pending_{0};    // bytes of the current reply received (stream only)
+        std::atomic<std::uint64_t>                          roundTrips_{0};
+        std::atomic<bool>                                   inFlight_{false};
+    };
+
+
+    //=========================================================================
+    inline packet create_message
+    (
+        std::size_t size
+    )
+    {
+        packet message(size);
+        message.resize(size);
+        std::memset(message.data(), 0, size);
+        return message;
+    }
+
+
+    //=========================================================================
+    inline void write_time_stamp
+    (
+        packet & message
+    )
+    {
+        auto timeStamp = std::chrono::steady_clock::now().time_since_epoch().count();
+        std::memcpy(message.data(), &timeStamp, sizeof(timeStamp));
+    }
+
+
+    //=========================================================================
+    inline std::chrono::nanoseconds read_time_stamp
+    (
+        // returns the time elapsed since the time stamp was written
+        packet const & message
+    )
+    {
+        std::chrono::steady_clock::rep timeStamp;
+        std::memcpy(&timeStamp, message.data(), sizeof(timeStamp));
+        return (std::chrono::steady_clock::now().time_since_epoch() - std::chrono::steady_clock::duration(timeStamp));
+    }
+
+
+    //=========================================================================
+    inline bool wait_until
+    (
+        auto condition,
+        std::chrono::nanoseconds timeout
+    )
+    {
+        for (auto deadline = std::chrono::steady_clock::now() + timeout; !condition(); std::this_thread::yield())
+            if (std::chrono::steady_clock::now() >= deadline)
+                return false;
+        return true;
+    }
+
+
+    //=========================================================================
+    inline void add_common_parameters
+    (
+        benchmark_result & result,
+        run_configuration const & runConfiguration
+    )
+    {
+        result.add_parameter("message_size", runConfiguration.messageSize_);
+        result.add_parameter("threads", runConfiguration.threads_);
+        result.add_parameter("duration_ms", std::chrono::duration_cast<std::chrono::milliseconds>(runConfiguration.duration_).count());
+        result.add_parameter("interface", std::string(runConfiguration.networkInterfaceConfiguration_.name_.get()));
+    }
+
+} // namespace bcpp::network::benchmark
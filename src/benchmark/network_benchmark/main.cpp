@@ -0,0 +1,122 @@
+#include "./udp_benchmark.h"
+#include "./tcp_benchmark.h"
+#include "./multicast_benchmark.h"
+#include "../common/command_line.h"
+
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+
+
+namespace
+{
+
+    //=========================================================================
+    void print_usage
+    (
+    )
+    {
+        std::cout << "usage: network_benchmark [options]\n"
+                "  --benchmarks=<list>      udp_ping_pong,tcp_ping_pong,tcp_stream,udp_pps,multicast (default all)\n"
+                "  --message-sizes=<list>   message sizes in bytes (default 64,1024)\n"
+                "  --threads=<list>         worker threads and concurrent flows (default 1)\n"
+                "  --duration-ms=<n>        duration of each run (default 2000)\n"
+                "  --multicast-rate=<n>     multicast packets per second (default 100000)\n"
+                "  --interface=<name>       network interface (default lo)\n"
+                "  --format=<format>        text, json or csv (default text)\n"
+                "  --output=<path>          write the report to a file rather than stdout\n";
+    }
+
+} // namespace
+
+
+//=============================================================================
+int main
+(
+    int argc,
+    char ** argv
+)
+{
+    using namespace bcpp::network::benchmark;
+    using run_function = std::function<benchmark_result(run_configuration const &)>;
+    static std::map<std::string, run_function> const benchmarks
+    {
+        {"udp_ping_pong", udp_ping_pong},
+        {"tcp_ping_pong", tcp_ping_pong},
+        {"tcp_stream", tcp_stream},
+        {"udp_pps", udp_packets_per_second},
+        {"multicast", multicast}
+    };
+    static auto constexpr default_benchmarks = "udp_ping_pong,tcp_ping_pong,tcp_stream,udp_pps,multicast";
+
+    command_line commandLine(argc, argv);
+    if (commandLine.has("help"))
+    {
+        print_usage();
+        return 0;
+    }
+
+    auto outputFormat = parse_output_format(commandLine.get("format", "text"));
+    if (outputFormat == output_format::undefined)
+    {
+        std::cerr << "unknown output format\n";
+        print_usage();
+        return -1;
+    }
+
+    auto networkInterfaceConfiguration = bcpp::network::get_network_interface_configuration(commandLine.get("interface", "lo"));
+    if (!networkInterfaceConfiguration.ipAddress_.is_valid())
+    {
+        std::cerr << "network interface " << commandLine.get("interface", "lo") << " not found\n";
+        return -1;
+    }
+
+    std::vector<benchmark_result> results;
+    for (auto const & name : commandLine.get_list("benchmarks", default_benchmarks))
+    {
+        auto iter = benchmarks.find(name);
+        if (iter == benchmarks.end())
+        {
+            std::cerr << "unknown benchmark: " << name << "\n";
+            print_usage();
+            return -1;
+        }
+        for (auto messageSize : commandLine.get_integer_list("message-sizes", "64,1024"))
+        {
+            for (auto threads : commandLine.get_integer_list("threads", "1"))
+            {
+                run_configuration runConfiguration
+                {
+                    .networkInterfaceConfiguration_ = networkInterfaceConfiguration,
+                    .messageSize_ = std::max(messageSize, std::uint64_t{sizeof(std::uint64_t)}), // room for a time stamp
+                    .threads_ = std::max(threads, std::uint64_t{1}),
+                    .duration_ = std::chrono::milliseconds(commandLine.get_integer("duration-ms", 2000)),
+                    .multicastRate_ = commandLine.get_integer("multicast-rate", 100'000)
+                };
+                std::cerr << "running " << name << " message_size = " << runConfiguration.messageSize_ << 
+                        " threads = " << runConfiguration.threads_ << "\n";
+                results.push_back(iter->second(runConfiguration));
+            }
+        }
+    }
+
+    if (commandLine.has("output"))
+    {
+        std::ofstream stream(commandLine.get("output", {}));
+        if (!stream)
+        {
+            std::cerr << "failed to open " << commandLine.get("output", {}) << "\n";
+            return -1;
+        }
+        write_report(stream, results, outputFormat);
+    }
+    else
+    {
+        write_report(std::cout, results, outputFormat);
+    }
+    for (auto const & result : results)
+        if (!result.error_.empty())
+            return -1;
+    return 0;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "./benchmark_environment.h"
+
+#include <deque>
+#include <thread>
+
+
+namespace bcpp::network::benchmark
+{
+
+    //=========================================================================
+    // one sender publishing to a multicast group at a fixed rate with 'threads_'
+    // receivers joined to the group on the same interface (multicast loop).
+    // measures the one way latency from send to receive handler per receiver.
+    // the interface must support multicast (on linux: ip link set lo multicast on).
+    inline benchmark_result multicast
+    (
+        run_configuration const & runConfiguration
+    )
+    {
+        using namespace std::chrono;
+        static socket_address const multicast_channel = "239.255.0.1:31000";
+
+        benchmark_result result{.name_ = "multicast"};
+        add_common_parameters(result, runConfiguration);
+        result.add_parameter("rate", runConfiguration.multicastRate_);
+
+        benchmark_environment environment(runConfiguration);
+        auto & networkInterface = environment.networkInterface_;
+        auto numReceivers = std::max(runConfiguration.threads_, std::size_t{1});
+        std::atomic<bool> stop{false};
+
+        struct receiver
+        {
+            udp_socket                  socket_;
+            latency_recorder            latencyRecorder_;
+            std::atomic<std::uint64_t>  received_{0};
+        };
+        std::deque<receiver> receivers(numReceivers);
+        for (auto & r : receivers)
+        {
+            r.socket_ = networkInterface.multicast_join(multicast_channel, {.reusePort_ = true}, 
+                    {
+                        .receiveHandler_ = [&](auto, auto message, auto)
+                        {
+                            if (!stop)
+                                r.latencyRecorder_.record(read_time_stamp(message));
+                            ++r.received_;
+                        }
+                    });
+            if (!r.socket_.is_valid())
+            {
+                result.error_ = "failed to join multicast group";
+                return result;
+            }
+        }
+
+        auto sender = networkInterface.create_udp_socket({.multicastLoop_ = true}, {});
+        if ((!sender.is_valid()) || (sender.connect_to(multicast_channel) != connect_result::success))
+        {
+            result.error_ = "failed to create multicast sender";
+            return result;
+        }
+
+        // pace the sends
+        std::uint64_t sent = 0;
+        auto interval = nanoseconds(1s) / std::max(runConfiguration.multicastRate_, std::size_t{1});
+        auto start = steady_clock::now();
+        for (auto next = start; next - start < runConfiguration.duration_; next += interval)
+        {
+            while (steady_clock::now() < next)
+                ;
+            auto message = create_message(runConfiguration.messageSize_);
+            write_time_stamp(message);
+            sent += sender.send(std::move(message));
+        }
+        auto elapsed = duration_cast<duration<double>>(steady_clock::now() - start).count();
+        std::this_thread::sleep_for(100ms);
+        stop = true;
+
+        latency_recorder latencyRecorder;
+        std::uint64_t received = 0;
+        for (auto & r : receivers)
+        {
+            received += r.received_;
+            latencyRecorder.merge(r.latencyRecorder_);
+        }
+        result.add_metric("sent", sent);
+        result.add_metric("received", received);
+        result.add_metric("sent_per_second", sent / elapsed);
+        result.add_metric("loss_ratio", (sent > 0) ? (1.0 - (static_cast<double>(received) / (sent * numReceivers))) : 0.0);
+        result.add_latency("one_way", latencyRecorder.summarize());
+        return result;
+    }
+
+} // namespace bcpp::network::benchmark
@@ -0,0 +1,218 @@
+#pragma once
+
+#include "./benchmark_environment.h"
+
+#include <deque>
+#include <mutex>
+#include <thread>
+
+
+namespace bcpp::network::benchmark
+{
+
+    //=========================================================================
+    // a listening socket which accepts 'numConnections' connections.  each
+    // accepted connection is handed the receive handler produced by
+    // 'create_receive_handler(index)'.
+    struct tcp_server
+    {
+        tcp_server
+        (
+            virtual_network_interface & networkInterface,
+            std::size_t numConnections,
+            auto create_receive_handler
+        ):
+            connections_(numConnections)
+        {
+            listenerSocket_ = networkInterface.create_tcp_socket({.portId_ = port_id_any}, 
+                    {
+                        .acceptHandler_ = [&, create_receive_handler](auto, auto fileDescriptor)
+                        {
+                            if (auto index = accepted_.load(); index < connections_.size())
+                            {
+                                connections_[index] = networkInterface.accept_tcp_socket(std::move(fileDescriptor), {}, 
+                                        {.receiveHandler_ = create_receive_handler(index)});
+                                ++accepted_;
+                            }
+                        }
+                    });
+        }
+
+        bool wait_for_connections() const
+        {
+            return wait_until([this](){return (accepted_ == connections_.size());}, std::chrono::seconds(5));
+        }
+
+        tcp_listener_socket             listenerSocket_;
+        std::deque<tcp_socket>          connections_;
+        std::atomic<std::size_t>        accepted_{0};
+    };
+
+
+    //=========================================================================
+    // round trip time over tcp connections.  each flow keeps exactly one message
+    // in flight.  the server echoes bytes as they arrive and the client considers
+    // the round trip complete once the entire message has been returned.
+    inline benchmark_result tcp_ping_pong
+    (
+        run_configuration const & runConfiguration
+    )
+    {
+        using namespace std::chrono;
+
+        benchmark_result result{.name_ = "tcp_ping_pong"};
+        add_common_parameters(result, runConfiguration);
+
+        benchmark_environment environment(runConfiguration);
+        auto & networkInterface = environment.networkInterface_;
+        auto numFlows = std::max(runConfiguration.threads_, std::size_t{1});
+        auto messageSize = runConfiguration.messageSize_;
+        std::atomic<bool> stop{false};
+
+        tcp_server server(networkInterface, numFlows, [&](auto index)
+                {
+                    return [&, index](auto, auto message, auto){server.connections_[index].send(std::move(message));};
+                });
+        if (!server.listenerSocket_.is_valid())
+        {
+            result.error_ = "failed to create tcp listener socket";
+            return result;
+        }
+
+        std::deque<ping_pong_flow> flows(numFlows);
+        std::deque<tcp_socket> clientSockets(numFlows);
+        for (auto i = 0u; i < numFlows; ++i)
+        {
+            auto & flow = flows[i];
+            auto & clientSocket = clientSockets[i];
+            clientSocket = networkInterface.create_tcp_socket(server.listenerSocket_.get_socket_address(), {}, 
+                    {
+                        .receiveHandler_ = [&](auto, auto message, auto)
+                        {
+                            if ((flow.pending_ += message.size()) < messageSize)
+                                return; // partial reply
+                            flow.pending_ -= messageSize;
+                            flow.latencyRecorder_.record(steady_clock::now() - flow.sendTime_);
+                            ++flow.roundTrips_;
+                            if (stop)
+                            {
+                                flow.inFlight_ = false;
+                                return;
+                            }
+                            flow.sendTime_ = steady_clock::now();
+                            clientSocket.send(create_message(messageSize));
+                        }
+                    });
+            if (!clientSocket.is_valid())
+            {
+                result.error_ = "failed to connect tcp socket";
+                return result;
+            }
+        }
+        if (!server.wait_for_connections())
+        {
+            result.error_ = "failed to accept tcp connections";
+            return result;
+        }
+
+        auto start = steady_clock::now();
+        for (auto i = 0u; i < numFlows; ++i)
+        {
+            flows[i].inFlight_ = true;
+            flows[i].sendTime_ = steady_clock::now();
+            clientSockets[i].send(create_message(messageSize));
+        }
+        std::this_thread::sleep_for(runConfiguration.duration_);
+        stop = true;
+        auto elapsed = duration_cast<duration<double>>(steady_clock::now() - start).count();
+        wait_until([&](){for (auto const & flow : flows) if (flow.inFlight_) return false; return true;}, 1s);
+
+        latency_recorder latencyRecorder;
+        std::uint64_t roundTrips = 0;
+        for (auto & flow : flows)
+        {
+            latencyRecorder.merge(flow.latencyRecorder_);
+            roundTrips += flow.roundTrips_;
+        }
+        result.add_metric("round_trips", roundTrips);
+        result.add_metric("round_trips_per_second", roundTrips / elapsed);
+        result.add_latency("rtt", latencyRecorder.summarize());
+        return result;
+    }
+
+
+    //=========================================================================
+    // one way tcp throughput.  each flow has a dedicated sending thread which
+    // writes messages as fast as the send queue allows.
+    inline benchmark_result tcp_stream
+    (
+        run_configuration const & runConfiguration
+    )
+    {
+        using namespace std::chrono;
+
+        benchmark_result result{.name_ = "tcp_stream"};
+        add_common_parameters(result, runConfiguration);
+
+        benchmark_environment environment(runConfiguration);
+        auto & networkInterface = environment.networkInterface_;
+        auto numFlows = std::max(runConfiguration.threads_, std::size_t{1});
+        std::atomic<std::uint64_t> sentBytes{0};
+        std::atomic<std::uint64_t> receivedBytes{0};
+
+        tcp_server server(networkInterface, numFlows, [&](auto)
+                {
+                    return [&](auto, auto message, auto){receivedBytes += message.size();};
+                });
+        if (!server.listenerSocket_.is_valid())
+        {
+            result.error_ = "failed to create tcp listener socket";
+            return result;
+        }
+
+        std::deque<tcp_socket> clientSockets(numFlows);
+        for (auto & clientSocket : clientSockets)
+        {
+            clientSocket = networkInterface.create_tcp_socket(server.listenerSocket_.get_socket_address(), {}, {});
+            if (!clientSocket.is_valid())
+            {
+                result.error_ = "failed to connect tcp socket";
+                return result;
+            }
+        }
+        if (!server.wait_for_connections())
+        {
+            result.error_ = "failed to accept tcp connections";
+            return result;
+        }
+
+        auto start = steady_clock::now();
+        {
+            std::vector<std::jthread> senders;
+            for (auto i = 0u; i < numFlows; ++i)
+                senders.emplace_back([&, i](std::stop_token const & stopToken)
+                        {
+                            std::uint64_t bytes = 0;
+                            while (!stopToken.stop_requested())
+                            {
+                                if (clientSockets[i].send(create_message(runConfiguration.messageSize_)))
+                                    bytes += runConfiguration.messageSize_;
+                                else
+                                    std::this_thread::yield(); // send queue is full
+                            }
+                            sentBytes += bytes;
+                        });
+            std::this_thread::sleep_for(runConfiguration.duration_);
+        }
+        // measure up until the receiver has everything that was sent
+        wait_until([&](){return (receivedBytes >= sentBytes);}, 5s);
+        auto elapsed = duration_cast<duration<double>>(steady_clock::now() - start).count();
+
+        result.add_metric("sent_bytes", sentBytes);
+        result.add_metric("received_bytes", receivedBytes);
+        result.add_metric("messages_per_second", (receivedBytes / static_cast<double>(runConfiguration.messageSize_)) / elapsed);
+        result.add_metric("throughput_mbps", (receivedBytes * 8.0) / elapsed / 1e6);
+        return result;
+    }
+
+} // namespace bcpp::network::benchmark
@@ -0,0 +1,177 @@
+#pragma once
+
+#include "./benchmark_environment.h"
+
+#include <deque>
+#include <thread>
+
+
+namespace bcpp::network::benchmark
+{
+
+    //=========================================================================
+    // round trip time between pairs of udp sockets.  each flow keeps exactly one
+    // message in flight.  the echo side returns the received packet as is.
+    // a message lost for longer than 'loss_timeout' is replaced (and counted).
+    inline benchmark_result udp_ping_pong
+    (
+        run_configuration const & runConfiguration
+    )
+    {
+        using namespace std::chrono;
+        static auto constexpr loss_timeout = 100ms;
+
+        benchmark_result result{.name_ = "udp_ping_pong"};
+        add_common_parameters(result, runConfiguration);
+
+        benchmark_environment environment(runConfiguration);
+        auto & networkInterface = environment.networkInterface_;
+        auto numFlows = std::max(runConfiguration.threads_, std::size_t{1});
+        std::atomic<bool> stop{false};
+        std::atomic<std::uint64_t> lost{0};
+
+        std::deque<ping_pong_flow> flows(numFlows);
+        std::deque<udp_socket> echoSockets(numFlows);
+        std::deque<udp_socket> clientSockets(numFlows);
+        for (auto i = 0u; i < numFlows; ++i)
+        {
+            auto & echoSocket = echoSockets[i];
+            echoSocket = networkInterface.create_udp_socket({}, 
+                    {.receiveHandler_ = [&echoSocket](auto, auto message, auto source){echoSocket.send_to(source, std::move(message));}});
+            auto & flow = flows[i];
+            auto & clientSocket = clientSockets[i];
+            clientSocket = networkInterface.create_udp_socket({.sendQueueProducerMode_ = producer_mode::multi_producer}, 
+                    {
+                        .receiveHandler_ = [&](auto, auto message, auto)
+                        {
+                            flow.latencyRecorder_.record(read_time_stamp(message));
+                            ++flow.roundTrips_;
+                            if (stop)
+                            {
+                                flow.inFlight_ = false;
+                                return;
+                            }
+                            write_time_stamp(message);
+                            clientSocket.send(std::move(message));
+                        }
+                    });
+            if ((!echoSocket.is_valid()) || (!clientSocket.is_valid()))
+            {
+                result.error_ = "failed to create udp sockets";
+                return result;
+            }
+            clientSocket.connect_to(echoSocket.get_socket_address());
+        }
+
+        auto start = steady_clock::now();
+        for (auto i = 0u; i < numFlows; ++i)
+        {
+            auto message = create_message(runConfiguration.messageSize_);
+            write_time_stamp(message);
+            flows[i].inFlight_ = true;
+            clientSockets[i].send(std::move(message));
+        }
+
+        // watch for lost messages until the run is complete
+        std::vector<std::uint64_t> previousRoundTrips(numFlows, 0);
+        while (steady_clock::now() - start < runConfiguration.duration_)
+        {
+            std::this_thread::sleep_for(loss_timeout);
+            for (auto i = 0u; i < numFlows; ++i)
+            {
+                if (auto roundTrips = flows[i].roundTrips_.load(); roundTrips == std::exchange(previousRoundTrips[i], roundTrips))
+                {
+                    ++lost;
+                    auto message = create_message(runConfiguration.messageSize_);
+                    write_time_stamp(message);
+                    clientSockets[i].send(std::move(message));
+                }
+            }
+        }
+        stop = true;
+        auto elapsed = duration_cast<duration<double>>(steady_clock::now() - start).count();
+        wait_until([&](){for (auto const & flow : flows) if (flow.inFlight_) return false; return true;}, loss_timeout);
+
+        latency_recorder latencyRecorder;
+        std::uint64_t roundTrips = 0;
+        for (auto & flow : flows)
+        {
+            latencyRecorder.merge(flow.latencyRecorder_);
+            roundTrips += flow.roundTrips_;
+        }
+        result.add_metric("round_trips", roundTrips);
+        result.add_metric("round_trips_per_second", roundTrips / elapsed);
+        result.add_metric("lost", lost);
+        result.add_latency("rtt", latencyRecorder.summarize());
+        return result;
+    }
+
+
+    //=========================================================================
+    // udp packets per second.  each flow has a dedicated sending thread which
+    // sends as fast as the send queue allows to its own receiving socket.
+    inline benchmark_result udp_packets_per_second
+    (
+        run_configuration const & runConfiguration
+    )
+    {
+        using namespace std::chrono;
+        static auto constexpr socket_buffer_size = (8 << 20);
+
+        benchmark_result result{.name_ = "udp_pps"};
+        add_common_parameters(result, runConfiguration);
+
+        benchmark_environment environment(runConfiguration);
+        auto & networkInterface = environment.networkInterface_;
+        auto numFlows = std::max(runConfiguration.threads_, std::size_t{1});
+        std::atomic<std::uint64_t> sent{0};
+        std::atomic<std::uint64_t> received{0};
+        std::atomic<std::uint64_t> receivedBytes{0};
+
+        std::deque<udp_socket> receiveSockets(numFlows);
+        std::deque<udp_socket> sendSockets(numFlows);
+        for (auto i = 0u; i < numFlows; ++i)
+        {
+            receiveSockets[i] = networkInterface.create_udp_socket({.socketReceiveBufferSize_ = socket_buffer_size}, 
+                    {.receiveHandler_ = [&](auto, auto message, auto){++received; receivedBytes += message.size();}});
+            sendSockets[i] = networkInterface.create_udp_socket({.socketSendBufferSize_ = socket_buffer_size}, {});
+            if ((!receiveSockets[i].is_valid()) || (!sendSockets[i].is_valid()))
+            {
+                result.error_ = "failed to create udp sockets";
+                return result;
+            }
+            sendSockets[i].connect_to(receiveSockets[i].get_socket_address());
+        }
+
+        auto start = steady_clock::now();
+        {
+            std::vector<std::jthread> senders;
+            for (auto i = 0u; i < numFlows; ++i)
+                senders.emplace_back([&, i](std::stop_token const & stopToken)
+                        {
+                            std::uint64_t count = 0;
+                            while (!stopToken.stop_requested())
+                            {
+                                if (sendSockets[i].send(create_message(runConfiguration.messageSize_)))
+                                    ++count;
+                                else
+                                    std::this_thread::yield(); // send queue is full
+                            }
+                            sent += count;
+                        });
+            std::this_thread::sleep_for(runConfiguration.duration_);
+        }
+        auto elapsed = duration_cast<duration<double>>(steady_clock::now() - start).count();
+        // allow anything still in flight to arrive
+        wait_until([&, previous = std::uint64_t{0}]() mutable {std::this_thread::sleep_for(10ms); return (std::exchange(previous, received.load()) == received);}, 1s);
+
+        result.add_metric("sent", sent);
+        result.add_metric("received", received);
+        result.add_metric("sent_per_second", sent / elapsed);
+        result.add_metric("received_per_second", received / elapsed);
+        result.add_metric("received_mbps", (receivedBytes * 8.0) / elapsed / 1e6);
+        result.add_metric("loss_ratio", (sent > 0) ? (1.0 - (static_cast<double>(received) / sent)) : 0.0);
+        return result;
+    }
+
+} // namespace bcpp::network::benchmark
@@ -0,0 +1,366 @@
+#include "../common/benchmark_report.h"
+#include "../common/command_line.h"
+#include "../common/latency_recorder.h"
+
+#include <library/network.h>
+
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+
+    using namespace bcpp::network;
+    using namespace bcpp::network::benchmark;
+
+    #if defined(USE_KQUEUE)
+        static auto constexpr poller_backend = "kqueue";
+    #else
+        static auto constexpr poller_backend = "epoll";
+    #endif
+
+
+    //=========================================================================
+    struct run_configuration
+    {
+        std::size_t                 sockets_;
+        double                      activeFraction_;
+        std::size_t                 rate_;          // messages per second across all active sockets
+        std::size_t                 threads_;       // threads servicing sockets (polling is always one thread)
+        std::chrono::nanoseconds    duration_;
+        bool                        instrumentDispatch_;    // also report the library's own dispatch latency
+    };
+
+
+    //=========================================================================
+    // cpu time consumed by the calling thread
+    std::chrono::nanoseconds get_thread_cpu_time
+    (
+    )
+    {
+        ::timespec timeSpec;
+        ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &timeSpec);
+        return std::chrono::seconds(timeSpec.tv_sec) + std::chrono::nanoseconds(timeSpec.tv_nsec);
+    }
+
+
+    //=========================================================================
+    // raise the open file limit as far as permitted.  returns the limit.
+    std::size_t raise_file_descriptor_limit
+    (
+    )
+    {
+        ::rlimit limit;
+        if (::getrlimit(RLIMIT_NOFILE, &limit) != 0)
+            return 0;
+        limit.rlim_cur = limit.rlim_max;
+        ::setrlimit(RLIMIT_NOFILE, &limit);
+        ::getrlimit(RLIMIT_NOFILE, &limit);
+        return limit.rlim_cur;
+    }
+
+
+    //=========================================================================
+    // the polling thread's tallies for one phase of the run
+    struct poll_statistics
+    {
+        std::uint64_t               polls_{0};
+        std::chrono::nanoseconds    cpuTime_{0};
+        std::chrono::nanoseconds    elapsed_{0};
+    };
+
+
+    //=========================================================================
+    // poll for 'duration' on the calling thread
+    poll_statistics poll_for
+    (
+        virtual_network_interface & networkInterface,
+        std::chrono::nanoseconds duration
+    )
+    {
+        using namespace std::chrono;
+        poll_statistics pollStatistics;
+        auto cpuTime = get_thread_cpu_time();
+        auto start = steady_clock::now();
+        auto deadline = start + duration;
+        while (steady_clock::now() < deadline)
+        {
+            networkInterface.poll();
+            ++pollStatistics.polls_;
+        }
+        pollStatistics.elapsed_ = (steady_clock::now() - start);
+        pollStatistics.cpuTime_ = (get_thread_cpu_time() - cpuTime);
+        return pollStatistics;
+    }
+
+
+    //=========================================================================
+    void add_poll_statistics
+    (
+        benchmark_result & result,
+        std::string const & prefix,
+        poll_statistics const & pollStatistics
+    )
+    {
+        auto elapsed = std::chrono::duration<double>(pollStatistics.elapsed_).count();
+        result.add_metric(prefix + "_polls_per_second", pollStatistics.polls_ / elapsed);
+        result.add_metric(prefix + "_cpu_ns_per_poll", (pollStatistics.polls_ > 0) ? 
+                (static_cast<double>(pollStatistics.cpuTime_.count()) / pollStatistics.polls_) : 0.0);
+        result.add_metric(prefix + "_poll_thread_cpu_utilization", std::chrono::duration<double>(pollStatistics.cpuTime_).count() / elapsed);
+    }
+
+
+    //=========================================================================
+    // register 'sockets_' unix domain socket pairs with one poller.  the poller
+    // side of each pair is a library socket and the other side is written to
+    // directly (no library involvement) by a driver thread.  only the first
+    // 'activeFraction_' of the pairs receive traffic.  reports the idle cost of
+    // polling, the cost of polling under load, delivered events per second and
+    // the latency from write to receive handler (dispatch latency).
+    benchmark_result run
+    (
+        run_configuration const & runConfiguration
+    )
+    {
+        using namespace std::chrono;
+        static auto constexpr idle_duration = 500ms;
+
+        benchmark_result result{.name_ = "poller"};
+        result.add_parameter("backend", std::string(poller_backend));
+        result.add_parameter("sockets", runConfiguration.sockets_);
+        result.add_parameter("active_fraction", std::to_string(runConfiguration.activeFraction_));
+        result.add_parameter("rate", runConfiguration.rate_);
+        result.add_parameter("threads", runConfiguration.threads_);
+        result.add_parameter("instrument_dispatch", runConfiguration.instrumentDispatch_ ? "true" : "false");
+
+        if (auto required = (runConfiguration.sockets_ * 2) + 256; raise_file_descriptor_limit() < required)
+        {
+            result.error_ = "file descriptor limit is less than " + std::to_string(required);
+            return result;
+        }
+
+        // each socket holds a receive contract and a send contract (in separate groups)
+        virtual_network_interface networkInterface({
+                .networkInterfaceConfiguration_ = {.ipAddress_ = local_host},
+                .poller_ = {.dispatchLatencyInstrumentation_ = runConfiguration.instrumentDispatch_},
+                .capacity_ = static_cast<std::int64_t>(std::bit_ceil(runConfiguration.sockets_ + 1024))});
+
+        std::atomic<bool> stop{false};
+        std::atomic<std::uint64_t> events{0};
+        std::deque<latency_recorder> latencyRecorders(runConfiguration.threads_);
+        static thread_local latency_recorder * threadLatencyRecorder = nullptr;
+
+        // create the socket pairs
+        std::vector<int> driverFileDescriptors;
+        std::vector<unix_seqpacket_socket> sockets;
+        driverFileDescriptors.reserve(runConfiguration.sockets_);
+        sockets.reserve(runConfiguration.sockets_);
+        auto setupStart = steady_clock::now();
+        for (auto i = 0u; i < runConfiguration.sockets_; ++i)
+        {
+            int fileDescriptors[2];
+            if (::socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK, 0, fileDescriptors) != 0)
+            {
+                result.error_ = "socketpair failed: " + std::string(std::strerror(errno));
+                break;
+            }
+            driverFileDescriptors.push_back(fileDescriptors[1]);
+            sockets.push_back(networkInterface.accept_unix_socket<network_transport_protocol::unix_seqpacket>(
+                    bcpp::system::file_descriptor(fileDescriptors[0]), 
+                    {.readBufferSize_ = 64, .sendQueueSize_ = 16},
+                    {
+                        .receiveHandler_ = [&](auto, auto message, auto)
+                        {
+                            steady_clock::rep timeStamp;
+                            std::memcpy(&timeStamp, message.data(), sizeof(timeStamp));
+                            threadLatencyRecorder->record(steady_clock::now().time_since_epoch() - steady_clock::duration(timeStamp));
+                            ++events;
+                        }
+                    }));
+            if (!sockets.back().is_valid())
+            {
+                result.error_ = "failed to create socket " + std::to_string(i);
+                break;
+            }
+        }
+        auto setupElapsed = (steady_clock::now() - setupStart);
+
+        if (result.error_.empty())
+        {
+            result.add_metric("register_ns_per_socket", static_cast<double>(duration_cast<nanoseconds>(setupElapsed).count()) / runConfiguration.sockets_);
+
+            std::vector<std::jthread> serviceThreads;
+            for (auto i = 0u; i < runConfiguration.threads_; ++i)
+                serviceThreads.emplace_back([&, i](std::stop_token const & stopToken)
+                        {
+                            threadLatencyRecorder = &latencyRecorders[i];
+                            while (!stopToken.stop_requested()) 
+                                networkInterface.service_sockets();
+                        });
+
+            // phase one: every socket is idle
+            add_poll_statistics(result, "idle", poll_for(networkInterface, idle_duration));
+
+            // phase two: drive the active sockets at the configured rate
+            networkInterface.reset_dispatch_latency_statistics();
+            auto numActive = std::max(static_cast<std::size_t>(runConfiguration.sockets_ * runConfiguration.activeFraction_), std::size_t{1});
+            std::uint64_t sent = 0;
+            std::uint64_t dropped = 0;
+            std::jthread driverThread([&](std::stop_token const & stopToken)
+                    {
+                        auto interval = nanoseconds(1s) / std::max(runConfiguration.rate_, std::size_t{1});
+                        std::size_t next = 0;
+                        for (auto nextSend = steady_clock::now(); !stopToken.stop_requested(); nextSend += interval)
+                        {
+                            while (steady_clock::now() < nextSend)
+                                ;
+                            auto timeStamp = steady_clock::now().time_since_epoch().count();
+                            if (::send(driverFileDescriptors[next], &timeStamp, sizeof(timeStamp), MSG_DONTWAIT | MSG_NOSIGNAL) == sizeof(timeStamp))
+                                ++sent;
+                            else
+                                ++dropped;
+                            if (++next == numActive)
+                                next = 0;
+                        }
+                    });
+            auto activePollStatistics = poll_for(networkInterface, runConfiguration.duration_);
+            driverThread.request_stop();
+            driverThread.join();
+
+            // drain anything still in flight
+            auto drainDeadline = steady_clock::now() + 1s;
+            while ((events < sent) && (steady_clock::now() < drainDeadline))
+                networkInterface.poll();
+            serviceThreads.clear();
+
+            auto elapsed = duration<double>(activePollStatistics.elapsed_).count();
+            result.add_metric("active_sockets", numActive);
+            result.add_metric("sent", sent);
+            result.add_metric("dropped", dropped);
+            result.add_metric("events", events.load());
+            result.add_metric("events_per_second", events.load() / elapsed);
+            result.add_metric("events_per_poll", (activePollStatistics.polls_ > 0) ? (static_cast<double>(events) / activePollStatistics.polls_) : 0.0);
+            add_poll_statistics(result, "active", activePollStatistics);
+            latency_recorder latencyRecorder;
+            for (auto const & r : latencyRecorders)
+                latencyRecorder.merge(r);
+            result.add_latency("dispatch", latencyRecorder.summarize());
+            if (runConfiguration.instrumentDispatch_)
+            {
+                // the portion of the dispatch latency spent between poll and the receive work executing
+                auto latencyStatistics = networkInterface.get_dispatch_latency_statistics();
+                result.add_latency("scheduled_to_receive", 
+                        {
+                            .count_ = latencyStatistics.count_,
+                            .min_ = static_cast<std::uint64_t>(latencyStatistics.min_.count()),
+                            .mean_ = static_cast<std::uint64_t>(latencyStatistics.mean_.count()),
+                            .p50_ = static_cast<std::uint64_t>(latencyStatistics.p50_.count()),
+                            .p90_ = static_cast<std::uint64_t>(latencyStatistics.p90_.count()),
+                            .p99_ = static_cast<std::uint64_t>(latencyStatistics.p99_.count()),
+                            .p999_ = static_cast<std::uint64_t>(latencyStatistics.p999_.count()),
+                            .max_ = static_cast<std::uint64_t>(latencyStatistics.max_.count())
+                        });
+            }
+        }
+
+        sockets.clear();
+        for (auto fileDescriptor : driverFileDescriptors)
+            ::close(fileDescriptor);
+        return result;
+    }
+
+
+    //=========================================================================
+    void print_usage
+    (
+    )
+    {
+        std::cout << "usage: poller_benchmark [options]\n"
+                "  --sockets=<list>         registered socket pairs (default 1000,10000,100000)\n"
+                "  --active-fractions=<list> fraction of sockets receiving traffic (default 0.001,0.01,0.1)\n"
+                "  --rate=<n>               messages per second across all active sockets (default 100000)\n"
+                "  --threads=<n>            threads servicing sockets (default 1)\n"
+                "  --duration-ms=<n>        duration of the active phase of each run (default 2000)\n"
+                "  --instrument-dispatch    enable the poller's dispatch latency instrumentation and report it\n"
+                "  --format=<format>        text, json or csv (default text)\n"
+                "  --output=<path>          write the report to a file rather than stdout\n";
+    }
+
+} // namespace
+
+
+//=============================================================================
+int main
+(
+    int argc,
+    char ** argv
+)
+{
+    command_line commandLine(argc, argv);
+    if (commandLine.has("help"))
+    {
+        print_usage();
+        return 0;
+    }
+
+    auto outputFormat = parse_output_format(commandLine.get("format", "text"));
+    if (outputFormat == output_format::undefined)
+    {
+        std::cerr << "unknown output format\n";
+        print_usage();
+        return -1;
+    }
+
+    std::vector<benchmark_result> results;
+    for (auto sockets : commandLine.get_integer_list("sockets", "1000,10000,100000"))
+    {
+        for (auto const & activeFraction : commandLine.get_list("active-fractions", "0.001,0.01,0.1"))
+        {
+            run_configuration runConfiguration
+            {
+                .sockets_ = std::max(sockets, std::uint64_t{1}),
+                .activeFraction_ = std::clamp(std::stod(activeFraction), 0.0, 1.0),
+                .rate_ = commandLine.get_integer("rate", 100'000),
+                .threads_ = std::max(commandLine.get_integer("threads", 1), std::uint64_t{1}),
+                .duration_ = std::chrono::milliseconds(commandLine.get_integer("duration-ms", 2000)),
+                .instrumentDispatch_ = commandLine.has("instrument-dispatch")
+            };
+            std::cerr << "running poller sockets = " << runConfiguration.sockets_ << " active_fraction = " << activeFraction << "\n";
+            results.push_back(run(runConfiguration));
+        }
+    }
+
+    if (commandLine.has("output"))
+    {
+        std::ofstream stream(commandLine.get("output", {}));
+        if (!stream)
+        {
+            std::cerr << "failed to open " << commandLine.get("output", {}) << "\n";
+            return -1;
+        }
+        write_report(stream, results, outputFormat);
+    }
+    else
+    {
+        write_report(std::cout, results, outputFormat);
+    }
+    for (auto const & result : results)
+        if (!result.error_.empty())
+            return -1;
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include "./feed_arbitrator.h"
+
+
+//=============================================================================
+bcpp::network::feed_arbitrator::feed_arbitrator
+(
+    virtual_network_interface & virtualNetworkInterface,
+    configuration const & config,
+    event_handlers const & eventHandlers
+):
+    sequenceWindow_(config.windowSize_),
+    sequenceExtractor_(eventHandlers.sequenceExtractor_),
+    receiveHandler_(eventHandlers.receiveHandler_),
+    gapHandler_(eventHandlers.gapHandler_),
+    recoveryHandler_(eventHandlers.recoveryHandler_)
+{
+    if ((!sequenceExtractor_) || (!receiveHandler_))
+        return;
+
+    // both feeds deliver directly into the arbitration
+    udp_socket::event_handlers feedEventHandlers
+    {
+        .receiveHandler_ = [this](auto socketId, auto packet, auto socketAddress)
+                {
+                    this->on_receive(socketId, std::move(packet), socketAddress);
+                }
+    };
+    feedA_ = virtualNetworkInterface.multicast_join(config.feedA_, config.socketConfiguration_, feedEventHandlers);
+    feedB_ = virtualNetworkInterface.multicast_join(config.feedB_, config.socketConfiguration_, feedEventHandlers);
+}
+
+
+//=============================================================================
+void bcpp::network::feed_arbitrator::on_receive
+(
+    // invoked concurrently from the receive contracts of both feeds
+    socket_id socketId,
+    packet data,
+    socket_address socketAddress
+)
+{
+    auto sequence = sequenceExtractor_(data);
+    auto [type, gapBegin, gapEnd] = sequenceWindow_.claim(sequence);
+    switch (type)
+    {
+        case sequence_window::claim_type::duplicate:
+        {
+            duplicateCount_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        case sequence_window::claim_type::gap:
+        {
+            if (gapHandler_)
+                gapHandler_(gapBegin, gapEnd - gapBegin);
+            break;
+        }
+        case sequence_window::claim_type::recovered:
+        {
+            if (recoveryHandler_)
+                recoveryHandler_(sequence);
+            break;
+        }
+        default:
+        {
+            break;
+        }
+    }
+    receiveHandler_(socketId, std::move(data), socketAddress, sequence);
+}
+
+
+//=============================================================================
+bool bcpp::network::feed_arbitrator::is_valid
+(
+) const
+{
+    return (feedA_.is_valid() && feedB_.is_valid());
+}
+
+
+//=============================================================================
+std::uint64_t bcpp::network::feed_arbitrator::get_duplicate_count
+(
+) const
+{
+    return duplicateCount_.load(std::memory_order_relaxed);
+}
+
+
+//=============================================================================
+std::uint64_t bcpp::network::feed_arbitrator::get_highest_sequence
+(
+) const
+{
+    return sequenceWindow_.get_highest_sequence();
+}
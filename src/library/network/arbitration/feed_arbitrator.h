@@ -0,0 +1,93 @@
+#pragma once
+
+#include "./sequence_window.h"
+
+#include <library/network/network_interface/virtual_network_interface.h>
+
+#include <include/non_copyable.h>
+#include <include/non_movable.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    // arbitrates between two redundant (A/B) multicast feeds which carry the
+    // same sequenced messages.  the first copy of each message to arrive on
+    // either feed is forwarded (moved, not copied) to the receive handler from
+    // within the receiving socket's work contract.  subsequent copies are dropped.
+    // a gap is reported when a message is forwarded while earlier sequences 
+    // have not yet arrived on either feed and a recovery is reported if one of
+    // those skipped sequences later arrives.
+    class feed_arbitrator :
+        non_copyable,
+        non_movable
+    {
+    public:
+
+        struct event_handlers
+        {
+            using sequence_extractor = std::function<std::uint64_t(packet const &)>;
+            using receive_handler = std::function<void(socket_id, packet, socket_address, std::uint64_t)>;
+            using gap_handler = std::function<void(std::uint64_t, std::uint64_t)>;
+            using recovery_handler = std::function<void(std::uint64_t)>;
+
+            sequence_extractor  sequenceExtractor_;     // required
+            receive_handler     receiveHandler_;        // required
+            gap_handler         gapHandler_;            // first skipped sequence, number of skipped sequences
+            recovery_handler    recoveryHandler_;
+        };
+
+        struct configuration
+        {
+            socket_address              feedA_;
+            socket_address              feedB_;
+            std::size_t                 windowSize_{sequence_window::default_capacity};
+            udp_socket::configuration   socketConfiguration_;
+        };
+
+        feed_arbitrator
+        (
+            virtual_network_interface &,
+            configuration const &,
+            event_handlers const &
+        );
+
+        bool is_valid() const;
+
+        std::uint64_t get_duplicate_count() const;
+
+        std::uint64_t get_highest_sequence() const;
+
+    private:
+
+        void on_receive
+        (
+            socket_id,
+            packet,
+            socket_address
+        );
+
+        sequence_window                             sequenceWindow_;
+
+        event_handlers::sequence_extractor          sequenceExtractor_;
+
+        event_handlers::receive_handler             receiveHandler_;
+
+        event_handlers::gap_handler                 gapHandler_;
+
+        event_handlers::recovery_handler            recoveryHandler_;
+
+        std::atomic<std::uint64_t>                  duplicateCount_{0};
+
+        udp_socket                                  feedA_;
+
+        udp_socket                                  feedB_;
+
+    }; // class feed_arbitrator
+
+} // namespace bcpp::network
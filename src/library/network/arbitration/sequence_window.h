@@ -0,0 +1,195 @@
+#pragma once
+
+#include <include/bit.h>
+#include <include/non_copyable.h>
+#include <include/non_movable.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    // lock free de-duplication window for sequenced messages which arrive via
+    // more than one feed.  any number of threads may claim sequence numbers
+    // concurrently.  exactly one claim of any given sequence number succeeds
+    // (the first copy to arrive).  each slot holds the state of the most recent
+    // sequence in that slot (see get_slot_value) so a sequence older than the 
+    // window is indistinguishable from a duplicate and is rejected as one.
+    // claiming a slot and advancing the highest sequence are separate steps so
+    // a sequence can be claimed after a later sequence has already advanced the
+    // highest sequence past it.  only sequences which are still unclaimed when
+    // the highest sequence advances past them are reported as a gap (and are 
+    // marked as skipped in their slot).  so feeds which interleave without 
+    // losing messages report no gaps and only skipped sequences are 'recovered'.
+    // sequences must be less than 2^62.
+    class sequence_window :
+        non_copyable,
+        non_movable
+    {
+    public:
+
+        static auto constexpr default_capacity = (1 << 16);
+
+        enum class claim_type : std::uint32_t
+        {
+            undefined   = 0,
+            duplicate   = 1,    // already claimed (or older than the window)
+            next        = 2,    // first copy of a sequence which was not reported as skipped
+            gap         = 3,    // first copy but one or more earlier sequences were skipped
+            recovered   = 4     // first copy of a sequence which was previously skipped
+        };
+
+        struct claim_result
+        {
+            claim_type      type_{claim_type::undefined};
+            std::uint64_t   gapBegin_{0}; // first skipped sequence (claim_type::gap only)
+            std::uint64_t   gapEnd_{0};   // one past the last skipped sequence (claim_type::gap only)
+        };
+
+        sequence_window
+        (
+            std::size_t = default_capacity
+        );
+
+        claim_result claim
+        (
+            std::uint64_t
+        );
+
+        std::uint64_t get_highest_sequence() const;
+
+    private:
+
+        static auto constexpr no_sequence = ~std::uint64_t(0);
+
+        enum class slot_state : std::uint64_t
+        {
+            skipped = 0,
+            claimed = 1
+        };
+
+        static std::uint64_t get_slot_value
+        (
+            std::uint64_t,
+            slot_state
+        ) noexcept;
+
+        claim_result claim_highest
+        (
+            std::uint64_t
+        );
+
+        std::unique_ptr<std::atomic<std::uint64_t> []>  slots_;
+
+        std::uint64_t                                   capacityMask_;
+
+        alignas(64) std::atomic<std::uint64_t>          highestSequence_{no_sequence};
+
+    }; // class sequence_window
+
+} // namespace bcpp::network
+
+
+//=============================================================================
+inline bcpp::network::sequence_window::sequence_window
+(
+    std::size_t capacity
+)
+{
+    capacity = minimum_power_of_two(std::max(capacity, std::size_t(2)));
+    capacityMask_ = (capacity - 1);
+    slots_ = std::make_unique<std::atomic<std::uint64_t> []>(capacity);
+}
+
+
+//=============================================================================
+inline std::uint64_t bcpp::network::sequence_window::get_slot_value
+(
+    // slot values increase with the sequence and, for any one sequence, from
+    // skipped to claimed.  zero (the initial value) precedes every sequence.
+    std::uint64_t sequence,
+    slot_state slotState
+) noexcept
+{
+    return (((sequence + 1) << 1) | static_cast<std::uint64_t>(slotState));
+}
+
+
+//=============================================================================
+inline auto bcpp::network::sequence_window::claim
+(
+    std::uint64_t sequence
+) -> claim_result
+{
+    // claim the slot.  the first copy to advance the slot to this sequence wins.
+    auto & slot = slots_[sequence & capacityMask_];
+    auto claimed = get_slot_value(sequence, slot_state::claimed);
+    auto value = slot.load(std::memory_order_acquire);
+    do
+    {
+        if (value >= claimed)
+            return {.type_ = claim_type::duplicate};
+    } while (!slot.compare_exchange_weak(value, claimed, std::memory_order_acq_rel, std::memory_order_acquire));
+
+    if (value == get_slot_value(sequence, slot_state::skipped))
+        return {.type_ = claim_type::recovered};
+    return claim_highest(sequence);
+}
+
+
+//=============================================================================
+inline auto bcpp::network::sequence_window::claim_highest
+(
+    // advance the highest sequence seen so far and classify the claim.  the 
+    // claim which advances the highest sequence marks each sequence which it
+    // skipped over and which is still unclaimed as skipped.  sequences which
+    // are older than the window can not be marked and are reported as skipped.
+    std::uint64_t sequence
+) -> claim_result
+{
+    auto highestSequence = highestSequence_.load(std::memory_order_acquire);
+    while ((highestSequence == no_sequence) || (sequence > highestSequence))
+    {
+        if (highestSequence_.compare_exchange_weak(highestSequence, sequence, std::memory_order_acq_rel, std::memory_order_acquire))
+        {
+            if ((highestSequence == no_sequence) || (sequence == (highestSequence + 1)))
+                return {.type_ = claim_type::next};
+            auto windowBegin = ((sequence - highestSequence) > capacityMask_) ? (sequence - capacityMask_) : (highestSequence + 1);
+            claim_result claimResult{.type_ = claim_type::next};
+            if (windowBegin > (highestSequence + 1))
+                claimResult = {.type_ = claim_type::gap, .gapBegin_ = highestSequence + 1, .gapEnd_ = windowBegin};
+            for (auto skippedSequence = windowBegin; skippedSequence < sequence; ++skippedSequence)
+            {
+                auto & slot = slots_[skippedSequence & capacityMask_];
+                auto skipped = get_slot_value(skippedSequence, slot_state::skipped);
+                auto value = slot.load(std::memory_order_acquire);
+                while ((value < skipped) && (!slot.compare_exchange_weak(value, skipped, std::memory_order_acq_rel, std::memory_order_acquire)))
+                    ;
+                if (value >= skipped)
+                    continue; // claimed (by the other feed) before it could be marked as skipped
+                if (claimResult.type_ != claim_type::gap)
+                    claimResult = {.type_ = claim_type::gap, .gapBegin_ = skippedSequence};
+                claimResult.gapEnd_ = (skippedSequence + 1);
+            }
+            return claimResult;
+        }
+    }
+    // claimed after a later sequence had advanced the highest sequence but
+    // before that claim could mark this sequence as skipped.  not a gap.
+    return {.type_ = claim_type::next};
+}
+
+
+//=============================================================================
+inline std::uint64_t bcpp::network::sequence_window::get_highest_sequence
+(
+) const
+{
+    return highestSequence_.load(std::memory_order_acquire);
+}
@@ -0,0 +1,334 @@
+#include "./packet_capture.h"
+
+#include <netinet/in.h>
+
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cstring>
+#include <utility>
+
+
+namespace
+{
+    static auto constexpr ipv4_header_size = 20;
+    static auto constexpr udp_header_size = 8;
+    static auto constexpr tcp_header_size = 20;
+    static auto constexpr max_header_size = (ipv4_header_size + tcp_header_size);
+    static auto constexpr write_buffer_size = (1 << 20);
+    static auto constexpr idle_sleep_duration = std::chrono::microseconds(100);
+
+
+    //=========================================================================
+    void put_uint16
+    (
+        std::uint8_t * destination,
+        std::uint32_t value
+    )
+    {
+        destination[0] = static_cast<std::uint8_t>(value >> 8);
+        destination[1] = static_cast<std::uint8_t>(value);
+    }
+
+
+    //=========================================================================
+    void put_uint32
+    (
+        std::uint8_t * destination,
+        std::uint32_t value
+    )
+    {
+        put_uint16(destination, value >> 16);
+        put_uint16(destination + 2, value);
+    }
+
+
+    //=========================================================================
+    std::uint16_t ipv4_header_checksum
+    (
+        std::uint8_t const * header
+    )
+    {
+        std::uint32_t sum = 0;
+        for (auto i = 0; i < ipv4_header_size; i += 2)
+            sum += ((header[i] << 8) | header[i + 1]);
+        while (sum >> 16)
+            sum = ((sum & 0xffff) + (sum >> 16));
+        return static_cast<std::uint16_t>(~sum);
+    }
+
+
+    //=========================================================================
+    std::size_t build_headers
+    (
+        // synthesize the ipv4 and transport headers of a packet.  the addresses
+        // are those of the socket and its peer rather than those on the wire
+        // (which are not visible to the socket if translated).  the transport
+        // checksums are left as zero.  returns the total header size.
+        std::uint8_t * headers,
+        bool isTcp,
+        ::sockaddr_in const & source,
+        ::sockaddr_in const & destination,
+        std::size_t payloadLength,
+        std::uint32_t sequence
+    )
+    {
+        auto transportHeaderSize = (isTcp ? tcp_header_size : udp_header_size);
+        auto headerSize = (ipv4_header_size + transportHeaderSize);
+        std::memset(headers, 0, headerSize);
+
+        headers[0] = 0x45;                                                  // version 4, 20 byte header
+        put_uint16(headers + 2, std::min<std::size_t>(headerSize + payloadLength, 0xffff));
+        put_uint16(headers + 6, 0x4000);                                    // don't fragment
+        headers[8] = 64;                                                    // ttl
+        headers[9] = (isTcp ? IPPROTO_TCP : IPPROTO_UDP);
+        std::memcpy(headers + 12, &source.sin_addr, 4);                     // network byte order already
+        std::memcpy(headers + 16, &destination.sin_addr, 4);
+        put_uint16(headers + 10, ipv4_header_checksum(headers));
+
+        auto transportHeader = headers + ipv4_header_size;
+        std::memcpy(transportHeader, &source.sin_port, 2);
+        std::memcpy(transportHeader + 2, &destination.sin_port, 2);
+        if (isTcp)
+        {
+            put_uint32(transportHeader + 4, sequence);
+            transportHeader[12] = 0x50;                                     // 20 byte header
+            transportHeader[13] = 0x18;                                     // PSH | ACK
+            put_uint16(transportHeader + 14, 0xffff);                       // window
+        }
+        else
+        {
+            put_uint16(transportHeader + 4, std::min<std::size_t>(udp_header_size + payloadLength, 0xffff));
+        }
+        return headerSize;
+    }
+}
+
+
+//=============================================================================
+auto bcpp::network::packet_capture::create
+(
+    // returns nullptr if the file can not be created
+    configuration const & config
+) -> std::shared_ptr<packet_capture>
+{
+    auto * file = std::fopen(config.path_.c_str(), "wb");
+    if (file == nullptr)
+        return nullptr;
+    std::setvbuf(file, nullptr, _IOFBF, write_buffer_size);
+    return std::shared_ptr<packet_capture>(new packet_capture(config, file));
+}
+
+
+//=============================================================================
+bcpp::network::packet_capture::packet_capture
+(
+    configuration const & config,
+    std::FILE * file
+):
+    file_(file),
+    format_((config.format_ == capture_format::pcapng) ? capture_format::pcapng : capture_format::pcap),
+    snapLength_(std::min<std::size_t>(config.snapLength_ ? config.snapLength_ : default_snap_length, max_snap_length)),
+    bufferSize_(std::bit_ceil(std::max<std::size_t>(config.bufferSize_, min_buffer_size))),
+    buffer_(std::make_unique<std::byte[]>(bufferSize_)) // zeroed
+{
+    write_file_header();
+    thread_ = std::jthread([this](std::stop_token stopToken){this->run(stopToken);});
+}
+
+
+//=============================================================================
+bcpp::network::packet_capture::~packet_capture
+(
+    // packets which were queued prior to destruction are written before the
+    // file is closed.  sockets hold a reference so this can only happen once
+    // no socket can capture.
+)
+{
+    thread_.request_stop();
+    thread_.join();
+    std::fclose(file_);
+}
+
+
+//=============================================================================
+bool bcpp::network::packet_capture::capture
+(
+    // invoked on the i/o path.  copies the packet into the ring and returns
+    // immediately.  returns false if the packet was dropped.  the time stamp
+    // is nanoseconds since the epoch (zero for 'now').  the sequence is the
+    // tcp sequence number of the first byte of the payload (ignored for udp).
+    capture_direction direction,
+    network_transport_protocol protocol,
+    socket_address source,
+    socket_address destination,
+    std::span<std::byte const> payload,
+    std::uint64_t timeStamp,
+    std::uint32_t sequence
+) noexcept
+{
+    auto capturedLength = std::min(payload.size(), snapLength_);
+    auto recordSize = ((sizeof(record_header) + capturedLength + alignof(record_header) - 1) & ~(alignof(record_header) - 1));
+
+    // reserve space for the record (and a filler if the record would wrap)
+    auto head = head_.load(std::memory_order_relaxed);
+    std::size_t fillerSize = 0;
+    do
+    {
+        auto remaining = (bufferSize_ - (head & (bufferSize_ - 1)));
+        fillerSize = (remaining < recordSize) ? remaining : 0;
+        if ((head + fillerSize + recordSize - tail_.load(std::memory_order_acquire)) > bufferSize_)
+        {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+    } while (!head_.compare_exchange_weak(head, head + fillerSize + recordSize, std::memory_order_relaxed, std::memory_order_relaxed));
+
+    if (fillerSize > 0)
+    {
+        auto * filler = reinterpret_cast<record_header *>(buffer_.get() + (head & (bufferSize_ - 1)));
+        filler->isFiller_ = 1;
+        std::atomic_ref(filler->size_).store(static_cast<std::uint32_t>(fillerSize), std::memory_order_release);
+        head += fillerSize;
+    }
+
+    // the size was zeroed by the writer and is stored last to publish the record
+    auto * address = (buffer_.get() + (head & (bufferSize_ - 1)));
+    auto * header = reinterpret_cast<record_header *>(address);
+    header->isFiller_ = 0;
+    header->timeStamp_ = (timeStamp == 0) ? get_time_stamp() : timeStamp;
+    header->source_ = source;
+    header->destination_ = destination;
+    header->protocol_ = protocol;
+    header->direction_ = direction;
+    header->sequence_ = sequence;
+    header->originalLength_ = static_cast<std::uint32_t>(payload.size());
+    header->capturedLength_ = static_cast<std::uint32_t>(capturedLength);
+    std::memcpy(address + sizeof(record_header), payload.data(), capturedLength);
+    std::atomic_ref(header->size_).store(static_cast<std::uint32_t>(recordSize), std::memory_order_release);
+
+    captured_.fetch_add(1, std::memory_order_relaxed);
+    if (capturedLength < payload.size())
+        truncated_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+
+//=============================================================================
+auto bcpp::network::packet_capture::get_statistics
+(
+) const noexcept -> statistics
+{
+    return {.captured_ = captured_.load(std::memory_order_relaxed), .dropped_ = dropped_.load(std::memory_order_relaxed),
+            .truncated_ = truncated_.load(std::memory_order_relaxed), .written_ = written_.load(std::memory_order_relaxed)};
+}
+
+
+//=============================================================================
+std::uint64_t bcpp::network::packet_capture::get_time_stamp
+(
+    // the clock of the kernel's receive time stamps (SO_TIMESTAMPNS)
+) noexcept
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+
+//=============================================================================
+void bcpp::network::packet_capture::write_file_header
+(
+)
+{
+    if (format_ == capture_format::pcapng)
+    {
+        pcapng::section_header_block sectionHeaderBlock;
+        pcapng::interface_description_block interfaceDescriptionBlock{.snapLength_ = static_cast<std::uint32_t>(snapLength_ + max_header_size)};
+        std::fwrite(&sectionHeaderBlock, sizeof(sectionHeaderBlock), 1, file_);
+        std::fwrite(&interfaceDescriptionBlock, sizeof(interfaceDescriptionBlock), 1, file_);
+    }
+    else
+    {
+        pcap::file_header fileHeader{.snapLength_ = static_cast<std::uint32_t>(snapLength_ + max_header_size)};
+        std::fwrite(&fileHeader, sizeof(fileHeader), 1, file_);
+    }
+}
+
+
+//=============================================================================
+void bcpp::network::packet_capture::write
+(
+    record_header const & packet,
+    std::byte const * payload
+)
+{
+    std::uint8_t headers[max_header_size];
+    auto headerSize = build_headers(headers, (packet.protocol_ == network_transport_protocol::tcp), packet.source_,
+            packet.destination_, packet.originalLength_, packet.sequence_);
+    auto capturedLength = static_cast<std::uint32_t>(headerSize + packet.capturedLength_);
+    auto originalLength = static_cast<std::uint32_t>(headerSize + packet.originalLength_);
+
+    if (format_ == capture_format::pcapng)
+    {
+        static std::uint8_t constexpr padding[4]{};
+        auto paddedLength = ((capturedLength + 3) & ~3u);
+        auto totalLength = static_cast<std::uint32_t>(sizeof(pcapng::enhanced_packet_block_header) + paddedLength +
+                sizeof(pcapng::enhanced_packet_block_trailer));
+        pcapng::enhanced_packet_block_header blockHeader{.totalLength_ = totalLength,
+                .timestampHigh_ = static_cast<std::uint32_t>(packet.timeStamp_ >> 32), .timestampLow_ = static_cast<std::uint32_t>(packet.timeStamp_),
+                .capturedLength_ = capturedLength, .originalLength_ = originalLength};
+        pcapng::enhanced_packet_block_trailer blockTrailer{.flags_ = (packet.direction_ == capture_direction::send) ?
+                std::uint32_t{pcapng::epb_flags_outbound} : std::uint32_t{pcapng::epb_flags_inbound}, .trailingTotalLength_ = totalLength};
+        std::fwrite(&blockHeader, sizeof(blockHeader), 1, file_);
+        std::fwrite(headers, headerSize, 1, file_);
+        std::fwrite(payload, packet.capturedLength_, 1, file_);
+        std::fwrite(padding, paddedLength - capturedLength, 1, file_);
+        std::fwrite(&blockTrailer, sizeof(blockTrailer), 1, file_);
+    }
+    else
+    {
+        pcap::record_header recordHeader{.seconds_ = static_cast<std::uint32_t>(packet.timeStamp_ / 1'000'000'000),
+                .subSeconds_ = static_cast<std::uint32_t>(packet.timeStamp_ % 1'000'000'000),
+                .capturedLength_ = capturedLength, .originalLength_ = originalLength};
+        std::fwrite(&recordHeader, sizeof(recordHeader), 1, file_);
+        std::fwrite(headers, headerSize, 1, file_);
+        std::fwrite(payload, packet.capturedLength_, 1, file_);
+    }
+    written_.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+//=============================================================================
+void bcpp::network::packet_capture::run
+(
+    // the writer thread.  the file is flushed whenever the ring is found to
+    // be empty so that the capture can be inspected while still in progress.
+    std::stop_token stopToken
+)
+{
+    auto flushed = true;
+    auto tail = tail_.load(std::memory_order_relaxed);
+    while (true)
+    {
+        auto stopRequested = stopToken.stop_requested(); // before draining so that nothing queued prior to the stop is lost
+        auto * address = (buffer_.get() + (tail & (bufferSize_ - 1)));
+        auto * header = reinterpret_cast<record_header *>(address);
+        if (auto size = std::atomic_ref(header->size_).load(std::memory_order_acquire); size != 0)
+        {
+            if (!header->isFiller_)
+            {
+                write(*header, address + sizeof(record_header));
+                flushed = false;
+            }
+            std::memset(address, 0, size); // unpublished for when the ring wraps
+            tail += size;
+            tail_.store(tail, std::memory_order_release);
+            continue;
+        }
+        if (stopRequested)
+            break;
+        if (!std::exchange(flushed, true))
+            std::fflush(file_);
+        std::this_thread::sleep_for(idle_sleep_duration);
+    }
+    std::fflush(file_);
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include "./pcap_format.h"
+
+#include <library/network/ip/socket_address.h>
+#include <library/network/socket/traits/network_transport_protocol.h>
+
+#include <include/non_copyable.h>
+#include <include/non_movable.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <span>
+#include <stop_token>
+#include <string>
+#include <thread>
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    enum class capture_direction : std::uint32_t
+    {
+        undefined   = 0,
+        receive     = 1,
+        send        = 2
+    };
+
+
+    //=========================================================================
+    enum class capture_format : std::uint32_t
+    {
+        undefined   = 0,
+        pcap        = 1,    // libpcap with nanosecond timestamps
+        pcapng      = 2     // pcapng (records the direction of each packet)
+    };
+
+
+    //=========================================================================
+    // opt in capture tap for active tcp and udp sockets (see the packetCapture_
+    // socket configuration).  the socket copies the payload (up to the snap
+    // length) into a bounded multi producer byte ring and that is all that the
+    // i/o path pays for.  records are variable length so a record occupies only
+    // as much of the ring as its payload requires.  a background thread drains 
+    // the ring, synthesizes ipv4 and udp/tcp headers (the kernel's headers are 
+    // not visible to the socket) and writes the packets to a pcap or pcapng 
+    // file.  packets are dropped (and counted) rather than blocking the i/o 
+    // path if the writer falls behind.  one capture can be shared by any number
+    // of sockets.
+    class packet_capture :
+        non_copyable,
+        non_movable
+    {
+    public:
+
+        static auto constexpr default_buffer_size = (1 << 24);  // bytes (rounded up to a power of two)
+        static auto constexpr max_snap_length = pcap::max_snap_length;  // payload bytes per packet
+        static auto constexpr default_snap_length = max_snap_length;
+
+        struct configuration
+        {
+            std::string     path_;
+            capture_format  format_{capture_format::pcap};
+            std::size_t     bufferSize_{default_buffer_size};
+            std::size_t     snapLength_{default_snap_length};
+        };
+
+        struct statistics
+        {
+            std::uint64_t   captured_{0};   // packets queued by sockets
+            std::uint64_t   dropped_{0};    // packets discarded because the ring was full
+            std::uint64_t   truncated_{0};  // packets queued with only the first snap length bytes of their payload
+            std::uint64_t   written_{0};    // packets written to the file
+        };
+
+        static std::shared_ptr<packet_capture> create
+        (
+            configuration const &
+        );
+
+        ~packet_capture();
+
+        bool capture
+        (
+            capture_direction,
+            network_transport_protocol,
+            socket_address,
+            socket_address,
+            std::span<std::byte const>,
+            std::uint64_t,
+            std::uint32_t
+        ) noexcept;
+
+        statistics get_statistics() const noexcept;
+
+        static std::uint64_t get_time_stamp() noexcept;
+
+    private:
+
+        // each record within the ring is a header followed by the captured
+        // payload, padded to the alignment of the header.  a record is published
+        // by storing its size last.  the ring is zero wherever no record has been
+        // published (the writer zeroes each record once written) so a zero size
+        // marks the end of the published records.  a record which would wrap is
+        // preceded by a filler record which skips the remainder of the ring.
+        struct alignas(8) record_header
+        {
+            std::uint32_t                           size_;          // header, payload and padding.  published last
+            std::uint32_t                           isFiller_;
+            std::uint64_t                           timeStamp_;     // nanoseconds since the epoch
+            socket_address                          source_;
+            socket_address                          destination_;
+            network_transport_protocol              protocol_;
+            capture_direction                       direction_;
+            std::uint32_t                           sequence_;      // tcp only
+            std::uint32_t                           originalLength_;
+            std::uint32_t                           capturedLength_;
+        };
+
+        static auto constexpr min_buffer_size = (1 << 17);    // can hold a record of max_snap_length
+
+        packet_capture
+        (
+            configuration const &,
+            std::FILE *
+        );
+
+        void write_file_header();
+
+        void write
+        (
+            record_header const &,
+            std::byte const *
+        );
+
+        void run
+        (
+            std::stop_token
+        );
+
+        std::FILE *                                 file_;
+
+        capture_format                              format_;
+
+        std::size_t                                 snapLength_;
+
+        std::size_t                                 bufferSize_;
+
+        std::unique_ptr<std::byte[]>                buffer_;
+
+        // total bytes reserved by producers and released by the writer
+        alignas(64) std::atomic<std::uint64_t>      head_{0};
+
+        alignas(64) std::atomic<std::uint64_t>      tail_{0};
+
+        std::atomic<std::uint64_t>                  captured_{0};
+
+        std::atomic<std::uint64_t>                  dropped_{0};
+
+        std::atomic<std::uint64_t>                  truncated_{0};
+
+        std::atomic<std::uint64_t>                  written_{0};
+
+        std::jthread                                thread_;
+
+    }; // class packet_capture
+
+} // namespace bcpp::network
@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    // on disk layout of the libpcap and pcapng capture formats as written by
+    // packet_capture (and read by the pcap_replay tool).  all fields are in
+    // host byte order (readers detect the byte order from the magic).
+    // packets are raw ipv4 (LINKTYPE_RAW) so no link layer header is present.
+    namespace pcap
+    {
+        static auto constexpr linktype_raw = 101;
+        static auto constexpr max_snap_length = 0xffff;
+
+        //=====================================================================
+        // libpcap
+        static auto constexpr microsecond_magic = 0xa1b2c3d4u;
+        static auto constexpr nanosecond_magic = 0xa1b23c4du;
+        static auto constexpr version_major = 2;
+        static auto constexpr version_minor = 4;
+
+        struct file_header
+        {
+            std::uint32_t   magic_{nanosecond_magic};
+            std::uint16_t   versionMajor_{version_major};
+            std::uint16_t   versionMinor_{version_minor};
+            std::int32_t    thisZone_{0};
+            std::uint32_t   sigFigs_{0};
+            std::uint32_t   snapLength_{max_snap_length};
+            std::uint32_t   linkType_{linktype_raw};
+        };
+
+        static_assert(sizeof(file_header) == 24);
+
+        struct record_header
+        {
+            std::uint32_t   seconds_;
+            std::uint32_t   subSeconds_;        // micro or nano seconds depending on the magic
+            std::uint32_t   capturedLength_;
+            std::uint32_t   originalLength_;
+        };
+
+        static_assert(sizeof(record_header) == 16);
+
+    } // namespace pcap
+
+
+    namespace pcapng
+    {
+        //=====================================================================
+        // pcapng.  every block starts with its type and total length and ends
+        // with the total length repeated.  bodies are padded to four bytes.
+        static auto constexpr section_header_block_type = 0x0a0d0d0au;
+        static auto constexpr interface_description_block_type = 0x00000001u;
+        static auto constexpr simple_packet_block_type = 0x00000003u;
+        static auto constexpr enhanced_packet_block_type = 0x00000006u;
+        static auto constexpr byte_order_magic = 0x1a2b3c4du;
+
+        static auto constexpr option_end = 0;
+        static auto constexpr option_if_tsresol = 9;    // interface description: timestamp resolution
+        static auto constexpr option_epb_flags = 2;     // enhanced packet: direction etc.
+
+        static auto constexpr epb_flags_inbound = 1;
+        static auto constexpr epb_flags_outbound = 2;
+
+        struct block_header
+        {
+            std::uint32_t   type_;
+            std::uint32_t   totalLength_;
+        };
+
+        struct section_header_block
+        {
+            std::uint32_t   type_{section_header_block_type};
+            std::uint32_t   totalLength_{sizeof(section_header_block)};
+            std::uint32_t   byteOrderMagic_{byte_order_magic};
+            std::uint16_t   versionMajor_{1};
+            std::uint16_t   versionMinor_{0};
+            std::uint32_t   sectionLength_[2]{~0u, ~0u};        // -1 (not specified) as two words to avoid padding
+            std::uint32_t   trailingTotalLength_{sizeof(section_header_block)};
+        };
+
+        static_assert(sizeof(section_header_block) == 28);
+
+        // with an if_tsresol option of 9 (timestamps are in nanoseconds)
+        struct interface_description_block
+        {
+            std::uint32_t   type_{interface_description_block_type};
+            std::uint32_t   totalLength_{sizeof(interface_description_block)};
+            std::uint16_t   linkType_{pcap::linktype_raw};
+            std::uint16_t   reserved_{0};
+            std::uint32_t   snapLength_{pcap::max_snap_length};
+            std::uint16_t   tsresolCode_{option_if_tsresol};
+            std::uint16_t   tsresolLength_{1};
+            std::uint8_t    tsresol_[4]{9, 0, 0, 0};
+            std::uint16_t   endCode_{option_end};
+            std::uint16_t   endLength_{0};
+            std::uint32_t   trailingTotalLength_{sizeof(interface_description_block)};
+        };
+
+        static_assert(sizeof(interface_description_block) == 32);
+
+        // followed by the packet data (padded to four bytes), the options and
+        // the trailing total length
+        struct enhanced_packet_block_header
+        {
+            std::uint32_t   type_{enhanced_packet_block_type};
+            std::uint32_t   totalLength_;
+            std::uint32_t   interfaceId_{0};
+            std::uint32_t   timestampHigh_;
+            std::uint32_t   timestampLow_;
+            std::uint32_t   capturedLength_;
+            std::uint32_t   originalLength_;
+        };
+
+        static_assert(sizeof(enhanced_packet_block_header) == 28);
+
+        struct enhanced_packet_block_trailer
+        {
+            std::uint16_t   flagsCode_{option_epb_flags};
+            std::uint16_t   flagsLength_{4};
+            std::uint32_t   flags_;
+            std::uint16_t   endCode_{option_end};
+            std::uint16_t   endLength_{0};
+            std::uint32_t   trailingTotalLength_;
+        };
+
+        static_assert(sizeof(enhanced_packet_block_trailer) == 16);
+
+    } // namespace pcapng
+
+} // namespace bcpp::network
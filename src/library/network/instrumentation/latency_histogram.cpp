@@ -0,0 +1,89 @@
+#include "./latency_histogram.h"
+#include "./tsc.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+
+//=============================================================================
+std::uint64_t bcpp::network::latency_histogram::get_bucket_upper_bound
+(
+    // the largest value which is recorded in the bucket
+    std::size_t index
+) noexcept
+{
+    if (index < num_sub_buckets)
+        return index;
+    auto shift = ((index / num_sub_buckets) - 1);
+    auto subBucket = (index % num_sub_buckets);
+    return (((num_sub_buckets + subBucket + 1) << shift) - 1);
+}
+
+
+//=============================================================================
+auto bcpp::network::latency_histogram::get_statistics
+(
+    // merges the shards.  a snapshot which is not atomic with respect to 
+    // concurrent records.  counts recorded during the snapshot can be 
+    // partially reflected.
+) const -> latency_statistics
+{
+    std::vector<std::uint64_t> buckets(num_buckets);
+    std::uint64_t count = 0;
+    std::uint64_t sum = 0;
+    auto min = std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t max = 0;
+    for (auto const & shard : shards_)
+    {
+        for (auto i = 0u; i < num_buckets; ++i)
+        {
+            auto bucket = shard.buckets_[i].load(std::memory_order_relaxed);
+            buckets[i] += bucket;
+            count += bucket;
+        }
+        sum += shard.sum_.load(std::memory_order_relaxed);
+        min = std::min(min, shard.min_.load(std::memory_order_relaxed));
+        max = std::max(max, shard.max_.load(std::memory_order_relaxed));
+    }
+    if (count == 0)
+        return {};
+
+    auto ticksPerNanosecond = get_tsc_ticks_per_nanosecond();
+    auto to_nanoseconds = [&](std::uint64_t ticks){return std::chrono::nanoseconds(static_cast<std::int64_t>(ticks / ticksPerNanosecond));};
+    auto percentile = [&](double p)
+            {
+                auto target = std::max(static_cast<std::uint64_t>(std::ceil(p * count)), std::uint64_t{1});
+                std::uint64_t total = 0;
+                for (auto i = 0u; i < num_buckets; ++i)
+                    if ((total += buckets[i]) >= target)
+                        return to_nanoseconds(std::min(get_bucket_upper_bound(i), max));
+                return to_nanoseconds(max);
+            };
+    return {
+            .count_ = count,
+            .min_ = to_nanoseconds(min),
+            .mean_ = to_nanoseconds(sum / count),
+            .p50_ = percentile(0.50),
+            .p90_ = percentile(0.90),
+            .p99_ = percentile(0.99),
+            .p999_ = percentile(0.999),
+            .max_ = to_nanoseconds(max)
+        };
+}
+
+
+//=============================================================================
+void bcpp::network::latency_histogram::reset
+(
+) noexcept
+{
+    for (auto & shard : shards_)
+    {
+        for (auto & bucket : shard.buckets_)
+            bucket.store(0, std::memory_order_relaxed);
+        shard.sum_ = 0;
+        shard.min_ = std::numeric_limits<std::uint64_t>::max();
+        shard.max_ = 0;
+    }
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <include/non_copyable.h>
+#include <include/non_movable.h>
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    // summary of a latency_histogram.  percentiles are reported as the upper
+    // bound of the bucket which contains them (within ~6% of the true value).
+    struct latency_statistics
+    {
+        std::uint64_t               count_{0};
+        std::chrono::nanoseconds    min_{0};
+        std::chrono::nanoseconds    mean_{0};
+        std::chrono::nanoseconds    p50_{0};
+        std::chrono::nanoseconds    p90_{0};
+        std::chrono::nanoseconds    p99_{0};
+        std::chrono::nanoseconds    p999_{0};
+        std::chrono::nanoseconds    max_{0};
+    };
+
+
+    //=========================================================================
+    // lock free log-linear (hdr style) histogram of tsc tick durations.  each 
+    // power of two is split into 16 linear sub buckets so that any value is 
+    // recorded with a relative error of at most 1/16 and the full 64 bit range
+    // fits in under 1000 counters.  record is wait free and can be called by
+    // any number of threads concurrently.  each recording thread is assigned 
+    // one of a fixed number of shards (threads share shards only if there are
+    // more threads than shards) so that concurrent records do not contend for
+    // the same cache lines.  the shards are merged by get_statistics.
+    class latency_histogram :
+        non_copyable,
+        non_movable
+    {
+    public:
+
+        static auto constexpr sub_bucket_bits = 4;
+        static auto constexpr num_sub_buckets = (1 << sub_bucket_bits);
+        static auto constexpr num_buckets = ((64 - sub_bucket_bits + 1) * num_sub_buckets);
+        static auto constexpr num_shards = 16;
+
+        latency_histogram() = default;
+
+        void record
+        (
+            std::uint64_t
+        ) noexcept;
+
+        latency_statistics get_statistics() const;
+
+        void reset() noexcept;
+
+    private:
+
+        static std::size_t get_bucket_index
+        (
+            std::uint64_t
+        ) noexcept;
+
+        static std::uint64_t get_bucket_upper_bound
+        (
+            std::size_t
+        ) noexcept;
+
+        static std::size_t get_shard_index() noexcept;
+
+        struct alignas(64) shard
+        {
+            std::array<std::atomic<std::uint64_t>, num_buckets>     buckets_{};
+
+            std::atomic<std::uint64_t>                              sum_{0};
+
+            std::atomic<std::uint64_t>                              min_{std::numeric_limits<std::uint64_t>::max()};
+
+            std::atomic<std::uint64_t>                              max_{0};
+        };
+
+        std::array<shard, num_shards>                           shards_;
+
+    }; // class latency_histogram
+
+} // namespace bcpp::network
+
+
+//=============================================================================
+inline std::size_t bcpp::network::latency_histogram::get_bucket_index
+(
+    std::uint64_t value
+) noexcept
+{
+    if (value < num_sub_buckets)
+        return value;
+    auto shift = (std::bit_width(value) - 1 - sub_bucket_bits);
+    return (((shift + 1) * num_sub_buckets) + ((value >> shift) & (num_sub_buckets - 1)));
+}
+
+
+//=============================================================================
+inline std::size_t bcpp::network::latency_histogram::get_shard_index
+(
+    // shards are assigned to threads round robin upon their first record
+) noexcept
+{
+    static std::atomic<std::size_t> nextShardIndex{0};
+    thread_local auto const shardIndex = (nextShardIndex.fetch_add(1, std::memory_order_relaxed) % num_shards);
+    return shardIndex;
+}
+
+
+//=============================================================================
+inline void bcpp::network::latency_histogram::record
+(
+    std::uint64_t ticks
+) noexcept
+{
+    auto & shard = shards_[get_shard_index()];
+    shard.buckets_[get_bucket_index(ticks)].fetch_add(1, std::memory_order_relaxed);
+    shard.sum_.fetch_add(ticks, std::memory_order_relaxed);
+    // min and max are rarely updated so read before attempting to write
+    for (auto min = shard.min_.load(std::memory_order_relaxed); ticks < min; )
+        if (shard.min_.compare_exchange_weak(min, ticks, std::memory_order_relaxed))
+            break;
+    for (auto max = shard.max_.load(std::memory_order_relaxed); ticks > max; )
+        if (shard.max_.compare_exchange_weak(max, ticks, std::memory_order_relaxed))
+            break;
+}
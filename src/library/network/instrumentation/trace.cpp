@@ -0,0 +1,166 @@
+#include "./trace.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstdio>
+#include <cstring>
+
+
+//=============================================================================
+char const * bcpp::network::to_string
+(
+    trace_event_type traceEventType
+)
+{
+    switch (traceEventType)
+    {
+        case trace_event_type::poll_wakeup: return "poll_wakeup";
+        case trace_event_type::contract_scheduled: return "contract_scheduled";
+        case trace_event_type::contract_executed: return "contract_executed";
+        case trace_event_type::receive: return "receive";
+        case trace_event_type::send: return "send";
+        case trace_event_type::receive_would_block: return "receive_would_block";
+        case trace_event_type::send_would_block: return "send_would_block";
+        case trace_event_type::receive_error: return "receive_error";
+        case trace_event_type::send_error: return "send_error";
+        default: return "undefined";
+    }
+}
+
+
+//=============================================================================
+bcpp::network::trace_ring::trace_ring
+(
+    std::uint32_t threadIndex,
+    std::size_t capacity
+):
+    threadIndex_(threadIndex),
+    capacityMask_(std::bit_ceil(std::max(capacity, std::size_t{2})) - 1),
+    events_(std::make_unique<trace_event[]>(capacityMask_ + 1))
+{
+}
+
+
+//=============================================================================
+auto bcpp::network::trace_ring::get_events
+(
+    // the most recent events, oldest first.  events which are overwritten by
+    // the owning thread during the copy can be torn so the ring should only 
+    // be read while tracing is disabled if exact results are required.
+) const -> std::vector<trace_event>
+{
+    auto head = head_.load(std::memory_order_acquire);
+    auto count = std::min(head, capacityMask_ + 1);
+    std::vector<trace_event> events;
+    events.reserve(count);
+    for (auto i = (head - count); i < head; ++i)
+        events.push_back(events_[i & capacityMask_]);
+    return events;
+}
+
+
+//=============================================================================
+std::uint32_t bcpp::network::trace_ring::get_thread_index
+(
+) const noexcept
+{
+    return threadIndex_;
+}
+
+
+//=============================================================================
+void bcpp::network::trace_ring::clear
+(
+) noexcept
+{
+    head_.store(0, std::memory_order_release);
+}
+
+
+//=============================================================================
+void bcpp::network::trace_recorder::enable
+(
+    // the capacity applies to the rings of threads which have not yet recorded
+    std::size_t ringCapacity
+)
+{
+    ringCapacity_ = ringCapacity;
+    enabled_ = true;
+}
+
+
+//=============================================================================
+void bcpp::network::trace_recorder::disable
+(
+)
+{
+    enabled_ = false;
+}
+
+
+//=============================================================================
+bool bcpp::network::trace_recorder::is_enabled
+(
+) const noexcept
+{
+    return enabled_;
+}
+
+
+//=============================================================================
+auto bcpp::network::trace_recorder::create_thread_ring
+(
+    // invoked once per thread upon its first event
+) -> trace_ring *
+{
+    try
+    {
+        std::lock_guard lockGuard(mutex_);
+        return rings_.emplace_back(std::make_unique<trace_ring>(static_cast<std::uint32_t>(rings_.size()), ringCapacity_)).get();
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+
+
+//=============================================================================
+void bcpp::network::trace_recorder::clear
+(
+    // discard all recorded events.  call while disabled.
+)
+{
+    std::lock_guard lockGuard(mutex_);
+    for (auto & ring : rings_)
+        ring->clear();
+}
+
+
+//=============================================================================
+bool bcpp::network::trace_recorder::dump
+(
+    // write the events of every thread to 'path' (see trace_decoder)
+    std::string const & path
+) const
+{
+    auto * file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr)
+        return false;
+
+    std::lock_guard lockGuard(mutex_);
+    trace_file_header fileHeader{.version_ = trace_file_header::current_version, .eventSize_ = sizeof(trace_event), 
+            .ticksPerNanosecond_ = get_tsc_ticks_per_nanosecond(), .ringCount_ = static_cast<std::uint32_t>(rings_.size())};
+    std::memcpy(fileHeader.magic_, trace_file_header::magic, sizeof(fileHeader.magic_));
+    auto success = (std::fwrite(&fileHeader, sizeof(fileHeader), 1, file) == 1);
+    for (auto const & ring : rings_)
+    {
+        auto events = ring->get_events();
+        trace_ring_header ringHeader{.threadIndex_ = ring->get_thread_index(), .eventCount_ = events.size()};
+        success &= (std::fwrite(&ringHeader, sizeof(ringHeader), 1, file) == 1);
+        if (!events.empty())
+            success &= (std::fwrite(events.data(), sizeof(trace_event), events.size(), file) == events.size());
+    }
+    success &= (std::fclose(file) == 0);
+    return success;
+}
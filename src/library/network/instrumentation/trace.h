@@ -0,0 +1,225 @@
+#pragma once
+
+#include "./tsc.h"
+
+#include <include/non_copyable.h>
+#include <include/non_movable.h>
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    enum class trace_event_type : std::uint16_t
+    {
+        undefined               = 0,
+        poll_wakeup             = 1,    // value: number of events returned by the poll
+        contract_scheduled      = 2,    // receive contract scheduled by poll (or rescheduled)
+        contract_executed       = 3,    // receive contract's work has started
+        receive                 = 4,    // value: bytes received
+        send                    = 5,    // value: bytes sent
+        receive_would_block     = 6,
+        send_would_block        = 7,
+        receive_error           = 8,    // value: errno
+        send_error              = 9     // value: errno
+    };
+
+    char const * to_string
+    (
+        trace_event_type
+    );
+
+
+    //=========================================================================
+    // the binary record of a single event (as written by trace_recorder::dump)
+    struct trace_event
+    {
+        std::uint64_t       tsc_;
+        std::uint64_t       socketId_;
+        std::int32_t        value_;
+        trace_event_type    type_;
+        std::uint16_t       reserved_{0};
+    };
+
+    static_assert(sizeof(trace_event) == 24);
+
+
+    //=========================================================================
+    // dump file layout:  trace_file_header, then for each ring a 
+    // trace_ring_header followed by the ring's events (oldest first)
+    struct trace_file_header
+    {
+        static auto constexpr magic = "NETTRACE";
+        static auto constexpr current_version = 1;
+
+        char            magic_[8];
+        std::uint32_t   version_;
+        std::uint32_t   eventSize_;
+        double          ticksPerNanosecond_;
+        std::uint32_t   ringCount_;
+        std::uint32_t   reserved_;
+    };
+
+
+    //=========================================================================
+    struct trace_ring_header
+    {
+        std::uint32_t   threadIndex_;
+        std::uint32_t   reserved_;
+        std::uint64_t   eventCount_;
+    };
+
+
+    //=========================================================================
+    // fixed capacity ring of the most recent events recorded by one thread.
+    // only the owning thread writes to the ring.  other threads may read it 
+    // (see get_events) at any time.
+    class trace_ring :
+        non_copyable,
+        non_movable
+    {
+    public:
+
+        trace_ring
+        (
+            std::uint32_t,
+            std::size_t
+        );
+
+        void record
+        (
+            trace_event const &
+        ) noexcept;
+
+        std::vector<trace_event> get_events() const;
+
+        std::uint32_t get_thread_index() const noexcept;
+
+        void clear() noexcept;
+
+    private:
+
+        std::uint32_t                       threadIndex_;
+
+        std::uint64_t                       capacityMask_;
+
+        std::unique_ptr<trace_event[]>      events_;
+
+        std::atomic<std::uint64_t>          head_{0};
+
+    }; // class trace_ring
+
+
+    //=========================================================================
+    // process wide, opt in trace of the i/o path.  each thread which records 
+    // an event is given its own trace_ring (upon its first event) so recording 
+    // is lock free and costs a tsc read and a 24 byte store.  rings are kept
+    // for the life of the process so that the events of threads which have 
+    // exited can still be dumped.  instrumentation sites use NETWORK_TRACE_EVENT 
+    // which compiles to nothing unless NETWORK_TRACE is defined.
+    class trace_recorder :
+        non_copyable,
+        non_movable
+    {
+    public:
+
+        static auto constexpr default_ring_capacity = (1 << 16);   // events per thread
+
+        static trace_recorder & get();
+
+        void enable
+        (
+            std::size_t = default_ring_capacity
+        );
+
+        void disable();
+
+        bool is_enabled() const noexcept;
+
+        void record
+        (
+            trace_event_type,
+            std::uint64_t,
+            std::int64_t
+        ) noexcept;
+
+        bool dump
+        (
+            std::string const &
+        ) const;
+
+        void clear();
+
+    private:
+
+        trace_recorder() = default;
+
+        trace_ring * create_thread_ring();
+
+        std::atomic<bool>                           enabled_{false};
+
+        std::atomic<std::size_t>                    ringCapacity_{default_ring_capacity};
+
+        mutable std::mutex                          mutex_;
+
+        std::vector<std::unique_ptr<trace_ring>>    rings_;
+
+    }; // class trace_recorder
+
+} // namespace bcpp::network
+
+
+#if defined(NETWORK_TRACE)
+    #define NETWORK_TRACE_EVENT(type, socketId, value) \
+            ::bcpp::network::trace_recorder::get().record(::bcpp::network::trace_event_type::type, (socketId), (value))
+#else
+    #define NETWORK_TRACE_EVENT(type, socketId, value) ((void)0)
+#endif
+
+
+//=============================================================================
+inline void bcpp::network::trace_ring::record
+(
+    trace_event const & traceEvent
+) noexcept
+{
+    auto head = head_.load(std::memory_order_relaxed);
+    events_[head & capacityMask_] = traceEvent;
+    head_.store(head + 1, std::memory_order_release);
+}
+
+
+//=============================================================================
+inline auto bcpp::network::trace_recorder::get
+(
+    // deliberately never destroyed so that threads can record during static destruction
+) -> trace_recorder &
+{
+    static auto * traceRecorder = new trace_recorder;
+    return *traceRecorder;
+}
+
+
+//=============================================================================
+inline void bcpp::network::trace_recorder::record
+(
+    trace_event_type traceEventType,
+    std::uint64_t socketId,
+    std::int64_t value
+) noexcept
+{
+    if (!enabled_.load(std::memory_order_relaxed))
+        return;
+    static thread_local trace_ring * traceRing = nullptr;
+    if (traceRing == nullptr)
+        if ((traceRing = create_thread_ring()) == nullptr)
+            return;
+    traceRing->record({.tsc_ = read_tsc(), .socketId_ = socketId, .value_ = static_cast<std::int32_t>(value), .type_ = traceEventType});
+}
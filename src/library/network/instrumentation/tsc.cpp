@@ -0,0 +1,27 @@
+#include "./tsc.h"
+
+#include <thread>
+
+
+//=============================================================================
+double bcpp::network::get_tsc_ticks_per_nanosecond
+(
+    // calibrated against steady_clock once (on first use) which takes ~10ms
+)
+{
+    static double const ticksPerNanosecond = []()
+            {
+                #if defined(__x86_64__) || defined(__i386__) || defined(__aarch64__)
+                    using namespace std::chrono;
+                    auto startTime = steady_clock::now();
+                    auto startTicks = read_tsc();
+                    std::this_thread::sleep_for(milliseconds(10));
+                    auto ticks = (read_tsc() - startTicks);
+                    auto elapsed = duration_cast<nanoseconds>(steady_clock::now() - startTime).count();
+                    return (elapsed > 0) ? (static_cast<double>(ticks) / elapsed) : 1.0;
+                #else
+                    return 1.0;
+                #endif
+            }();
+    return ticksPerNanosecond;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <x86intrin.h>
+#endif
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    // a cheap monotonic tick counter for instrumentation.  the time stamp 
+    // counter on x86, the virtual counter on aarch64 and steady_clock (in 
+    // nanoseconds) elsewhere.  ticks are converted to nanoseconds only when
+    // instrumentation is read (see get_tsc_ticks_per_nanosecond).
+    inline std::uint64_t read_tsc
+    (
+    ) noexcept
+    {
+        #if defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+        #elif defined(__aarch64__)
+            std::uint64_t ticks;
+            asm volatile("mrs %0, cntvct_el0" : "=r"(ticks));
+            return ticks;
+        #else
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        #endif
+    }
+
+
+    double get_tsc_ticks_per_nanosecond();
+
+} // namespace bcpp::network
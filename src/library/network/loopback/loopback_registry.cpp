@@ -0,0 +1,84 @@
+#include "./loopback_registry.h"
+#include <library/network/socket/private/loopback_socket_impl.h>
+
+#include <mutex>
+
+
+//=============================================================================
+auto bcpp::network::loopback_registry::get
+(
+) -> loopback_registry &
+{
+    static loopback_registry loopbackRegistry;
+    return loopbackRegistry;
+}
+
+
+//=============================================================================
+std::uint64_t bcpp::network::loopback_registry::get_key
+(
+    socket_address socketAddress
+)
+{
+    return ((static_cast<std::uint64_t>(static_cast<::in_addr>(socketAddress.get_ip_address()).s_addr) << 16) |
+            socketAddress.get_port_id().get());
+}
+
+
+//=============================================================================
+auto bcpp::network::loopback_registry::add
+(
+    // bind the socket to the address.  if the port is 'any' then an unused
+    // ephemeral port is assigned.  returns the bound address or an invalid
+    // address if the address is already in use.
+    socket_address socketAddress,
+    socket_impl<loopback_socket_traits> & loopbackSocket
+) -> socket_address
+{
+    std::unique_lock uniqueLock(mutex_);
+    if (socketAddress.get_port_id().get() == port_id::any)
+    {
+        for (auto i = 0; i < (0x10000 - first_ephemeral_port); ++i)
+        {
+            socket_address candidate(socketAddress.get_ip_address(), port_id(static_cast<port_id::value_type>(nextEphemeralPort_)));
+            if (++nextEphemeralPort_ > 0xffff)
+                nextEphemeralPort_ = first_ephemeral_port;
+            if (sockets_.emplace(get_key(candidate), &loopbackSocket).second)
+                return candidate;
+        }
+        return {}; // exhausted
+    }
+    if (!sockets_.emplace(get_key(socketAddress), &loopbackSocket).second)
+        return {}; // in use
+    return socketAddress;
+}
+
+
+//=============================================================================
+void bcpp::network::loopback_registry::remove
+(
+    // once remove returns no delivery to the socket is in progress and no
+    // further deliveries can take place
+    socket_address socketAddress
+)
+{
+    std::unique_lock uniqueLock(mutex_);
+    sockets_.erase(get_key(socketAddress));
+}
+
+
+//=============================================================================
+bool bcpp::network::loopback_registry::deliver
+(
+    // returns false if there is no socket at the destination or if its receive
+    // queue is full (in which case the packet is dropped as it would be for udp)
+    socket_address destination,
+    socket_address source,
+    packet && data
+)
+{
+    std::shared_lock sharedLock(mutex_);
+    if (auto iter = sockets_.find(get_key(destination)); iter != sockets_.end())
+        return iter->second->deliver(source, std::move(data));
+    return false;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <library/network/ip/socket_address.h>
+#include <library/network/packet/packet.h>
+#include <library/network/socket/socket.h>
+
+#include <include/non_copyable.h>
+#include <include/non_movable.h>
+
+#include <cstdint>
+#include <shared_mutex>
+#include <unordered_map>
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    // process wide directory of loopback sockets keyed by socket address.
+    // delivery takes a shared lock so that any number of senders can deliver
+    // concurrently while a socket can not be removed (and destroyed) part way
+    // through a delivery to it.
+    class loopback_registry :
+        non_copyable,
+        non_movable
+    {
+    public:
+
+        static auto constexpr first_ephemeral_port = 49152;
+
+        static loopback_registry & get();
+
+        socket_address add
+        (
+            socket_address,
+            socket_impl<loopback_socket_traits> &
+        );
+
+        void remove
+        (
+            socket_address
+        );
+
+        bool deliver
+        (
+            socket_address,
+            socket_address,
+            packet &&
+        );
+
+    private:
+
+        loopback_registry() = default;
+
+        static std::uint64_t get_key
+        (
+            socket_address
+        );
+
+        std::shared_mutex                                                       mutex_;
+
+        std::unordered_map<std::uint64_t, socket_impl<loopback_socket_traits> *>   sockets_;
+
+        std::uint32_t                                                           nextEphemeralPort_{first_ephemeral_port};
+
+    }; // class loopback_registry
+
+} // namespace bcpp::network
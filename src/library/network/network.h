@@ -1,6 +1,8 @@
 #pragma once
 
 #include "./network_interface/virtual_network_interface.h"
+#include "./arbitration/feed_arbitrator.h"
+#include "./network_interface/udp_socket_group.h"
 
 #include <string>
 #include <vector>
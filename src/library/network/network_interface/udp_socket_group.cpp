@@ -0,0 +1,109 @@
+#include "./udp_socket_group.h"
+
+#include <linux/filter.h>
+#include <sys/socket.h>
+
+#include <array>
+#include <iostream>
+
+
+//=============================================================================
+bcpp::network::udp_socket_group::udp_socket_group
+(
+    std::span<virtual_network_interface *> virtualNetworkInterfaces,
+    configuration const & config,
+    udp_socket::event_handlers const & eventHandlers
+)
+{
+    auto socketConfiguration = config.socketConfiguration_;
+    socketConfiguration.reusePort_ = true;
+    auto portId = config.portId_;
+    for (auto virtualNetworkInterface : virtualNetworkInterfaces)
+    {
+        auto & member = members_.emplace_back(virtualNetworkInterface->create_udp_socket(portId, socketConfiguration, eventHandlers));
+        if (!member.is_valid())
+        {
+            std::cerr << "udp_socket_group: failed to create member " << (members_.size() - 1) << "\n";
+            members_.clear();
+            return;
+        }
+        portId = member.get_socket_address().get_port_id(); // if ephemeral then the rest join the same port
+    }
+
+    if ((!members_.empty()) && (!attach_steering_program(config.steeringMode_)))
+    {
+        std::cerr << "udp_socket_group: failed to attach steering program\n";
+        members_.clear();
+    }
+}
+
+
+//=============================================================================
+bool bcpp::network::udp_socket_group::attach_steering_program
+(
+    // the program returns the index (in order of bind) of the member which is
+    // to receive the datagram.  attaching to any one member applies to the group.
+    steering_mode steeringMode
+)
+{
+    std::uint32_t ancillaryOffset = 0;
+    switch (steeringMode)
+    {
+        case steering_mode::none:
+            return true;
+        case steering_mode::cpu:
+            ancillaryOffset = (SKF_AD_OFF + SKF_AD_CPU);
+            break;
+        case steering_mode::flow_hash:
+            ancillaryOffset = (SKF_AD_OFF + SKF_AD_RXHASH);
+            break;
+        default:
+            return false;
+    }
+
+    std::array<::sock_filter, 3> code
+    {{
+        {BPF_LD | BPF_W | BPF_ABS, 0, 0, ancillaryOffset},                      // A = cpu or rxhash
+        {BPF_ALU | BPF_MOD | BPF_K, 0, 0, static_cast<std::uint32_t>(members_.size())},  // A %= number of members
+        {BPF_RET | BPF_A, 0, 0, 0}                                              // return A
+    }};
+    ::sock_fprog program{.len = static_cast<unsigned short>(code.size()), .filter = code.data()};
+    return (::setsockopt(members_.front().get_file_descriptor().get(), SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &program, sizeof(program)) == 0);
+}
+
+
+//=============================================================================
+bool bcpp::network::udp_socket_group::is_valid
+(
+) const
+{
+    return (!members_.empty());
+}
+
+
+//=============================================================================
+std::size_t bcpp::network::udp_socket_group::size
+(
+) const
+{
+    return members_.size();
+}
+
+
+//=============================================================================
+auto bcpp::network::udp_socket_group::operator[]
+(
+    std::size_t index
+) -> udp_socket &
+{
+    return members_[index];
+}
+
+
+//=============================================================================
+auto bcpp::network::udp_socket_group::get_port_id
+(
+) const -> port_id
+{
+    return (members_.empty()) ? port_id{} : members_.front().get_socket_address().get_port_id();
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "./virtual_network_interface.h"
+
+#include <include/non_copyable.h>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    // a group of udp sockets which share one port via SO_REUSEPORT.  one member
+    // is created per virtual network interface (shard) so each member is polled
+    // and serviced by whichever thread drives that shard.  the kernel steers each
+    // incoming datagram to one member using a classic BPF program which selects 
+    // the member by receiving cpu or by flow hash (modulo the number of members).
+    // with cpu steering and shard N driven by a thread pinned to cpu N, datagrams
+    // are processed on the core which took the interrupt.
+    class udp_socket_group :
+        non_copyable
+    {
+    public:
+
+        enum class steering_mode : std::uint32_t
+        {
+            undefined   = 0,
+            none        = 1,    // kernel default (hash of the 4-tuple)
+            cpu         = 2,    // receiving cpu modulo number of members
+            flow_hash   = 3     // nic/kernel flow hash (rxhash) modulo number of members
+        };
+
+        struct configuration
+        {
+            port_id                     portId_{port_id_any};
+            steering_mode               steeringMode_{steering_mode::cpu};
+            udp_socket::configuration   socketConfiguration_;
+        };
+
+        udp_socket_group() = default;
+
+        udp_socket_group
+        (
+            std::span<virtual_network_interface *>,
+            configuration const &,
+            udp_socket::event_handlers const &
+        );
+
+        udp_socket_group(udp_socket_group &&) = default;
+        udp_socket_group & operator = (udp_socket_group &&) = default;
+
+        bool is_valid() const;
+
+        std::size_t size() const;
+
+        udp_socket & operator[]
+        (
+            std::size_t
+        );
+
+        port_id get_port_id() const;
+
+    private:
+
+        bool attach_steering_program
+        (
+            steering_mode
+        );
+
+        std::vector<udp_socket>     members_;
+
+    }; // class udp_socket_group
+
+} // namespace bcpp::network
@@ -15,6 +15,7 @@ bcpp::network::virtual_network_interface::virtual_network_interface
     poller_ = poller_->create({});
     sendWorkContractGroup_ = std::make_unique<work_contract_group>(default_capacity);
     receiveWorkContractGroup_ = std::make_unique<work_contract_group>(default_capacity);
+    timerWheel_ = timer_wheel::create({});
     stopped_ = false;
 }
 
@@ -31,6 +32,7 @@ bcpp::network::virtual_network_interface::virtual_network_interface
         poller_ = poller_->create(config.poller_);
         sendWorkContractGroup_ = std::make_unique<work_contract_group>(config.capacity_);
         receiveWorkContractGroup_ = std::make_unique<work_contract_group>(config.capacity_);
+        timerWheel_ = timer_wheel::create(config.timerWheel_);
         stopped_ = false;
     }
 }
@@ -45,6 +47,7 @@ bcpp::network::virtual_network_interface::virtual_network_interface
     poller_(other.poller_),
     sendWorkContractGroup_(std::move(other.sendWorkContractGroup_)),
     receiveWorkContractGroup_(std::move(other.receiveWorkContractGroup_)),
+    timerWheel_(std::move(other.timerWheel_)),
     stopped_(other.stopped_.load())
 {
     other.networkInterfaceConfiguration_ = {};
@@ -67,6 +70,7 @@ auto bcpp::network::virtual_network_interface::operator =
         poller_ = other.poller_;
         sendWorkContractGroup_ = std::move(other.sendWorkContractGroup_);
         receiveWorkContractGroup_ = std::move(other.receiveWorkContractGroup_);
+        timerWheel_ = std::move(other.timerWheel_);
         stopped_ = other.stopped_.load();
 
         other.networkInterfaceConfiguration_ = {};
@@ -132,10 +136,14 @@ void bcpp::network::virtual_network_interface::stop
     if (auto wasRunning = (stopped_.exchange(true) == false); wasRunning)
     {
         networkInterfaceConfiguration_ = {};
+        // release any sockets still queued for release by the poller while their
+        // work contract groups still exist
+        poller_->close();
         receiveWorkContractGroup_->stop();
         receiveWorkContractGroup_ = {};
         sendWorkContractGroup_->stop();
         sendWorkContractGroup_ = {};
+        timerWheel_ = {};
         poller_ = {};
 
         // any work contracts that were surrendered in the previous step must not be 
@@ -155,8 +163,11 @@ auto bcpp::network::virtual_network_interface::open_socket
     typename S::event_handlers eventHandlers
 ) -> S
 {
+    if constexpr (std::is_same_v<S, udp_socket>)
+        if (!config.multicastInterface_.is_valid())
+            config.multicastInterface_ = networkInterfaceConfiguration_.ipAddress_;
     if constexpr (active_socket_concept<S>)
-        return S(std::move(handle), config, eventHandlers, *sendWorkContractGroup_, *receiveWorkContractGroup_, poller_);
+        return S(std::move(handle), config, eventHandlers, *sendWorkContractGroup_, *receiveWorkContractGroup_, poller_, timerWheel_);
     else
         return S(std::move(handle), config, eventHandlers, *receiveWorkContractGroup_, poller_);
 }
@@ -199,6 +210,48 @@ auto bcpp::network::virtual_network_interface::create_tcp_socket
 }
 
 
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+auto bcpp::network::virtual_network_interface::create_unix_listener_socket
+(
+    // unix domain sockets are not associated with the ip address of this interface 
+    // but are polled and serviced by it like any other socket
+    unix_socket_path unixSocketPath,
+    typename passive_socket<P>::configuration config,
+    typename passive_socket<P>::event_handlers eventHandlers
+) -> passive_socket<P> requires (unix_concept<P>)
+{
+    return open_socket<passive_socket<P>>(unixSocketPath, config, eventHandlers);
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+auto bcpp::network::virtual_network_interface::accept_unix_socket
+(
+    system::file_descriptor fileDescriptor,
+    typename active_socket<P>::configuration config,
+    typename active_socket<P>::event_handlers eventHandlers
+) -> active_socket<P> requires (unix_concept<P>)
+{
+    return open_socket<active_socket<P>>(std::move(fileDescriptor), config, eventHandlers);
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+auto bcpp::network::virtual_network_interface::create_unix_socket
+(
+    // connect to the unix domain listener which is bound to the specified path
+    unix_socket_path peerSocketPath,
+    typename active_socket<P>::configuration config,
+    typename active_socket<P>::event_handlers eventHandlers
+) -> active_socket<P> requires (unix_concept<P>)
+{
+    return open_socket<active_socket<P>>(peerSocketPath, config, eventHandlers);
+}
+
+
 //=============================================================================
 auto bcpp::network::virtual_network_interface::create_udp_socket
 (
@@ -207,7 +260,7 @@ auto bcpp::network::virtual_network_interface::create_udp_socket
     udp_socket::event_handlers eventHandlers
 ) -> udp_socket
 {
-    return open_socket<udp_socket>(socket_address{networkInterfaceConfiguration_.ipAddress_, port_id_any}, config, eventHandlers);
+    return open_socket<udp_socket>(socket_address{networkInterfaceConfiguration_.ipAddress_, localPortId}, config, eventHandlers);
 }
 
 
@@ -236,13 +289,71 @@ auto bcpp::network::virtual_network_interface::multicast_join
 }
 
 
+//=============================================================================
+auto bcpp::network::virtual_network_interface::multicast_join
+(
+    // source specific multicast join
+    socket_address socketAddress,
+    ip_address source,
+    udp_socket::configuration config,
+    udp_socket::event_handlers eventHandlers
+) -> udp_socket
+{
+    auto udpSocket = open_socket<udp_socket>(socket_address{in_addr_any, socketAddress.get_port_id()}, config, eventHandlers);
+    udpSocket.join(socketAddress.get_ip_address(), source);
+    return udpSocket;
+}
+
+
+//=============================================================================
+auto bcpp::network::virtual_network_interface::create_shared_memory_socket
+(
+    // the receiving socket creates the named ring.  sending sockets attach to it.
+    std::string name,
+    shared_memory_socket::configuration config,
+    shared_memory_socket::event_handlers eventHandlers
+) -> shared_memory_socket
+{
+    return open_socket<shared_memory_socket>(std::move(name), config, eventHandlers);
+}
+
+
+//=============================================================================
+auto bcpp::network::virtual_network_interface::create_loopback_socket
+(
+    // in process socket bound to this interface's ip address.  use port_id_any
+    // for an ephemeral port.
+    port_id localPortId,
+    loopback_socket::configuration config,
+    loopback_socket::event_handlers eventHandlers
+) -> loopback_socket
+{
+    return open_socket<loopback_socket>(socket_address{networkInterfaceConfiguration_.ipAddress_, localPortId}, config, eventHandlers);
+}
+
+
+//=============================================================================
+auto bcpp::network::virtual_network_interface::create_timer
+(
+    timer::configuration config,
+    timer::event_handlers eventHandlers
+) -> timer
+{
+    return timer(config, eventHandlers, *receiveWorkContractGroup_, timerWheel_);
+}
+
+
 //=============================================================================
 void bcpp::network::virtual_network_interface::poll
 (
+    // poll for at most the specified duration or until the next timer is due
     std::chrono::milliseconds duration
 )
 {
+    if (auto timeUntilNextExpiry = timerWheel_->get_time_until_next_expiry(); timeUntilNextExpiry < duration)
+        duration = std::chrono::ceil<std::chrono::milliseconds>(timeUntilNextExpiry);
     poller_->poll(duration);
+    timerWheel_->advance();
 }
 
 
@@ -252,6 +363,28 @@ void bcpp::network::virtual_network_interface::poll
 )
 {
     poller_->poll();
+    timerWheel_->advance();
+}
+
+
+//=============================================================================
+auto bcpp::network::virtual_network_interface::get_dispatch_latency_statistics
+(
+    // the delay between a socket being scheduled by poll and its receive work 
+    // executing.  requires poller::configuration::dispatchLatencyInstrumentation_
+) const -> latency_statistics
+{
+    return (poller_) ? poller_->get_dispatch_latency_statistics() : latency_statistics{};
+}
+
+
+//=============================================================================
+void bcpp::network::virtual_network_interface::reset_dispatch_latency_statistics
+(
+)
+{
+    if (poller_)
+        poller_->reset_dispatch_latency_statistics();
 }
 
 
@@ -283,5 +416,27 @@ namespace bcpp::network
     template tcp_socket virtual_network_interface::open_socket(ip_address, tcp_socket::configuration, tcp_socket::event_handlers);
     template tcp_listener_socket virtual_network_interface::open_socket(socket_address, tcp_listener_socket::configuration, tcp_listener_socket::event_handlers);
     template udp_socket virtual_network_interface::open_socket(socket_address, udp_socket::configuration, udp_socket::event_handlers);
+    template unix_stream_socket virtual_network_interface::open_socket(system::file_descriptor, unix_stream_socket::configuration, unix_stream_socket::event_handlers);
+    template unix_stream_socket virtual_network_interface::open_socket(unix_socket_path, unix_stream_socket::configuration, unix_stream_socket::event_handlers);
+    template unix_stream_listener_socket virtual_network_interface::open_socket(unix_socket_path, unix_stream_listener_socket::configuration, unix_stream_listener_socket::event_handlers);
+    template unix_seqpacket_socket virtual_network_interface::open_socket(system::file_descriptor, unix_seqpacket_socket::configuration, unix_seqpacket_socket::event_handlers);
+    template unix_seqpacket_socket virtual_network_interface::open_socket(unix_socket_path, unix_seqpacket_socket::configuration, unix_seqpacket_socket::event_handlers);
+    template unix_seqpacket_listener_socket virtual_network_interface::open_socket(unix_socket_path, unix_seqpacket_listener_socket::configuration, unix_seqpacket_listener_socket::event_handlers);
+
+    template shared_memory_socket virtual_network_interface::open_socket(std::string, shared_memory_socket::configuration, shared_memory_socket::event_handlers);
+    template loopback_socket virtual_network_interface::open_socket(socket_address, loopback_socket::configuration, loopback_socket::event_handlers);
+
+    template unix_stream_listener_socket virtual_network_interface::create_unix_listener_socket<network_transport_protocol::unix_stream>(unix_socket_path, 
+            unix_stream_listener_socket::configuration, unix_stream_listener_socket::event_handlers);
+    template unix_seqpacket_listener_socket virtual_network_interface::create_unix_listener_socket<network_transport_protocol::unix_seqpacket>(unix_socket_path, 
+            unix_seqpacket_listener_socket::configuration, unix_seqpacket_listener_socket::event_handlers);
+    template unix_stream_socket virtual_network_interface::accept_unix_socket<network_transport_protocol::unix_stream>(system::file_descriptor, 
+            unix_stream_socket::configuration, unix_stream_socket::event_handlers);
+    template unix_seqpacket_socket virtual_network_interface::accept_unix_socket<network_transport_protocol::unix_seqpacket>(system::file_descriptor, 
+            unix_seqpacket_socket::configuration, unix_seqpacket_socket::event_handlers);
+    template unix_stream_socket virtual_network_interface::create_unix_socket<network_transport_protocol::unix_stream>(unix_socket_path, 
+            unix_stream_socket::configuration, unix_stream_socket::event_handlers);
+    template unix_seqpacket_socket virtual_network_interface::create_unix_socket<network_transport_protocol::unix_seqpacket>(unix_socket_path, 
+            unix_seqpacket_socket::configuration, unix_seqpacket_socket::event_handlers);
 
 }
\ No newline at end of file
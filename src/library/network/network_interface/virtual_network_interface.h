@@ -9,11 +9,16 @@
 #include <library/network/poller/poller.h>
 #include <library/network/socket/active_socket.h>
 #include <library/network/socket/passive_socket.h>
+#include <library/network/socket/shared_memory_socket.h>
+#include <library/network/socket/loopback_socket.h>
+#include <library/network/timer/timer.h>
+#include <library/network/timer/timer_wheel.h>
 
 #include <library/system.h>
 
 #include <memory>
 #include <chrono>
+#include <string>
 
 
 namespace bcpp::network
@@ -30,6 +35,7 @@ namespace bcpp::network
         {
             network_interface_configuration     networkInterfaceConfiguration_;
             poller::configuration               poller_;
+            timer_wheel::configuration          timerWheel_;
             std::int64_t                        capacity_{default_capacity};
         };
 
@@ -72,6 +78,30 @@ namespace bcpp::network
             tcp_socket::event_handlers
         );
 
+        template <network_transport_protocol P>
+        passive_socket<P> create_unix_listener_socket
+        (
+            unix_socket_path,
+            typename passive_socket<P>::configuration,
+            typename passive_socket<P>::event_handlers
+        ) requires (unix_concept<P>);
+
+        template <network_transport_protocol P>
+        active_socket<P> accept_unix_socket
+        (
+            system::file_descriptor,
+            typename active_socket<P>::configuration,
+            typename active_socket<P>::event_handlers
+        ) requires (unix_concept<P>);
+
+        template <network_transport_protocol P>
+        active_socket<P> create_unix_socket
+        (
+            unix_socket_path,
+            typename active_socket<P>::configuration,
+            typename active_socket<P>::event_handlers
+        ) requires (unix_concept<P>);
+
         udp_socket create_udp_socket
         (
             port_id,
@@ -92,6 +122,34 @@ namespace bcpp::network
             udp_socket::event_handlers
         );
 
+        udp_socket multicast_join
+        (
+            socket_address,
+            ip_address,
+            udp_socket::configuration,
+            udp_socket::event_handlers
+        );
+
+        shared_memory_socket create_shared_memory_socket
+        (
+            std::string,
+            shared_memory_socket::configuration,
+            shared_memory_socket::event_handlers
+        );
+
+        loopback_socket create_loopback_socket
+        (
+            port_id,
+            loopback_socket::configuration,
+            loopback_socket::event_handlers
+        );
+
+        timer create_timer
+        (
+            timer::configuration,
+            timer::event_handlers
+        );
+
         void poll();
 
         void poll
@@ -108,6 +166,10 @@ namespace bcpp::network
 
         void stop();
 
+        latency_statistics get_dispatch_latency_statistics() const;
+
+        void reset_dispatch_latency_statistics();
+
         bool is_loop_back() const;
 
         ip_address get_ip_address() const;
@@ -130,6 +192,7 @@ namespace bcpp::network
         std::shared_ptr<poller>                                 poller_;
         std::unique_ptr<work_contract_group>                sendWorkContractGroup_;
         std::unique_ptr<work_contract_group>                receiveWorkContractGroup_;
+        std::shared_ptr<timer_wheel>                            timerWheel_;
 
         std::atomic<bool>                                       stopped_{true};
         
@@ -53,13 +53,21 @@ namespace bcpp::network
  
     private:
  
-        static auto constexpr invalid_buffer_index{-1};
+        // each slot's sequence tells poppers whether the slot holds a buffer for
+        // the current lap (sequence == position + 1) and pushers whether the slot
+        // has been vacated by the previous lap (sequence == position).  a slot is
+        // therefore never overwritten while a pop which claimed it is still reading it.
+        struct slot
+        {
+            std::atomic<std::uint64_t>  sequence_;
+            buffer_index                bufferIndex_;
+        };
  
         system::anonymous_mapping                           allocation_;
         char *                                              allocationBegin_;
         char *                                              allocationEnd_;
  
-        std::unique_ptr<buffer_index volatile []>           queue_;
+        std::unique_ptr<slot []>                            queue_;
  
         std::atomic<std::uint64_t>                          front_{0};
         std::atomic<std::uint64_t>                          back_{0};
@@ -83,43 +91,65 @@ inline bcpp::network::buffer_heap::buffer_heap
             .mmapFlags_ = MAP_HUGETLB | (21 << MAP_HUGE_SHIFT)},
             {}));
     allocationBegin_ = reinterpret_cast<char *>(allocation_.data());
-    allocationEnd_ = (allocationBegin_ != nullptr) ? (allocationBegin_ + capacity) : nullptr;
-    queue_ = std::move(std::make_unique<buffer_index volatile []>(capacity));
+    allocationEnd_ = (allocationBegin_ != nullptr) ? (allocationBegin_ + (buffer_capacity * capacity)) : nullptr;
+    queue_ = std::move(std::make_unique<slot []>(capacity));
+    back_ = (allocationBegin_ != nullptr) ? capacity : 0;
     for (auto bufferIndex = 0ull; bufferIndex < capacity; ++bufferIndex)
-        queue_[bufferIndex] = bufferIndex;
-    back_ = std::distance(allocationBegin_, allocationEnd_);
+    {
+        queue_[bufferIndex].bufferIndex_ = bufferIndex;
+        queue_[bufferIndex].sequence_ = (bufferIndex < back_) ? (bufferIndex + 1) : bufferIndex;
+    }
 }
  
  
 //=============================================================================
 inline auto bcpp::network::buffer_heap::pop
 (
+    // returns an empty buffer if the heap is exhausted
 ) -> type
 {
-    auto front = front_.load();
-    while (front < back_)
+    auto front = front_.load(std::memory_order_relaxed);
+    while (true)
     {
-        if (front_.compare_exchange_strong(front, front + 1))
+        auto & s = queue_[front & capacityMask_];
+        auto sequence = s.sequence_.load(std::memory_order_acquire);
+        if (sequence == (front + 1))
+        {
+            if (front_.compare_exchange_weak(front, front + 1, std::memory_order_relaxed))
+            {
+                auto bufferIndex = s.bufferIndex_;
+                s.sequence_.store(front + capacityMask_ + 1, std::memory_order_release);
+                return {allocationBegin_ + (bufferIndex * buffer_capacity), buffer_capacity};
+            }
+        }
+        else if ((sequence <= front) && (front >= back_.load(std::memory_order_relaxed)))
+        {
+            return {}; // exhausted
+        }
+        else
         {
-            front &= capacityMask_;
-            buffer_index bufferIndex = queue_[front];
-            while (bufferIndex == invalid_buffer_index)
-                bufferIndex = queue_[front];
-            queue_[front] = invalid_buffer_index;
-            return {allocationBegin_ + (bufferIndex * buffer_capacity), buffer_capacity};
+            // another pop claimed this position or a push to it is in progress
+            front = front_.load(std::memory_order_relaxed);
         }
     }
-    return {};
 }
  
  
 //=============================================================================
 inline void bcpp::network::buffer_heap::push
 (
+    // there are never more buffers than slots so a push always finds room.
+    // it may only need to wait for a pop of the previous lap to finish
+    // reading the slot.
     type allocation
 )
 {
-    queue_[back_++ & capacityMask_] = (std::distance(allocationBegin_, allocation.data()) / buffer_capacity);
+    auto back = back_.fetch_add(1, std::memory_order_relaxed);
+    auto & s = queue_[back & capacityMask_];
+    while (s.sequence_.load(std::memory_order_acquire) != back)
+        ;
+    s.bufferIndex_ = (std::distance(allocationBegin_, allocation.data()) / buffer_capacity);
+    s.sequence_.store(back + 1, std::memory_order_release);
 }
  
  
@@ -237,7 +237,7 @@ inline auto bcpp::network::packet::capacity
 (
 ) const
 {
-    return (buffer_.size() - ((ownsData_) ? sizeof(packet_header) : 0));
+    return (buffer_.size() - begin_);
 }
 
 
@@ -282,7 +282,7 @@ inline auto bcpp::network::packet::data
 (
 ) const -> element_type const *
 {
-    return (buffer_.data() + ((ownsData_) ? sizeof(packet_header) : 0));
+    return (buffer_.data() + begin_);
 }
 
 
@@ -291,7 +291,7 @@ inline auto bcpp::network::packet::data
 (
 ) -> element_type *
 {
-    return (buffer_.data() + ((ownsData_) ? sizeof(packet_header) : 0));
+    return (buffer_.data() + begin_);
 }
 
 
@@ -391,9 +391,10 @@ inline bool bcpp::network::packet::set_content
     std::span<element_type const> input
 )
 {
-    if (capacity() < input.size())
+    auto begin = ((ownsData_) ? sizeof(packet_header) : 0);
+    if ((buffer_.size() - begin) < input.size())
         return false;
-    begin_ = sizeof(packet_header);
+    begin_ = begin;
     std::copy_n(input.data(), input.size(), data());
     size_ = input.size();
     return true;
@@ -1,6 +1,8 @@
 #if !defined(USE_KQUEUE)
 
 #include "./poller.h"
+#include <library/network/instrumentation/trace.h>
+#include <library/network/instrumentation/tsc.h>
 
 #include <library/network/socket/private/active_socket_impl.h>
 #include <library/network/socket/private/passive_socket_impl.h>
@@ -13,7 +15,9 @@
 #include <fcntl.h>
 #include <sys/un.h>
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
 
+#include <algorithm>
 #include <iostream>
 #include <span>
 #include <array>
@@ -43,8 +47,15 @@ bcpp::network::poller::poller
 (
     configuration const & config
 ):
-    fileDescriptor_(::epoll_create1(0))
+    fileDescriptor_(::epoll_create1(0)),
+    wakeFileDescriptor_(::eventfd(0, EFD_NONBLOCK)),
+    dispatchLatencyHistogram_(config.dispatchLatencyInstrumentation_ ? std::make_unique<latency_histogram>() : nullptr)
 {
+    // the wake up event is the only event with no socket
+    ::epoll_event epollEvent{.events = (EPOLLIN | EPOLLET), .data = {.ptr = nullptr}};
+    ::epoll_ctl(fileDescriptor_.get(), EPOLL_CTL_ADD, wakeFileDescriptor_.get(), &epollEvent);
+    if (dispatchLatencyHistogram_)
+        get_tsc_ticks_per_nanosecond(); // calibrate now rather than upon first read
 }
 
 
@@ -60,9 +71,89 @@ bcpp::network::poller::~poller
 //=============================================================================
 void bcpp::network::poller::close
 (
+    // any sockets still awaiting release are released now.  sockets which
+    // are released after close are released immediately.
 )
 {
+    std::lock_guard lockGuard(atomicSpinLock_);
+    {
+        std::lock_guard pendingLockGuard(pendingReleaseLock_);
+        closed_ = true;
+    }
+    release_pending_sockets();
     fileDescriptor_ = {};
+    wakeFileDescriptor_ = {};
+}
+
+
+//=============================================================================
+void bcpp::network::poller::release_socket
+(
+    // unregister the socket and then release its receive contract (which 
+    // continues the socket's asynchronous destruction).  the socket is
+    // unregistered immediately (epoll_ctl does not require the poll lock) but
+    // a poll which is already in progress can still hold an event for it.  so
+    // rather than contend with the polling thread for the poll lock (held for
+    // the duration of each poll, including any wait) the socket is queued and
+    // the polling thread releases all queued sockets in one batch at the start
+    // of its next poll.  the polling thread is woken so that the release is not
+    // delayed by the poll timeout.
+    socket_base_impl & socket
+)
+{
+    {
+        std::lock_guard lockGuard(pendingReleaseLock_);
+        if (!closed_)
+        {
+            ::epoll_ctl(fileDescriptor_.get(), EPOLL_CTL_DEL, socket.get_file_descriptor().get(), nullptr);
+            pendingRelease_.push_back(&socket);
+            if (pendingRelease_.size() == 1)
+            {
+                std::uint64_t wake = 1;
+                [[maybe_unused]] auto _ = ::write(wakeFileDescriptor_.get(), &wake, sizeof(wake));
+            }
+            return;
+        }
+    }
+    socket.receiveContract_.release(); // closing the poller has already removed every registration
+}
+
+
+//=============================================================================
+void bcpp::network::poller::release_pending_sockets
+(
+    // invoked with the poll lock held
+)
+{
+    {
+        std::lock_guard lockGuard(pendingReleaseLock_);
+        if (pendingRelease_.empty())
+            return;
+        std::swap(pendingRelease_, releasing_);
+    }
+    for (auto * socket : releasing_)
+        socket->receiveContract_.release(); // already unregistered by release_socket
+    releasing_.clear();
+}
+
+
+//=============================================================================
+auto bcpp::network::poller::get_dispatch_latency_statistics
+(
+    // returns empty statistics if dispatch latency is not instrumented
+) const -> latency_statistics
+{
+    return (dispatchLatencyHistogram_) ? dispatchLatencyHistogram_->get_statistics() : latency_statistics{};
+}
+
+
+//=============================================================================
+void bcpp::network::poller::reset_dispatch_latency_statistics
+(
+)
+{
+    if (dispatchLatencyHistogram_)
+        dispatchLatencyHistogram_->reset();
 }
 
 
@@ -84,14 +175,26 @@ void bcpp::network::poller::poll
     static thread_local std::array<::epoll_event, 1024> epollEvents;
     
     std::lock_guard lockGuard(atomicSpinLock_);
-    for (auto const & event : std::span(epollEvents.data(), ::epoll_wait(fileDescriptor_.get(), epollEvents.data(), epollEvents.size(), duration.count())))
+    release_pending_sockets();
+    auto numEvents = std::max(::epoll_wait(fileDescriptor_.get(), epollEvents.data(), epollEvents.size(), duration.count()), 0);
+    if (numEvents > 0)
+        NETWORK_TRACE_EVENT(poll_wakeup, 0, numEvents);
+    for (auto const & event : std::span(epollEvents.data(), numEvents))
     {
         auto impl = reinterpret_cast<socket_base_impl *>(event.data.ptr);
-        if (event.events & EPOLLERR)
+        if (impl == nullptr)
         {
-            impl->on_poll_error();
+            // woken to release sockets (at the start of the next poll)
+            std::uint64_t wake;
+            [[maybe_unused]] auto _ = ::read(wakeFileDescriptor_.get(), &wake, sizeof(wake));
             continue;
         }
+        if (impl->closing_.load(std::memory_order_acquire))
+            continue; // destroyed since this poll began
+        // error queue notifications (ex: MSG_ZEROCOPY completions) also raise EPOLLERR
+        // so other events which are reported alongside must not be ignored
+        if (event.events & EPOLLERR)
+            impl->on_poll_error();
 
         if (event.events & EPOLLIN)
             impl->on_polled();
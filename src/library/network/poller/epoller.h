@@ -10,6 +10,7 @@
 #include <include/file_descriptor.h>
 
 #include <library/network/socket/socket.h>
+#include <library/network/instrumentation/latency_histogram.h>
 
 #include <sys/epoll.h>
 
@@ -30,7 +31,12 @@ namespace bcpp::network
     {
     public:
 
-        struct configuration{};
+        struct configuration
+        {
+            // time stamp each socket as it is scheduled by poll and record the delay 
+            // until its receive work executes (see get_dispatch_latency_statistics)
+            bool    dispatchLatencyInstrumentation_{false};
+        };
 
         static std::shared_ptr<poller> create
         (
@@ -49,6 +55,11 @@ namespace bcpp::network
             socket_impl_concept auto &
         );
 
+        void release_socket
+        (
+            socket_base_impl &
+        );
+
         void poll();
 
         void poll
@@ -58,6 +69,10 @@ namespace bcpp::network
         
         void close();
 
+        latency_statistics get_dispatch_latency_statistics() const;
+
+        void reset_dispatch_latency_statistics();
+
     private:
 
         poller
@@ -65,9 +80,25 @@ namespace bcpp::network
             configuration const &
         );
 
-        system::file_descriptor fileDescriptor_;
+        void release_pending_sockets();
+
+        system::file_descriptor             fileDescriptor_;
     
-        atomic_spin_lock        atomicSpinLock_;
+        atomic_spin_lock                    atomicSpinLock_;
+
+        // eventfd which wakes the polling thread when sockets await release
+        system::file_descriptor             wakeFileDescriptor_;
+
+        // sockets awaiting release_pending_sockets (guarded by pendingReleaseLock_)
+        atomic_spin_lock                    pendingReleaseLock_;
+
+        std::vector<socket_base_impl *>     pendingRelease_;
+
+        std::vector<socket_base_impl *>     releasing_;
+
+        bool                                closed_{false};
+
+        std::unique_ptr<latency_histogram>  dispatchLatencyHistogram_;
 
     }; // class poller
 
@@ -88,6 +119,7 @@ inline bool bcpp::network::poller::register_socket
                 .events = (EPOLLIN | EPOLLET),
                 .data = {.ptr = reinterpret_cast<socket_base_impl *>(&socket)}
             };
+    socket.dispatchLatencyHistogram_ = dispatchLatencyHistogram_.get();
     return (::epoll_ctl(fileDescriptor_.get(), EPOLL_CTL_ADD, socket.get_file_descriptor().get(), &epollEvent) == 0);
 }
 
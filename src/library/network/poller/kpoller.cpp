@@ -126,6 +126,20 @@ bool bcpp::network::poller::unregister_socket
 }
 
 
+//=============================================================================
+void bcpp::network::poller::release_socket
+(
+    // unregister the socket and then release its receive contract
+    socket_base_impl & socket
+)
+{
+    struct kevent event;
+    EV_SET(&event, socket.get_file_descriptor().get(), EVFILT_READ, EV_DELETE, 0, 0, nullptr);    
+    kevent(fileDescriptor_.get(), &event, 1, nullptr, 0, nullptr);
+    socket.receiveContract_.release();
+}
+
+
 //=============================================================================
 namespace bcpp::network
 {
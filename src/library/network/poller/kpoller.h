@@ -8,6 +8,7 @@
 #include <include/non_movable.h>
 #include <include/file_descriptor.h>
 #include <library/network/socket/socket.h>
+#include <library/network/instrumentation/latency_histogram.h>
 
 #include <vector>
 #include <memory>
@@ -20,6 +21,8 @@
 namespace bcpp::network
 {
 
+    class socket_base_impl;
+
     class poller :
         public std::enable_shared_from_this<poller>,
         non_copyable,
@@ -29,6 +32,7 @@ namespace bcpp::network
 
         struct configuration
         {
+            bool    dispatchLatencyInstrumentation_{false}; // not supported by kqueue
         };
 
         static std::shared_ptr<poller> create
@@ -50,6 +54,11 @@ namespace bcpp::network
             S &
         );
 
+        void release_socket
+        (
+            socket_base_impl &
+        );
+
         void poll();
 
         void poll
@@ -59,6 +68,10 @@ namespace bcpp::network
         
         void close();
 
+        latency_statistics get_dispatch_latency_statistics() const{return {};}
+
+        void reset_dispatch_latency_statistics(){}
+
     private:
 
         poller
@@ -0,0 +1,276 @@
+#pragma once
+
+#include "./producer_mode.h"
+
+#include <include/bit.h>
+#include <include/non_copyable.h>
+#include <include/non_movable.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    // bounded lock free queue with exactly one consumer and either one producer
+    // or many concurrent producers (selected at construction).
+    // each slot carries a 'turn' which encodes both the lap of the queue and whether
+    // the slot is currently empty (even) or full (odd).  producers therefore never
+    // need to observe the position of the consumer.
+    // ordering is FIFO for any one producer.
+    template <typename T>
+    class fixed_queue final :
+        non_copyable,
+        non_movable
+    {
+    public:
+
+        using value_type = T;
+
+        fixed_queue
+        (
+            std::size_t,
+            producer_mode = producer_mode::single_producer
+        );
+
+        ~fixed_queue();
+
+        template <typename ... Ts>
+        bool emplace
+        (
+            Ts && ...
+        );
+
+        value_type * front();
+
+        value_type * peek
+        (
+            std::size_t
+        );
+
+        std::size_t discard();
+
+        bool empty() const;
+
+        std::size_t size() const;
+
+        std::size_t capacity() const;
+
+        producer_mode get_producer_mode() const;
+
+    private:
+
+        struct slot
+        {
+            std::atomic<std::uint64_t>  turn_{0};
+            alignas(T) std::byte        storage_[sizeof(T)];
+
+            T * get(){return std::launder(reinterpret_cast<T *>(storage_));}
+        };
+
+        std::uint64_t get_turn
+        (
+            std::uint64_t
+        ) const;
+
+        std::unique_ptr<slot []>                    slots_;
+
+        std::uint64_t                               capacityMask_{0};
+
+        std::uint64_t                               capacityShift_{0};
+
+        producer_mode                               producerMode_;
+
+        alignas(64) std::atomic<std::uint64_t>      head_{0};
+
+        alignas(64) std::atomic<std::uint64_t>      tail_{0};
+
+    }; // class fixed_queue
+
+} // namespace bcpp::network
+
+
+//=============================================================================
+template <typename T>
+inline bcpp::network::fixed_queue<T>::fixed_queue
+(
+    std::size_t capacity,
+    producer_mode producerMode
+):
+    producerMode_(producerMode)
+{
+    capacity = minimum_power_of_two(std::max(capacity, std::size_t(2)));
+    capacityMask_ = (capacity - 1);
+    capacityShift_ = std::countr_zero(capacity);
+    slots_ = std::make_unique<slot []>(capacity);
+}
+
+
+//=============================================================================
+template <typename T>
+inline bcpp::network::fixed_queue<T>::~fixed_queue
+(
+)
+{
+    while (front() != nullptr)
+        discard();
+}
+
+
+//=============================================================================
+template <typename T>
+inline std::uint64_t bcpp::network::fixed_queue<T>::get_turn
+(
+    std::uint64_t position
+) const
+{
+    return (position >> capacityShift_);
+}
+
+
+//=============================================================================
+template <typename T>
+template <typename ... Ts>
+inline bool bcpp::network::fixed_queue<T>::emplace
+(
+    Ts && ... args
+)
+{
+    if (producerMode_ == producer_mode::single_producer)
+    {
+        // no other producer can claim the slot so no RMW is required
+        auto head = head_.load(std::memory_order_relaxed);
+        auto & s = slots_[head & capacityMask_];
+        if (s.turn_.load(std::memory_order_acquire) != (get_turn(head) * 2))
+            return false; // full
+        new (s.storage_) T(std::forward<Ts>(args) ...);
+        s.turn_.store((get_turn(head) * 2) + 1, std::memory_order_release);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    auto head = head_.load(std::memory_order_acquire);
+    while (true)
+    {
+        auto & s = slots_[head & capacityMask_];
+        if (s.turn_.load(std::memory_order_acquire) == (get_turn(head) * 2))
+        {
+            // slot is empty for this lap. try to claim it.
+            if (head_.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                new (s.storage_) T(std::forward<Ts>(args) ...);
+                s.turn_.store((get_turn(head) * 2) + 1, std::memory_order_release);
+                return true;
+            }
+            // lost the race (head was reloaded by the failed exchange) so try again
+        }
+        else
+        {
+            // slot is still occupied from the previous lap.  unless another producer
+            // has moved head in the meantime the queue is full.
+            auto previousHead = head;
+            head = head_.load(std::memory_order_acquire);
+            if (head == previousHead)
+                return false;
+        }
+    }
+}
+
+
+//=============================================================================
+template <typename T>
+inline auto bcpp::network::fixed_queue<T>::front
+(
+    // returns the next element or nullptr if the next element has not yet been
+    // published (queue is empty or a producer is mid way through emplace)
+) -> value_type *
+{
+    return peek(0);
+}
+
+
+//=============================================================================
+template <typename T>
+inline auto bcpp::network::fixed_queue<T>::peek
+(
+    // returns the element which is 'offset' elements behind the front of the queue
+    // or nullptr if that element has not been published.  consumer only.
+    std::size_t offset
+) -> value_type *
+{
+    if (offset > capacityMask_)
+        return nullptr;
+    auto position = (tail_.load(std::memory_order_relaxed) + offset);
+    auto & s = slots_[position & capacityMask_];
+    if (s.turn_.load(std::memory_order_acquire) != ((get_turn(position) * 2) + 1))
+        return nullptr;
+    return s.get();
+}
+
+
+//=============================================================================
+template <typename T>
+inline std::size_t bcpp::network::fixed_queue<T>::discard
+(
+    // pop the front element.  consumer only and front() must be valid.
+    // returns the number of elements which remain in the queue (including any
+    // which have been claimed by producers but not yet published)
+)
+{
+    auto tail = tail_.load(std::memory_order_relaxed);
+    auto & s = slots_[tail & capacityMask_];
+    s.get()->~T();
+    s.turn_.store((get_turn(tail) + 1) * 2, std::memory_order_release);
+    tail_.store(++tail, std::memory_order_relaxed);
+    return (head_.load(std::memory_order_acquire) - tail);
+}
+
+
+//=============================================================================
+template <typename T>
+inline bool bcpp::network::fixed_queue<T>::empty
+(
+) const
+{
+    return (size() == 0);
+}
+
+
+//=============================================================================
+template <typename T>
+inline std::size_t bcpp::network::fixed_queue<T>::size
+(
+) const
+{
+    auto tail = tail_.load(std::memory_order_relaxed);
+    auto head = head_.load(std::memory_order_acquire);
+    return (head > tail) ? (head - tail) : 0;
+}
+
+
+//=============================================================================
+template <typename T>
+inline std::size_t bcpp::network::fixed_queue<T>::capacity
+(
+) const
+{
+    return (capacityMask_ + 1);
+}
+
+
+//=============================================================================
+template <typename T>
+inline auto bcpp::network::fixed_queue<T>::get_producer_mode
+(
+) const -> producer_mode
+{
+    return producerMode_;
+}
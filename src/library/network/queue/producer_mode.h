@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    // the number of threads which may concurrently push to a queue
+    enum class producer_mode : std::uint32_t
+    {
+        undefined           = 0,
+        single_producer     = 1,
+        multi_producer      = 2
+    };
+
+} // namespace bcpp::network
@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    // the role of a shared memory socket.  the receiving socket creates (and owns)
+    // the ring.  sending sockets attach to an existing ring by name.
+    enum class shared_memory_mode : std::uint32_t
+    {
+        undefined       = 0,
+        receive         = 1,
+        send            = 2
+    };
+
+} // namespace bcpp::network
@@ -0,0 +1,171 @@
+#include "./shared_memory_ring.h"
+
+#include <include/bit.h>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <bit>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+
+//=============================================================================
+bcpp::network::shared_memory_ring::shared_memory_ring
+(
+    std::string name,
+    void * address,
+    std::size_t mappingSize,
+    bool isOwner
+):
+    name_(std::move(name)),
+    header_(reinterpret_cast<header *>(address)),
+    mappingSize_(mappingSize),
+    isOwner_(isOwner)
+{
+}
+
+
+//=============================================================================
+bcpp::network::shared_memory_ring::shared_memory_ring
+(
+    shared_memory_ring && other
+):
+    name_(std::move(other.name_)),
+    header_(std::exchange(other.header_, nullptr)),
+    mappingSize_(std::exchange(other.mappingSize_, 0)),
+    isOwner_(std::exchange(other.isOwner_, false))
+{
+}
+
+
+//=============================================================================
+auto bcpp::network::shared_memory_ring::operator =
+(
+    shared_memory_ring && other
+) -> shared_memory_ring &
+{
+    if (&other != this)
+    {
+        this->~shared_memory_ring();
+        name_ = std::move(other.name_);
+        header_ = std::exchange(other.header_, nullptr);
+        mappingSize_ = std::exchange(other.mappingSize_, 0);
+        isOwner_ = std::exchange(other.isOwner_, false);
+    }
+    return *this;
+}
+
+
+//=============================================================================
+bcpp::network::shared_memory_ring::~shared_memory_ring
+(
+    // the owner removes the name.  processes which are still attached keep
+    // their mapping until they detach.
+)
+{
+    if (header_ != nullptr)
+    {
+        ::munmap(header_, mappingSize_);
+        header_ = nullptr;
+        if (isOwner_)
+            ::shm_unlink(name_.c_str());
+    }
+    isOwner_ = false;
+}
+
+
+//=============================================================================
+auto bcpp::network::shared_memory_ring::create
+(
+    // create the named ring.  any stale ring of the same name is replaced.
+    std::string const & name,
+    configuration const & config
+) -> shared_memory_ring
+{
+    auto capacity = minimum_power_of_two(std::max(config.capacity_, std::size_t(2)));
+    auto slotStride = (((sizeof(slot) + std::max(config.slotSize_, std::size_t(1))) + (cache_line_size - 1)) & ~std::size_t(cache_line_size - 1));
+    auto mappingSize = (sizeof(header) + (capacity * slotStride));
+
+    ::shm_unlink(name.c_str());
+    auto fileDescriptor = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fileDescriptor == -1)
+        throw std::runtime_error("shm_open failure");
+    if (::ftruncate(fileDescriptor, mappingSize) == -1)
+    {
+        ::close(fileDescriptor);
+        ::shm_unlink(name.c_str());
+        throw std::runtime_error("ftruncate failure");
+    }
+    auto address = ::mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fileDescriptor, 0);
+    ::close(fileDescriptor);
+    if (address == MAP_FAILED)
+    {
+        ::shm_unlink(name.c_str());
+        throw std::runtime_error("mmap failure");
+    }
+
+    // ftruncate zero fills so every slot starts empty for lap zero
+    auto ringHeader = new (address) header;
+    ringHeader->capacity_ = capacity;
+    ringHeader->capacityShift_ = std::countr_zero(capacity);
+    ringHeader->slotSize_ = (slotStride - sizeof(slot));
+    ringHeader->slotStride_ = slotStride;
+    ringHeader->producerMode_ = config.producerMode_;
+    ringHeader->magic_.store(magic, std::memory_order_release); // publish to attaching processes
+    return shared_memory_ring(name, address, mappingSize, true);
+}
+
+
+//=============================================================================
+auto bcpp::network::shared_memory_ring::attach
+(
+    // attach to an existing ring as a producer
+    std::string const & name
+) -> shared_memory_ring
+{
+    auto fileDescriptor = ::shm_open(name.c_str(), O_RDWR, 0);
+    if (fileDescriptor == -1)
+        throw std::runtime_error("shm_open failure");
+    struct ::stat status;
+    if ((::fstat(fileDescriptor, &status) == -1) || (static_cast<std::size_t>(status.st_size) < sizeof(header)))
+    {
+        ::close(fileDescriptor);
+        throw std::runtime_error("invalid shared memory ring");
+    }
+    auto mappingSize = static_cast<std::size_t>(status.st_size);
+    auto address = ::mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    ::close(fileDescriptor);
+    if (address == MAP_FAILED)
+        throw std::runtime_error("mmap failure");
+
+    auto ringHeader = reinterpret_cast<header *>(address);
+    if ((ringHeader->magic_.load(std::memory_order_acquire) != magic) ||
+            (mappingSize < (sizeof(header) + (ringHeader->capacity_ * ringHeader->slotStride_))))
+    {
+        ::munmap(address, mappingSize);
+        throw std::runtime_error("invalid shared memory ring");
+    }
+    return shared_memory_ring(name, address, mappingSize, false);
+}
+
+
+//=============================================================================
+std::size_t bcpp::network::shared_memory_ring::get_slot_size
+(
+) const
+{
+    return (header_ != nullptr) ? header_->slotSize_ : 0;
+}
+
+
+//=============================================================================
+bool bcpp::network::shared_memory_ring::is_valid
+(
+) const
+{
+    return (header_ != nullptr);
+}
@@ -0,0 +1,282 @@
+#pragma once
+
+#include <library/network/queue/producer_mode.h>
+
+#include <include/non_copyable.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <algorithm>
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    // bounded lock free ring of fixed size slots which lives in a named posix
+    // shared memory object so that it can be shared by several processes.  one
+    // process creates (and owns) the ring and consumes from it.  any number of
+    // processes attach to the ring by name and produce into it.
+    // the slot protocol is that of fixed_queue: each slot carries a 'turn' which
+    // encodes the lap of the ring and whether the slot is empty (even) or full (odd).
+    // the consumer reads messages in place and only releases the slot once it is
+    // done with the message so no copy is made on the receive side.
+    // the consumer can request a wake up before it stops polling the ring.  the
+    // next producer to publish consumes the request (see take_wake_up_request)
+    // and is responsible for signalling the consumer by some other means.
+    class shared_memory_ring :
+        non_copyable
+    {
+    public:
+
+        static auto constexpr default_capacity = (1 << 12);
+        static auto constexpr default_slot_size = ((1 << 10) * 2);
+
+        struct configuration
+        {
+            std::size_t     capacity_{default_capacity};    // number of slots (rounded up to a power of two)
+            std::size_t     slotSize_{default_slot_size};   // largest message
+            producer_mode   producerMode_{producer_mode::single_producer};
+        };
+
+        shared_memory_ring() = default;
+
+        shared_memory_ring
+        (
+            shared_memory_ring &&
+        );
+
+        shared_memory_ring & operator =
+        (
+            shared_memory_ring &&
+        );
+
+        ~shared_memory_ring();
+
+        static shared_memory_ring create
+        (
+            std::string const &,
+            configuration const &
+        );
+
+        static shared_memory_ring attach
+        (
+            std::string const &
+        );
+
+        bool push
+        (
+            std::span<char const>
+        );
+
+        std::span<char> front();
+
+        void discard();
+
+        bool empty() const;
+
+        bool request_wake_up();
+
+        bool take_wake_up_request();
+
+        std::size_t get_slot_size() const;
+
+        bool is_valid() const;
+
+    private:
+
+        static std::uint64_t constexpr magic = 0x62637070726e6731; // "bcpprng1"
+        static auto constexpr cache_line_size = 64;
+
+        struct alignas(cache_line_size) header
+        {
+            std::atomic<std::uint64_t>                      magic_{0};
+            std::uint64_t                                   capacity_{0};
+            std::uint64_t                                   capacityShift_{0};
+            std::uint64_t                                   slotSize_{0};
+            std::uint64_t                                   slotStride_{0};
+            producer_mode                                   producerMode_{producer_mode::single_producer};
+            alignas(cache_line_size) std::atomic<std::uint64_t>   head_{0};
+            alignas(cache_line_size) std::atomic<std::uint64_t>   tail_{0};
+            alignas(cache_line_size) std::atomic<std::uint32_t>   wakeUpRequested_{0};
+        };
+
+        struct slot
+        {
+            std::atomic<std::uint64_t>  turn_{0};
+            std::uint64_t               size_{0};
+            char *                      data(){return reinterpret_cast<char *>(this + 1);}
+        };
+
+        static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "shared memory atomics must be address free");
+
+        shared_memory_ring
+        (
+            std::string,
+            void *,
+            std::size_t,
+            bool
+        );
+
+        slot & get_slot
+        (
+            std::uint64_t
+        ) const;
+
+        std::uint64_t get_turn
+        (
+            std::uint64_t
+        ) const;
+
+        std::string     name_;
+
+        header *        header_{nullptr};
+
+        std::size_t     mappingSize_{0};
+
+        bool            isOwner_{false};
+
+    }; // class shared_memory_ring
+
+} // namespace bcpp::network
+
+
+//=============================================================================
+inline auto bcpp::network::shared_memory_ring::get_slot
+(
+    std::uint64_t position
+) const -> slot &
+{
+    auto index = (position & (header_->capacity_ - 1));
+    return *reinterpret_cast<slot *>(reinterpret_cast<char *>(header_ + 1) + (index * header_->slotStride_));
+}
+
+
+//=============================================================================
+inline std::uint64_t bcpp::network::shared_memory_ring::get_turn
+(
+    std::uint64_t position
+) const
+{
+    return (position >> header_->capacityShift_);
+}
+
+
+//=============================================================================
+inline bool bcpp::network::shared_memory_ring::push
+(
+    // copy the message into the next free slot.  returns false if the ring is
+    // full or if the message is larger than a slot.
+    std::span<char const> message
+)
+{
+    if (message.size() > header_->slotSize_)
+        return false;
+
+    if (header_->producerMode_ == producer_mode::single_producer)
+    {
+        auto head = header_->head_.load(std::memory_order_relaxed);
+        auto & s = get_slot(head);
+        if (s.turn_.load(std::memory_order_acquire) != (get_turn(head) * 2))
+            return false; // full
+        std::copy_n(message.data(), message.size(), s.data());
+        s.size_ = message.size();
+        s.turn_.store((get_turn(head) * 2) + 1, std::memory_order_release);
+        header_->head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    auto head = header_->head_.load(std::memory_order_acquire);
+    while (true)
+    {
+        auto & s = get_slot(head);
+        if (s.turn_.load(std::memory_order_acquire) == (get_turn(head) * 2))
+        {
+            if (header_->head_.compare_exchange_weak(head, head + 1, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                std::copy_n(message.data(), message.size(), s.data());
+                s.size_ = message.size();
+                s.turn_.store((get_turn(head) * 2) + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else
+        {
+            auto previousHead = head;
+            head = header_->head_.load(std::memory_order_acquire);
+            if (head == previousHead)
+                return false; // full
+        }
+    }
+}
+
+
+//=============================================================================
+inline auto bcpp::network::shared_memory_ring::front
+(
+    // the next message, in place, or an empty span if no message has been
+    // published.  consumer only.  valid until discard.
+) -> std::span<char>
+{
+    auto tail = header_->tail_.load(std::memory_order_relaxed);
+    auto & s = get_slot(tail);
+    if (s.turn_.load(std::memory_order_acquire) != ((get_turn(tail) * 2) + 1))
+        return {};
+    return {s.data(), s.size_};
+}
+
+
+//=============================================================================
+inline void bcpp::network::shared_memory_ring::discard
+(
+    // release the front slot back to the producers.  consumer only.
+)
+{
+    auto tail = header_->tail_.load(std::memory_order_relaxed);
+    get_slot(tail).turn_.store((get_turn(tail) + 1) * 2, std::memory_order_release);
+    header_->tail_.store(tail + 1, std::memory_order_relaxed);
+}
+
+
+//=============================================================================
+inline bool bcpp::network::shared_memory_ring::empty
+(
+) const
+{
+    auto tail = header_->tail_.load(std::memory_order_relaxed);
+    return (get_slot(tail).turn_.load(std::memory_order_acquire) != ((get_turn(tail) * 2) + 1));
+}
+
+
+//=============================================================================
+inline bool bcpp::network::shared_memory_ring::request_wake_up
+(
+    // consumer only.  returns false if a message was published in the meantime in
+    // which case the request is withdrawn and the consumer should keep polling.
+)
+{
+    header_->wakeUpRequested_.store(1, std::memory_order_seq_cst);
+    // pairs with the fence in take_wake_up_request.  without it the (acquire)
+    // load of the slot's turn in empty could be ordered before the store of the 
+    // request and both sides could miss the other (a lost wake up).
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (empty())
+        return true;
+    header_->wakeUpRequested_.store(0, std::memory_order_relaxed);
+    return false;
+}
+
+
+//=============================================================================
+inline bool bcpp::network::shared_memory_ring::take_wake_up_request
+(
+    // producer only (after push).  returns true for exactly one producer per request.
+)
+{
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return ((header_->wakeUpRequested_.load(std::memory_order_relaxed) != 0) &&
+            (header_->wakeUpRequested_.exchange(0, std::memory_order_acq_rel) != 0));
+}
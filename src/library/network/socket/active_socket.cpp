@@ -11,7 +11,8 @@ bcpp::network::active_socket<P>::socket
     event_handlers const & eventHandlers,
     work_contract_group & sendWorkContractGroup,
     work_contract_group & receiveWorkContractGroup,
-    std::shared_ptr<poller> & p
+    std::shared_ptr<poller> & p,
+    std::shared_ptr<timer_wheel> const & timerWheel
 ) requires (udp_concept<P>) 
 try
 {
@@ -21,7 +22,23 @@ try
                 .socketReceiveBufferSize_ = config.socketReceiveBufferSize_,
                 .socketSendBufferSize_ = config.socketSendBufferSize_,
                 .readBufferSize_ = config.readBufferSize_,
-                .ioMode_ = config.ioMode_
+                .sendQueueSize_ = config.sendQueueSize_,
+                .sendQueueProducerMode_ = config.sendQueueProducerMode_,
+                .sendQueueHighWatermarkBytes_ = config.sendQueueHighWatermarkBytes_,
+                .sendQueueLowWatermarkBytes_ = config.sendQueueLowWatermarkBytes_,
+                .sendQueueHighWatermarkPackets_ = config.sendQueueHighWatermarkPackets_,
+                .sendQueueLowWatermarkPackets_ = config.sendQueueLowWatermarkPackets_,
+                .ioMode_ = config.ioMode_,
+                .reusePort_ = config.reusePort_,
+                .sendCoalescingSize_ = config.sendCoalescingSize_,
+                .sendCoalescingDelay_ = config.sendCoalescingDelay_,
+                .idleTimeout_ = config.idleTimeout_,
+                .heartbeatInterval_ = config.heartbeatInterval_,
+                .zeroCopyThreshold_ = config.zeroCopyThreshold_,
+                .multicastInterface_ = config.multicastInterface_,
+                .multicastLoop_ = config.multicastLoop_,
+                .sendSegmentSize_ = config.sendSegmentSize_,
+                .packetCapture_ = config.packetCapture_
             },
             {
                 eventHandlers.closeHandler_,
@@ -30,9 +47,16 @@ try
                 eventHandlers.receiveErrorHandler_,
                 eventHandlers.packetAllocationHandler_,
                 eventHandlers.hangUpHandler_,
-                eventHandlers.peerHangUpHandler_
+                eventHandlers.peerHangUpHandler_,
+                eventHandlers.sendQueueHighHandler_,
+                eventHandlers.sendQueueDrainedHandler_,
+                eventHandlers.sendErrorHandler_,
+                eventHandlers.idleTimeoutHandler_,
+                eventHandlers.heartbeatHandler_,
+                eventHandlers.multicastReceiveHandler_,
+                eventHandlers.segmentedReceiveHandler_
             },
-            sendWorkContractGroup, receiveWorkContractGroup, p), 
+            sendWorkContractGroup, receiveWorkContractGroup, p, timerWheel), 
             [](auto * impl){impl->destroy();}));
 }
 catch (std::exception const & exception)
@@ -51,7 +75,8 @@ bcpp::network::active_socket<P>::socket
     event_handlers const & eventHandlers,
     work_contract_group & sendWorkContractGroup,
     work_contract_group & receiveWorkContractGroup,
-    std::shared_ptr<poller> & p
+    std::shared_ptr<poller> & p,
+    std::shared_ptr<timer_wheel> const & timerWheel
 ) requires (tcp_concept<P>)
 try 
 {
@@ -61,7 +86,23 @@ try
                 .socketReceiveBufferSize_ = config.socketReceiveBufferSize_,
                 .socketSendBufferSize_ = config.socketSendBufferSize_,
                 .readBufferSize_ = config.readBufferSize_,
-                .ioMode_ = config.ioMode_
+                .sendQueueSize_ = config.sendQueueSize_,
+                .sendQueueProducerMode_ = config.sendQueueProducerMode_,
+                .sendQueueHighWatermarkBytes_ = config.sendQueueHighWatermarkBytes_,
+                .sendQueueLowWatermarkBytes_ = config.sendQueueLowWatermarkBytes_,
+                .sendQueueHighWatermarkPackets_ = config.sendQueueHighWatermarkPackets_,
+                .sendQueueLowWatermarkPackets_ = config.sendQueueLowWatermarkPackets_,
+                .ioMode_ = config.ioMode_,
+                .reusePort_ = config.reusePort_,
+                .sendCoalescingSize_ = config.sendCoalescingSize_,
+                .sendCoalescingDelay_ = config.sendCoalescingDelay_,
+                .idleTimeout_ = config.idleTimeout_,
+                .heartbeatInterval_ = config.heartbeatInterval_,
+                .zeroCopyThreshold_ = config.zeroCopyThreshold_,
+                .multicastInterface_ = config.multicastInterface_,
+                .multicastLoop_ = config.multicastLoop_,
+                .sendSegmentSize_ = config.sendSegmentSize_,
+                .packetCapture_ = config.packetCapture_
             },
             {
                 eventHandlers.closeHandler_,
@@ -70,9 +111,16 @@ try
                 eventHandlers.receiveErrorHandler_,
                 eventHandlers.packetAllocationHandler_,
                 eventHandlers.hangUpHandler_,
-                eventHandlers.peerHangUpHandler_
+                eventHandlers.peerHangUpHandler_,
+                eventHandlers.sendQueueHighHandler_,
+                eventHandlers.sendQueueDrainedHandler_,
+                eventHandlers.sendErrorHandler_,
+                eventHandlers.idleTimeoutHandler_,
+                eventHandlers.heartbeatHandler_,
+                eventHandlers.multicastReceiveHandler_,
+                eventHandlers.segmentedReceiveHandler_
             },
-            sendWorkContractGroup, receiveWorkContractGroup, p), 
+            sendWorkContractGroup, receiveWorkContractGroup, p, timerWheel), 
             [](auto * impl){impl->destroy();}));
 }
 catch (std::exception const & exception)
@@ -91,8 +139,9 @@ bcpp::network::active_socket<P>::socket
     event_handlers const & eventHandlers,
     work_contract_group & sendWorkContractGroup,
     work_contract_group & recevieWorkContractGroup,
-    std::shared_ptr<poller> & p
-) requires (tcp_concept<P>)
+    std::shared_ptr<poller> & p,
+    std::shared_ptr<timer_wheel> const & timerWheel
+) requires (connection_concept<P>)
 try 
 {
     impl_ = std::move(decltype(impl_)(new impl_type(
@@ -101,7 +150,87 @@ try
                 .socketReceiveBufferSize_ = config.socketReceiveBufferSize_,
                 .socketSendBufferSize_ = config.socketSendBufferSize_,
                 .readBufferSize_ = config.readBufferSize_,
-                .ioMode_ = config.ioMode_
+                .sendQueueSize_ = config.sendQueueSize_,
+                .sendQueueProducerMode_ = config.sendQueueProducerMode_,
+                .sendQueueHighWatermarkBytes_ = config.sendQueueHighWatermarkBytes_,
+                .sendQueueLowWatermarkBytes_ = config.sendQueueLowWatermarkBytes_,
+                .sendQueueHighWatermarkPackets_ = config.sendQueueHighWatermarkPackets_,
+                .sendQueueLowWatermarkPackets_ = config.sendQueueLowWatermarkPackets_,
+                .ioMode_ = config.ioMode_,
+                .reusePort_ = config.reusePort_,
+                .sendCoalescingSize_ = config.sendCoalescingSize_,
+                .sendCoalescingDelay_ = config.sendCoalescingDelay_,
+                .idleTimeout_ = config.idleTimeout_,
+                .heartbeatInterval_ = config.heartbeatInterval_,
+                .zeroCopyThreshold_ = config.zeroCopyThreshold_,
+                .multicastInterface_ = config.multicastInterface_,
+                .multicastLoop_ = config.multicastLoop_,
+                .sendSegmentSize_ = config.sendSegmentSize_,
+                .packetCapture_ = config.packetCapture_
+            },
+            {
+                eventHandlers.closeHandler_,
+                eventHandlers.pollErrorHandler_,
+                eventHandlers.receiveHandler_,
+                eventHandlers.receiveErrorHandler_,
+                eventHandlers.packetAllocationHandler_,
+                eventHandlers.hangUpHandler_,
+                eventHandlers.peerHangUpHandler_,
+                eventHandlers.sendQueueHighHandler_,
+                eventHandlers.sendQueueDrainedHandler_,
+                eventHandlers.sendErrorHandler_,
+                eventHandlers.idleTimeoutHandler_,
+                eventHandlers.heartbeatHandler_,
+                eventHandlers.multicastReceiveHandler_,
+                eventHandlers.segmentedReceiveHandler_
+            },
+            sendWorkContractGroup, recevieWorkContractGroup, p, timerWheel), 
+            [](auto * impl){impl->destroy();}));
+}
+catch (std::exception const & exception)
+{
+    std::cerr << "active_socket ctor failure.  reason: " << exception.what() << "\n";
+    impl_.reset();
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+bcpp::network::active_socket<P>::socket
+(
+    unix_socket_path peerSocketPath,
+    configuration const & config,
+    event_handlers const & eventHandlers,
+    work_contract_group & sendWorkContractGroup,
+    work_contract_group & receiveWorkContractGroup,
+    std::shared_ptr<poller> & p,
+    std::shared_ptr<timer_wheel> const & timerWheel
+) requires (unix_concept<P>)
+try 
+{
+    impl_ = std::move(decltype(impl_)(new impl_type(
+            peerSocketPath, 
+            {
+                .socketReceiveBufferSize_ = config.socketReceiveBufferSize_,
+                .socketSendBufferSize_ = config.socketSendBufferSize_,
+                .readBufferSize_ = config.readBufferSize_,
+                .sendQueueSize_ = config.sendQueueSize_,
+                .sendQueueProducerMode_ = config.sendQueueProducerMode_,
+                .sendQueueHighWatermarkBytes_ = config.sendQueueHighWatermarkBytes_,
+                .sendQueueLowWatermarkBytes_ = config.sendQueueLowWatermarkBytes_,
+                .sendQueueHighWatermarkPackets_ = config.sendQueueHighWatermarkPackets_,
+                .sendQueueLowWatermarkPackets_ = config.sendQueueLowWatermarkPackets_,
+                .ioMode_ = config.ioMode_,
+                .reusePort_ = config.reusePort_,
+                .sendCoalescingSize_ = config.sendCoalescingSize_,
+                .sendCoalescingDelay_ = config.sendCoalescingDelay_,
+                .idleTimeout_ = config.idleTimeout_,
+                .heartbeatInterval_ = config.heartbeatInterval_,
+                .zeroCopyThreshold_ = config.zeroCopyThreshold_,
+                .multicastInterface_ = config.multicastInterface_,
+                .multicastLoop_ = config.multicastLoop_,
+                .sendSegmentSize_ = config.sendSegmentSize_,
+                .packetCapture_ = config.packetCapture_
             },
             {
                 eventHandlers.closeHandler_,
@@ -110,9 +239,16 @@ try
                 eventHandlers.receiveErrorHandler_,
                 eventHandlers.packetAllocationHandler_,
                 eventHandlers.hangUpHandler_,
-                eventHandlers.peerHangUpHandler_
+                eventHandlers.peerHangUpHandler_,
+                eventHandlers.sendQueueHighHandler_,
+                eventHandlers.sendQueueDrainedHandler_,
+                eventHandlers.sendErrorHandler_,
+                eventHandlers.idleTimeoutHandler_,
+                eventHandlers.heartbeatHandler_,
+                eventHandlers.multicastReceiveHandler_,
+                eventHandlers.segmentedReceiveHandler_
             },
-            sendWorkContractGroup, recevieWorkContractGroup, p), 
+            sendWorkContractGroup, receiveWorkContractGroup, p, timerWheel), 
             [](auto * impl){impl->destroy();}));
 }
 catch (std::exception const & exception)
@@ -127,7 +263,7 @@ template <bcpp::network::network_transport_protocol P>
 auto bcpp::network::active_socket<P>::connect_to
 (
     socket_address destination
-) noexcept -> connect_result
+) noexcept -> connect_result requires (!unix_concept<P>)
 {
     return (impl_) ? impl_->connect_to(destination) : connect_result::connect_error;
 }
@@ -145,6 +281,44 @@ requires (udp_concept<P>)
 }
 
 
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+auto bcpp::network::active_socket<P>::join
+(
+    ip_address group,
+    ip_address source
+) -> connect_result 
+requires (udp_concept<P>)
+{
+    return (impl_) ? impl_->join(group, source) : connect_result::connect_error;
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+bool bcpp::network::active_socket<P>::leave
+(
+    ip_address group
+)
+requires (udp_concept<P>)
+{
+    return (impl_) ? impl_->leave(group) : false;
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+bool bcpp::network::active_socket<P>::leave
+(
+    ip_address group,
+    ip_address source
+)
+requires (udp_concept<P>)
+{
+    return (impl_) ? impl_->leave(group, source) : false;
+}
+
+
 //=============================================================================
 template <bcpp::network::network_transport_protocol P>
 bool bcpp::network::active_socket<P>::send
@@ -195,6 +369,24 @@ requires (udp_concept<P>)
 }
 
 
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+bool bcpp::network::active_socket<P>::send_file
+(
+    // send length bytes of the file, starting at offset, without copying the 
+    // file's contents through user space.  the caller retains ownership of the
+    // file descriptor which must remain open until the completion token fires.
+    std::int32_t fileDescriptor,
+    std::uint64_t offset,
+    std::size_t length,
+    send_completion_token sendCompletionToken
+)
+requires (stream_concept<P>)
+{
+    return (impl_) ? impl_->send_file(fileDescriptor, offset, length, sendCompletionToken) : false;
+}
+
+
 //=============================================================================
 template <bcpp::network::network_transport_protocol P>
 bool bcpp::network::active_socket<P>::close
@@ -346,4 +538,6 @@ namespace bcpp::network
 {
     template class socket<tcp_socket_traits>;
     template class socket<udp_socket_traits>;
+    template class socket<unix_stream_socket_traits>;
+    template class socket<unix_seqpacket_socket_traits>;
 }
@@ -4,12 +4,16 @@
 #include "./send_completion_token.h"
 #include "./traits/traits.h"
 #include "./connect_result.h"
+#include "./unix_socket_path.h"
 
 #include <library/system.h>
 #include <library/work_contract.h>
 #include <library/network/poller/poller.h>
 #include <library/network/ip/socket_address.h>
 #include <library/network/packet/packet.h>
+#include <library/network/queue/producer_mode.h>
+#include <library/network/timer/timer_wheel.h>
+#include <library/network/capture/packet_capture.h>
 
 #include <include/file_descriptor.h>
 #include <include/io_mode.h>
@@ -21,6 +25,7 @@
 #include <tuple>
 #include <cstdint>
 #include <optional>
+#include <chrono>
 
 
 namespace bcpp::network
@@ -43,6 +48,13 @@ namespace bcpp::network
             using receive_handler = std::function<void(socket_id, packet, socket_address)>;
             using receive_error_handler = std::function<void(socket_id, std::int32_t)>;
             using packet_allocation_handler = std::function<packet(socket_id, std::size_t)>;
+            using send_queue_high_handler = std::function<void(socket_id)>;
+            using send_queue_drained_handler = std::function<void(socket_id)>;
+            using send_error_handler = std::function<void(socket_id, std::int32_t)>;
+            using idle_timeout_handler = std::function<void(socket_id)>;
+            using heartbeat_handler = std::function<void(socket_id)>;
+            using multicast_receive_handler = std::function<void(socket_id, packet, socket_address, ip_address)>;
+            using segmented_receive_handler = std::function<void(socket_id, packet, socket_address, std::size_t)>;
 
             close_handler               closeHandler_;
             poll_error_handler          pollErrorHandler_;
@@ -51,6 +63,13 @@ namespace bcpp::network
             packet_allocation_handler   packetAllocationHandler_;
             hang_up_handler             hangUpHandler_;
             peer_hang_up_handler        peerHangUpHandler_;
+            send_queue_high_handler     sendQueueHighHandler_;
+            send_queue_drained_handler  sendQueueDrainedHandler_;
+            send_error_handler          sendErrorHandler_;
+            idle_timeout_handler        idleTimeoutHandler_;
+            heartbeat_handler           heartbeatHandler_;
+            multicast_receive_handler   multicastReceiveHandler_;
+            segmented_receive_handler   segmentedReceiveHandler_;
         };
 
         struct configuration
@@ -59,7 +78,28 @@ namespace bcpp::network
             std::size_t socketSendBufferSize_{0};
             std::size_t readBufferSize_{0};
             std::size_t sendQueueSize_{0};
+            producer_mode sendQueueProducerMode_{producer_mode::single_producer};
+            std::size_t sendQueueHighWatermarkBytes_{0};
+            std::size_t sendQueueLowWatermarkBytes_{0};
+            std::size_t sendQueueHighWatermarkPackets_{0};
+            std::size_t sendQueueLowWatermarkPackets_{0};
             system::io_mode ioMode_{system::io_mode::read_write};
+            bool reusePort_{false}; // SO_REUSEPORT (see udp_socket_group)
+
+            // tcp specific (other than zero copy these also apply to unix domain sockets)
+            std::size_t sendCoalescingSize_{0};
+            std::chrono::nanoseconds sendCoalescingDelay_{0};
+            std::chrono::nanoseconds idleTimeout_{0};
+            std::chrono::nanoseconds heartbeatInterval_{0};
+            std::size_t zeroCopyThreshold_{0}; // send packets of at least this size with MSG_ZEROCOPY (0 = disabled).  ignored if coalescing
+
+            // udp specific
+            ip_address multicastInterface_{}; // defaults to the address of the virtual network interface
+            bool multicastLoop_{true};
+            std::uint16_t sendSegmentSize_{0}; // UDP_SEGMENT (generic segmentation offload).  0 = disabled
+
+            // tcp and udp only
+            std::shared_ptr<packet_capture> packetCapture_{}; // copy sent and received packets to a pcap file.  null = disabled
         };
 
         socket(socket const &) = delete;
@@ -76,7 +116,8 @@ namespace bcpp::network
             event_handlers const &,
             work_contract_group &,
             work_contract_group &,
-            std::shared_ptr<poller> &
+            std::shared_ptr<poller> &,
+            std::shared_ptr<timer_wheel> const &
         ) requires (udp_concept<P>);
 
         socket
@@ -86,7 +127,8 @@ namespace bcpp::network
             event_handlers const &,
             work_contract_group &,
             work_contract_group &,
-            std::shared_ptr<poller> &
+            std::shared_ptr<poller> &,
+            std::shared_ptr<timer_wheel> const &
         ) requires (tcp_concept<P>);
 
         socket
@@ -96,8 +138,20 @@ namespace bcpp::network
             event_handlers const &,
             work_contract_group &,
             work_contract_group &,
-            std::shared_ptr<poller> &
-        ) requires (tcp_concept<P>);
+            std::shared_ptr<poller> &,
+            std::shared_ptr<timer_wheel> const &
+        ) requires (connection_concept<P>);
+
+        socket
+        (
+            unix_socket_path,
+            configuration const &,
+            event_handlers const &,
+            work_contract_group &,
+            work_contract_group &,
+            std::shared_ptr<poller> &,
+            std::shared_ptr<timer_wheel> const &
+        ) requires (unix_concept<P>);
 
         ~socket() = default;
 
@@ -125,10 +179,18 @@ namespace bcpp::network
             send_completion_token
         ) requires (udp_concept<P>);
 
+        bool send_file
+        (
+            std::int32_t,
+            std::uint64_t,
+            std::size_t,
+            send_completion_token
+        ) requires (stream_concept<P>);
+
         connect_result connect_to
         (
             socket_address
-        ) noexcept;
+        ) noexcept requires (!unix_concept<P>);
 
         bool close();
 
@@ -149,6 +211,23 @@ namespace bcpp::network
             ip_address
         ) requires (udp_concept<P>);
 
+        connect_result join
+        (
+            ip_address,
+            ip_address
+        ) requires (udp_concept<P>);
+
+        bool leave
+        (
+            ip_address
+        ) requires (udp_concept<P>);
+
+        bool leave
+        (
+            ip_address,
+            ip_address
+        ) requires (udp_concept<P>);
+
         bool shutdown() noexcept;
 
         system::file_descriptor const & get_file_descriptor() const;
@@ -195,5 +274,7 @@ namespace bcpp::network
 
     using udp_socket = active_socket<network_transport_protocol::udp>;
     using tcp_socket = active_socket<network_transport_protocol::tcp>;
+    using unix_stream_socket = active_socket<network_transport_protocol::unix_stream>;
+    using unix_seqpacket_socket = active_socket<network_transport_protocol::unix_seqpacket>;
 
 } // namespace bcpp::network
@@ -0,0 +1,148 @@
+#include "./loopback_socket.h"
+#include "./private/loopback_socket_impl.h"
+
+#include <iostream>
+
+
+//=============================================================================
+bcpp::network::loopback_socket::socket
+(
+    socket_address socketAddress,
+    configuration const & config,
+    event_handlers const & eventHandlers,
+    work_contract_group & sendWorkContractGroup,
+    work_contract_group & receiveWorkContractGroup,
+    std::shared_ptr<poller> &,          // no file descriptor to poll
+    std::shared_ptr<timer_wheel> const &
+)
+try
+{
+    impl_ = std::move(decltype(impl_)(new impl_type(
+            socketAddress,
+            {
+                .sendQueueSize_ = config.sendQueueSize_,
+                .sendQueueProducerMode_ = config.sendQueueProducerMode_,
+                .receiveQueueSize_ = config.receiveQueueSize_,
+                .receiveBatchSize_ = config.receiveBatchSize_
+            },
+            {
+                eventHandlers.closeHandler_,
+                eventHandlers.receiveHandler_,
+                eventHandlers.sendErrorHandler_
+            },
+            sendWorkContractGroup, receiveWorkContractGroup),
+            [](auto * impl){impl->destroy();}));
+}
+catch (std::exception const & exception)
+{
+    std::cerr << "loopback_socket ctor failure.  reason: " << exception.what() << "\n";
+    impl_.reset();
+}
+
+
+//=============================================================================
+bool bcpp::network::loopback_socket::send
+(
+    packet && data
+)
+{
+    return send(std::move(data), {});
+}
+
+
+//=============================================================================
+bool bcpp::network::loopback_socket::send
+(
+    packet && data,
+    send_completion_token sendCompletionToken
+)
+{
+    return (impl_) ? impl_->send(std::move(data), sendCompletionToken) : false;
+}
+
+
+//=============================================================================
+bool bcpp::network::loopback_socket::send_to
+(
+    socket_address destination,
+    packet && data
+)
+{
+    return send_to(destination, std::move(data), {});
+}
+
+
+//=============================================================================
+bool bcpp::network::loopback_socket::send_to
+(
+    socket_address destination,
+    packet && data,
+    send_completion_token sendCompletionToken
+)
+{
+    return (impl_) ? impl_->send_to(destination, std::move(data), sendCompletionToken) : false;
+}
+
+
+//=============================================================================
+bool bcpp::network::loopback_socket::connect_to
+(
+    socket_address destination
+)
+{
+    return (impl_) ? impl_->connect_to(destination) : false;
+}
+
+
+//=============================================================================
+bool bcpp::network::loopback_socket::close
+(
+)
+{
+    return (impl_) ? impl_->close() : false;
+}
+
+
+//=============================================================================
+bool bcpp::network::loopback_socket::is_valid
+(
+) const noexcept
+{
+    return (impl_) ? impl_->is_valid() : false;
+}
+
+
+//=============================================================================
+bool bcpp::network::loopback_socket::is_connected
+(
+) const noexcept
+{
+    return (impl_) ? impl_->is_connected() : false;
+}
+
+
+//=============================================================================
+auto bcpp::network::loopback_socket::get_socket_address
+(
+) const noexcept -> socket_address
+{
+    return (impl_) ? impl_->get_socket_address() : socket_address{};
+}
+
+
+//=============================================================================
+auto bcpp::network::loopback_socket::get_peer_socket_address
+(
+) const noexcept -> socket_address
+{
+    return (impl_) ? impl_->get_peer_socket_address() : socket_address{};
+}
+
+
+//=============================================================================
+auto bcpp::network::loopback_socket::get_id
+(
+) const -> socket_id
+{
+    return (impl_) ? impl_->get_id() : socket_id{};
+}
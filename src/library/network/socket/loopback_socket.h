@@ -0,0 +1,127 @@
+#pragma once
+
+#include "./socket.h"
+#include "./send_completion_token.h"
+#include "./traits/traits.h"
+
+#include <library/work_contract.h>
+#include <library/network/poller/poller.h>
+#include <library/network/ip/socket_address.h>
+#include <library/network/packet/packet.h>
+#include <library/network/queue/producer_mode.h>
+#include <library/network/timer/timer_wheel.h>
+
+#include <functional>
+#include <memory>
+#include <cstdint>
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    // in process datagram transport with udp like semantics.  sockets are bound
+    // to a socket address within a process wide registry and packets sent to
+    // that address are moved directly into the bound socket's receive queue.
+    // there are no system calls on either the send or the receive path which
+    // makes this transport useful for deterministic testing and for measuring
+    // the overhead of the library itself (independent of the kernel).
+    template <>
+    class socket<loopback_socket_traits>
+    {
+    public:
+
+        using traits = loopback_socket_traits;
+
+        struct event_handlers
+        {
+            using close_handler = std::function<void(socket_id)>;
+            using receive_handler = std::function<void(socket_id, packet, socket_address)>;
+            using send_error_handler = std::function<void(socket_id, std::int32_t)>;
+
+            close_handler               closeHandler_;
+            receive_handler             receiveHandler_;
+            send_error_handler          sendErrorHandler_;
+        };
+
+        struct configuration
+        {
+            std::size_t sendQueueSize_{0};      // 0 = default
+            producer_mode sendQueueProducerMode_{producer_mode::single_producer};
+            std::size_t receiveQueueSize_{0};   // 0 = default.  deliveries beyond this are dropped
+            std::size_t receiveBatchSize_{0};   // packets delivered per receive contract invocation (0 = default)
+        };
+
+        socket(socket const &) = delete;
+        socket & operator = (socket const &) = delete;
+
+        socket() = default;
+        socket(socket &&) = default;
+        socket & operator = (socket &&) = default;
+
+        socket
+        (
+            socket_address,
+            configuration const &,
+            event_handlers const &,
+            work_contract_group &,
+            work_contract_group &,
+            std::shared_ptr<poller> &,
+            std::shared_ptr<timer_wheel> const &
+        );
+
+        ~socket() = default;
+
+        bool send
+        (
+            packet &&
+        );
+
+        bool send
+        (
+            packet &&,
+            send_completion_token
+        );
+
+        bool send_to
+        (
+            socket_address,
+            packet &&
+        );
+
+        bool send_to
+        (
+            socket_address,
+            packet &&,
+            send_completion_token
+        );
+
+        bool connect_to
+        (
+            socket_address
+        );
+
+        bool close();
+
+        bool is_valid() const noexcept;
+
+        bool is_connected() const noexcept;
+
+        socket_address get_socket_address() const noexcept;
+
+        socket_address get_peer_socket_address() const noexcept;
+
+        socket_id get_id() const;
+
+    private:
+
+        using impl_type = socket_impl<traits>;
+
+        std::unique_ptr<impl_type, std::function<void(impl_type *)>>   impl_;
+
+    }; // class socket<loopback_socket_traits>
+
+
+    using loopback_socket = socket<loopback_socket_traits>;
+
+} // namespace bcpp::network
@@ -3,14 +3,15 @@
 
 
 //=============================================================================
-bcpp::network::passive_socket::socket
+template <bcpp::network::network_transport_protocol P>
+bcpp::network::passive_socket<P>::socket
 (
     socket_address socketAddress,
     configuration const & config,
     event_handlers const & eventHandlers,
     work_contract_group & workContractGroup,
     std::shared_ptr<poller> & p
-) 
+) requires (tcp_concept<P>)
 try
 {
     impl_ = std::move(decltype(impl_)(new impl_type(
@@ -34,7 +35,40 @@ catch (std::exception const & exception)
 
 
 //=============================================================================
-bool bcpp::network::passive_socket::close
+template <bcpp::network::network_transport_protocol P>
+bcpp::network::passive_socket<P>::socket
+(
+    unix_socket_path unixSocketPath,
+    configuration const & config,
+    event_handlers const & eventHandlers,
+    work_contract_group & workContractGroup,
+    std::shared_ptr<poller> & p
+) requires (unix_concept<P>)
+try
+{
+    impl_ = std::move(decltype(impl_)(new impl_type(
+            unixSocketPath,
+            {
+                .backlog_ = config.backlog_
+            }, 
+            {
+                eventHandlers.closeHandler_,
+                eventHandlers.pollErrorHandler_,
+                eventHandlers.acceptHandler_
+            },
+            workContractGroup, p), 
+            [](auto * impl){impl->destroy();}));
+}
+catch (std::exception const & exception)
+{
+    std::cerr << "passive_socket ctor failure.  reason: " << exception.what() << "\n";
+    impl_.reset();
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+bool bcpp::network::passive_socket<P>::close
 (
 )
 {
@@ -43,7 +77,8 @@ bool bcpp::network::passive_socket::close
 
 
 //=============================================================================
-bool bcpp::network::passive_socket::is_valid
+template <bcpp::network::network_transport_protocol P>
+bool bcpp::network::passive_socket<P>::is_valid
 (
 ) const noexcept
 {
@@ -52,7 +87,8 @@ bool bcpp::network::passive_socket::is_valid
 
 
 //=============================================================================
-auto bcpp::network::passive_socket::get_socket_address
+template <bcpp::network::network_transport_protocol P>
+auto bcpp::network::passive_socket<P>::get_socket_address
 (
 ) const noexcept -> socket_address
 {
@@ -61,7 +97,8 @@ auto bcpp::network::passive_socket::get_socket_address
 
 
 //=============================================================================
-auto bcpp::network::passive_socket::get_ip_address
+template <bcpp::network::network_transport_protocol P>
+auto bcpp::network::passive_socket<P>::get_ip_address
 (
 ) const noexcept -> ip_address
 {
@@ -70,7 +107,8 @@ auto bcpp::network::passive_socket::get_ip_address
 
 
 //=============================================================================
-auto bcpp::network::passive_socket::get_id
+template <bcpp::network::network_transport_protocol P>
+auto bcpp::network::passive_socket<P>::get_id
 (
 ) const -> socket_id
 {
@@ -79,7 +117,8 @@ auto bcpp::network::passive_socket::get_id
 
 
 //=============================================================================
-std::optional<std::int32_t> bcpp::network::passive_socket::get_socket_option
+template <bcpp::network::network_transport_protocol P>
+std::optional<std::int32_t> bcpp::network::passive_socket<P>::get_socket_option
 (
     std::int32_t level,
     std::int32_t optionName
@@ -90,7 +129,8 @@ std::optional<std::int32_t> bcpp::network::passive_socket::get_socket_option
 
 
 //=============================================================================
-bool bcpp::network::socket<bcpp::network::tcp_listener_socket_traits>::set_socket_option
+template <bcpp::network::network_transport_protocol P>
+bool bcpp::network::passive_socket<P>::set_socket_option
 (
     std::int32_t level,
     std::int32_t optionName,
@@ -99,3 +139,12 @@ bool bcpp::network::socket<bcpp::network::tcp_listener_socket_traits>::set_socke
 {
     return (impl_) ? impl_->set_socket_option(level, optionName, value) : false;
 }
+
+
+//=============================================================================
+namespace bcpp::network
+{
+    template class socket<tcp_listener_socket_traits>;
+    template class socket<unix_stream_listener_socket_traits>;
+    template class socket<unix_seqpacket_listener_socket_traits>;
+}
@@ -7,6 +7,7 @@
 
 #include <library/network/poller/poller.h>
 #include <library/network/ip/socket_address.h>
+#include <library/network/socket/unix_socket_path.h>
 
 #include <library/work_contract.h>
 #include <library/system.h>
@@ -21,12 +22,12 @@ namespace bcpp::network
 {
 
     //=========================================================================
-    template <>
-    class socket<tcp_listener_socket_traits>
+    template <network_transport_protocol P>
+    class socket<passive_socket_traits<P>>
     {
     public:
         
-        using traits = tcp_listener_socket_traits; 
+        using traits = passive_socket_traits<P>; 
 
         static auto constexpr default_backlog{128};
 
@@ -43,7 +44,7 @@ namespace bcpp::network
 
         struct configuration
         {
-            port_id         portId_;
+            port_id         portId_; // tcp only
             std::uint32_t   backlog_{default_backlog};
         };
 
@@ -61,7 +62,16 @@ namespace bcpp::network
             event_handlers const &,
             work_contract_group &,
             std::shared_ptr<poller> &
-        );
+        ) requires (tcp_concept<P>);
+
+        socket
+        (
+            unix_socket_path,
+            configuration const &,
+            event_handlers const &,
+            work_contract_group &,
+            std::shared_ptr<poller> &
+        ) requires (unix_concept<P>);
 
         ~socket() = default;
 
@@ -94,14 +104,17 @@ namespace bcpp::network
 
         std::unique_ptr<impl_type, std::function<void(impl_type *)>>   impl_;
 
-    }; // class socket<tcp_listener_socket_traits>
+    }; // class socket<passive_socket_traits<P>>
 
 
-    using passive_socket = socket<tcp_listener_socket_traits>;
+    template <network_transport_protocol P>
+    using passive_socket = socket<passive_socket_traits<P>>;
 
     template <typename T>
     concept passive_socket_concept = socket_concept<T> && passive_socket_traits_concept<typename T::traits>;
 
-    using tcp_listener_socket = passive_socket;
+    using tcp_listener_socket = passive_socket<network_transport_protocol::tcp>;
+    using unix_stream_listener_socket = passive_socket<network_transport_protocol::unix_stream>;
+    using unix_seqpacket_listener_socket = passive_socket<network_transport_protocol::unix_seqpacket>;
 
 } // namespace bcpp::network
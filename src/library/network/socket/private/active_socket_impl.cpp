@@ -1,12 +1,23 @@
 #include "./active_socket_impl.h"
+#include "./socket_impl_allocator.h"
 
 #include <cstring>
 
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <netinet/udp.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/un.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <sys/sendfile.h>
+#include <linux/errqueue.h>
+
+#include <array>
+#include <ctime>
+#include <limits>
+#include <stdexcept>
 
 
 namespace
@@ -14,6 +25,43 @@ namespace
     static auto constexpr max_tcp_read_buffer_size = ((1ul << 10) * 64);
     static auto constexpr default_tcp_read_buffer_size = ((1ul << 10) * 4);
     static auto constexpr default_udp_read_buffer_size = ((1ul << 10) * 2);
+    static auto constexpr max_udp_read_buffer_size = ((1ul << 16) - 1);
+    static auto constexpr max_coalesced_sends = 64;
+
+    // messages which are larger than the read buffer are truncated so sequenced
+    // packet sockets default to the largest read buffer
+    static auto constexpr default_unix_seqpacket_read_buffer_size = max_tcp_read_buffer_size;
+
+    template <bcpp::network::network_transport_protocol P>
+    static auto constexpr unix_socket_type = (P == bcpp::network::network_transport_protocol::unix_stream) ? SOCK_STREAM : SOCK_SEQPACKET;
+
+
+    //=========================================================================
+    std::uint64_t get_kernel_time_stamp
+    (
+        // the SO_TIMESTAMPNS receive time stamp (nanoseconds since the epoch) 
+        // from a received control message or zero if there is none
+        ::cmsghdr const * controlMessage
+    )
+    {
+        if ((controlMessage->cmsg_level != SOL_SOCKET) || (controlMessage->cmsg_type != SCM_TIMESTAMPNS))
+            return 0;
+        ::timespec timeSpec;
+        std::memcpy(&timeSpec, CMSG_DATA(controlMessage), sizeof(timeSpec));
+        return ((static_cast<std::uint64_t>(timeSpec.tv_sec) * 1'000'000'000) + timeSpec.tv_nsec);
+    }
+
+
+    //=========================================================================
+    constexpr bool is_connection_broken
+    (
+        // send errors after which no further send on a connection can succeed
+        std::int32_t errorCode
+    )
+    {
+        return ((errorCode == EPIPE) || (errorCode == ECONNRESET) || (errorCode == ENOTCONN) || 
+                (errorCode == ETIMEDOUT) || (errorCode == ECONNABORTED));
+    }
 }
 
 
@@ -26,9 +74,10 @@ bcpp::network::active_socket_impl<P>::socket_impl
     event_handlers const & eventHandlers,
     work_contract_group & sendWorkContractGroup,
     work_contract_group & receiveWorkContractGroup,
-    std::shared_ptr<poller> const & p
-) :
-    socket_base_impl(socketAddress, {.ioMode_ = config.ioMode_}, eventHandlers, 
+    std::shared_ptr<poller> const & p,
+    std::shared_ptr<timer_wheel> const & timerWheel
+) requires (!unix_concept<P>) :
+    socket_base_impl(socketAddress, {.ioMode_ = config.ioMode_, .reusePort_ = config.reusePort_}, eventHandlers, 
             (P == network_transport_protocol::udp) ? ::socket(PF_INET, SOCK_DGRAM, IPPROTO_UDP) : ::socket(PF_INET, SOCK_STREAM, IPPROTO_TCP),
             receiveWorkContractGroup.create_contract([this](){this->receive();}, [this](){this->destroy();})),
     poller_(p),
@@ -37,17 +86,68 @@ bcpp::network::active_socket_impl<P>::socket_impl
     packetAllocationHandler_(eventHandlers.packetAllocationHandler_ ? 
             eventHandlers.packetAllocationHandler_ : 
             [](auto, auto size){return packet(size);}),
-    sendQueue_(config.sendQueueSize_ ? config.sendQueueSize_ : configuration::default_send_queue_capacity),
-    sendContract_(sendWorkContractGroup.create_contract([this](){this->execute_next_send();}, [this](){this->destroy();}))
+    hangUpHandler_(eventHandlers.hangUpHandler_),
+    peerHangUpHandler_(eventHandlers.peerHangUpHandler_),
+    sendQueueHighHandler_(eventHandlers.sendQueueHighHandler_),
+    sendQueueDrainedHandler_(eventHandlers.sendQueueDrainedHandler_),
+    sendErrorHandler_(eventHandlers.sendErrorHandler_),
+    idleTimeoutHandler_(eventHandlers.idleTimeoutHandler_),
+    heartbeatHandler_(eventHandlers.heartbeatHandler_),
+    multicastReceiveHandler_(eventHandlers.multicastReceiveHandler_),
+    segmentedReceiveHandler_(eventHandlers.segmentedReceiveHandler_),
+    sendQueue_(config.sendQueueSize_ ? config.sendQueueSize_ : configuration::default_send_queue_capacity, config.sendQueueProducerMode_),
+    zeroCopyThreshold_((tcp_concept<P> && (config.sendCoalescingSize_ == 0)) ? config.zeroCopyThreshold_ : 0), // coalesced sends are copied
+    zeroCopyPending_((zeroCopyThreshold_ > 0) ? sendQueue_.capacity() : 0),
+    sendQueueHighWatermarkBytes_(config.sendQueueHighWatermarkBytes_),
+    sendQueueLowWatermarkBytes_(std::min(config.sendQueueLowWatermarkBytes_, config.sendQueueHighWatermarkBytes_)),
+    sendQueueHighWatermarkPackets_(config.sendQueueHighWatermarkPackets_),
+    sendQueueLowWatermarkPackets_(std::min(config.sendQueueLowWatermarkPackets_, config.sendQueueHighWatermarkPackets_)),
+    sendCoalescingSize_(stream_concept<P> ? config.sendCoalescingSize_ : 0),
+    sendCoalescingDelay_(config.sendCoalescingDelay_),
+    sendContract_(sendWorkContractGroup.create_contract([this](){this->execute_next_send();}, [this](){this->destroy();})),
+    idleTimeout_(connection_concept<P> ? config.idleTimeout_ : std::chrono::nanoseconds(0)),
+    heartbeatInterval_(connection_concept<P> ? config.heartbeatInterval_ : std::chrono::nanoseconds(0)),
+    timerWheel_(timerWheel),
+    packetCapture_(unix_concept<P> ? nullptr : config.packetCapture_)
 {
+    if constexpr (udp_concept<P>)
+        if ((segmentedReceiveHandler_) && (multicastReceiveHandler_))
+            throw std::runtime_error("segmented and multicast receive handlers are mutually exclusive"); // each packet goes to only one
     p->register_socket(*this);
     if constexpr (tcp_concept<P>)
+    {
         readBufferSize_ = (config.readBufferSize_ != 0) ? std::min(config.readBufferSize_, max_tcp_read_buffer_size) : default_tcp_read_buffer_size;
+        start_activity_timer(receiveWorkContractGroup);
+        if ((zeroCopyThreshold_ > 0) && (not set_socket_option(SOL_SOCKET, SO_ZEROCOPY, 1)))
+            zeroCopyThreshold_ = 0; // not supported
+    }
     if constexpr (udp_concept<P>)
     {
         readBufferSize_ = default_udp_read_buffer_size;
+        if (config.sendSegmentSize_ > 0)
+        {
+            // generic segmentation offload.  any send larger than the segment size is 
+            // split into datagrams of the segment size by the kernel (or the nic).
+            set_socket_option(SOL_UDP, UDP_SEGMENT, static_cast<std::int32_t>(config.sendSegmentSize_));
+        }
+        if (segmentedReceiveHandler_)
+        {
+            // generic receive offload.  consecutive datagrams from the same flow can be
+            // delivered as a single packet (see receive_message)
+            if (set_socket_option(SOL_UDP, UDP_GRO, 1))
+                readBufferSize_ = max_udp_read_buffer_size;
+        }
+        if (multicastReceiveHandler_)
+            set_socket_option(IPPROTO_IP, IP_PKTINFO, 1); // every packet goes to this handler (with its destination)
         if (config.multicastTtl_)
             set_socket_option(IPPROTO_IP, IP_MULTICAST_TTL, config.multicastTtl_);
+        // memberships and outbound multicast use the interface of the virtual network interface
+        if ((config.multicastInterface_.is_valid()) && (!(config.multicastInterface_ == in_addr_any)))
+        {
+            multicastInterface_ = config.multicastInterface_;
+            set_socket_option(IPPROTO_IP, IP_MULTICAST_IF, static_cast<::in_addr>(multicastInterface_));
+        }
+        set_socket_option(IPPROTO_IP, IP_MULTICAST_LOOP, config.multicastLoop_ ? 1 : 0);
         if (config.ttl_)
             set_socket_option(IPPROTO_IP, IP_TTL, config.ttl_);
     }
@@ -56,6 +156,8 @@ bcpp::network::active_socket_impl<P>::socket_impl
         set_socket_option(SOL_SOCKET, SO_RCVBUF, config.socketReceiveBufferSize_);
     if (config.socketSendBufferSize_ > 0)
         set_socket_option(SOL_SOCKET, SO_SNDBUF, config.socketSendBufferSize_);
+    if (packetCapture_)
+        set_socket_option(SOL_SOCKET, SO_TIMESTAMPNS, 1); // kernel receive time stamps for the capture
 }
 
 
@@ -63,15 +165,16 @@ bcpp::network::active_socket_impl<P>::socket_impl
 template <bcpp::network::network_transport_protocol P>
 bcpp::network::active_socket_impl<P>::socket_impl
 (
-    // this ctor is for 'accepted' tcp sockets where the socket file
-    // descriptor is created prior to the socket_impl
+    // this ctor is for 'accepted' tcp and unix domain sockets where the 
+    // socket file descriptor is created prior to the socket_impl
     system::file_descriptor fileDescriptor,
     configuration const & config,
     event_handlers const & eventHandlers,
     work_contract_group & sendWorkContractGroup,
     work_contract_group & receiveWorkContractGroup,
-    std::shared_ptr<poller> const & p
-) requires (tcp_concept<P>) :
+    std::shared_ptr<poller> const & p,
+    std::shared_ptr<timer_wheel> const & timerWheel
+) requires (connection_concept<P>) :
     socket_base_impl({.ioMode_ = config.ioMode_}, eventHandlers, std::move(fileDescriptor),
             receiveWorkContractGroup.create_contract([this](){this->receive();}, [this](){this->destroy();})),
     poller_(p),
@@ -80,16 +183,75 @@ bcpp::network::active_socket_impl<P>::socket_impl
     packetAllocationHandler_(eventHandlers.packetAllocationHandler_ ? 
             eventHandlers.packetAllocationHandler_ : 
             [](auto, auto size){return packet(size);}),
-    sendQueue_(config.sendQueueSize_ ? config.sendQueueSize_ : configuration::default_send_queue_capacity),
-    sendContract_(sendWorkContractGroup.create_contract([this](){this->execute_next_send();}, [this](){this->destroy();}))
+    hangUpHandler_(eventHandlers.hangUpHandler_),
+    peerHangUpHandler_(eventHandlers.peerHangUpHandler_),
+    sendQueueHighHandler_(eventHandlers.sendQueueHighHandler_),
+    sendQueueDrainedHandler_(eventHandlers.sendQueueDrainedHandler_),
+    sendErrorHandler_(eventHandlers.sendErrorHandler_),
+    idleTimeoutHandler_(eventHandlers.idleTimeoutHandler_),
+    heartbeatHandler_(eventHandlers.heartbeatHandler_),
+    multicastReceiveHandler_(eventHandlers.multicastReceiveHandler_),
+    segmentedReceiveHandler_(eventHandlers.segmentedReceiveHandler_),
+    sendQueue_(config.sendQueueSize_ ? config.sendQueueSize_ : configuration::default_send_queue_capacity, config.sendQueueProducerMode_),
+    zeroCopyThreshold_((tcp_concept<P> && (config.sendCoalescingSize_ == 0)) ? config.zeroCopyThreshold_ : 0), // coalesced sends are copied
+    zeroCopyPending_((zeroCopyThreshold_ > 0) ? sendQueue_.capacity() : 0),
+    sendQueueHighWatermarkBytes_(config.sendQueueHighWatermarkBytes_),
+    sendQueueLowWatermarkBytes_(std::min(config.sendQueueLowWatermarkBytes_, config.sendQueueHighWatermarkBytes_)),
+    sendQueueHighWatermarkPackets_(config.sendQueueHighWatermarkPackets_),
+    sendQueueLowWatermarkPackets_(std::min(config.sendQueueLowWatermarkPackets_, config.sendQueueHighWatermarkPackets_)),
+    sendCoalescingSize_(stream_concept<P> ? config.sendCoalescingSize_ : 0),
+    sendCoalescingDelay_(config.sendCoalescingDelay_),
+    sendContract_(sendWorkContractGroup.create_contract([this](){this->execute_next_send();}, [this](){this->destroy();})),
+    idleTimeout_(connection_concept<P> ? config.idleTimeout_ : std::chrono::nanoseconds(0)),
+    heartbeatInterval_(connection_concept<P> ? config.heartbeatInterval_ : std::chrono::nanoseconds(0)),
+    timerWheel_(timerWheel),
+    packetCapture_(unix_concept<P> ? nullptr : config.packetCapture_)
 {
     p->register_socket(*this);
     readBufferSize_ = (config.readBufferSize_ != 0) ? std::min(config.readBufferSize_, max_tcp_read_buffer_size) : default_tcp_read_buffer_size;
-    peerSocketAddress_ = get_peer_name();
+    if constexpr (unix_concept<P>)
+    {
+        if ((P == network_transport_protocol::unix_seqpacket) && (config.readBufferSize_ == 0))
+            readBufferSize_ = default_unix_seqpacket_read_buffer_size;
+        ::sockaddr_un peerAddress;
+        ::socklen_t sizeofPeerAddress(sizeof(peerAddress));
+        unixPeerConnected_ = (::getpeername(fileDescriptor_.get(), (struct sockaddr *)&peerAddress, &sizeofPeerAddress) == 0);
+    }
+    else
+    {
+        peerSocketAddress_ = get_peer_name();
+    }
+    start_activity_timer(receiveWorkContractGroup);
+    if ((zeroCopyThreshold_ > 0) && (not set_socket_option(SOL_SOCKET, SO_ZEROCOPY, 1)))
+        zeroCopyThreshold_ = 0; // not supported
     if (config.socketReceiveBufferSize_ > 0)
         set_socket_option(SOL_SOCKET, SO_RCVBUF, config.socketReceiveBufferSize_);
     if (config.socketSendBufferSize_ > 0)
         set_socket_option(SOL_SOCKET, SO_SNDBUF, config.socketSendBufferSize_);
+    if (packetCapture_)
+        set_socket_option(SOL_SOCKET, SO_TIMESTAMPNS, 1); // kernel receive time stamps for the capture
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+bcpp::network::active_socket_impl<P>::socket_impl
+(
+    // this ctor is for unix domain sockets which connect to a listener which
+    // is bound to the specified path.  unix domain connects complete (or fail)
+    // immediately.  use is_connected to determine the outcome.
+    unix_socket_path peerSocketPath,
+    configuration const & config,
+    event_handlers const & eventHandlers,
+    work_contract_group & sendWorkContractGroup,
+    work_contract_group & receiveWorkContractGroup,
+    std::shared_ptr<poller> const & p,
+    std::shared_ptr<timer_wheel> const & timerWheel
+) requires (unix_concept<P>) :
+    socket_impl(system::file_descriptor(::socket(PF_UNIX, unix_socket_type<P>, 0)), config, eventHandlers, 
+            sendWorkContractGroup, receiveWorkContractGroup, p, timerWheel)
+{
+    connect_to(peerSocketPath);
 }
 
 
@@ -98,7 +260,7 @@ template <bcpp::network::network_transport_protocol P>
 auto bcpp::network::active_socket_impl<P>::connect_to
 (
     socket_address const & destination
-) noexcept -> connect_result
+) noexcept -> connect_result requires (!unix_concept<P>)
 {
     if (!destination.is_valid())
         return connect_result::invalid_destination;
@@ -119,63 +281,164 @@ auto bcpp::network::active_socket_impl<P>::connect_to
 }
 
 
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+auto bcpp::network::active_socket_impl<P>::connect_to
+(
+    unix_socket_path const & destination
+) noexcept -> connect_result requires (unix_concept<P>)
+{
+    if (!destination.is_valid())
+        return connect_result::invalid_destination;
+
+    if (!fileDescriptor_.is_valid())
+        return connect_result::invalid_file_descriptor;
+
+    if (is_connected())
+        return connect_result::already_connected;
+
+    ::sockaddr_un socketAddress = destination;
+    if (::connect(fileDescriptor_.get(), (sockaddr const *)&socketAddress, destination.get_socket_address_length()) != 0)
+        return connect_result::connect_error; // EAGAIN indicates that the listener's backlog is full
+    unixPeerConnected_ = true;
+    return connect_result::success;
+}
+
+
 //=============================================================================
 template <bcpp::network::network_transport_protocol P>
 auto bcpp::network::active_socket_impl<P>::join
 (
-    ip_address ipAddress
+    // join the any source multicast group
+    ip_address group
 ) -> connect_result requires (udp_concept<P>)
 {
-    if (!ipAddress.is_valid())
+    return join(group, ip_address{});
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+auto bcpp::network::active_socket_impl<P>::join
+(
+    // join the multicast group.  if the source is valid then the membership is
+    // source specific (only traffic to the group from that source is received).
+    // a socket can be a member of any number of groups but all must share the
+    // port to which the socket is bound.
+    ip_address group,
+    ip_address source
+) -> connect_result requires (udp_concept<P>)
+{
+    if (!group.is_multicast())
         return connect_result::invalid_destination;
 
     if (!fileDescriptor_.is_valid())
         return connect_result::invalid_file_descriptor;
 
     if (is_connected())
-        return connect_result::already_connected;
+        return connect_result::already_connected; // connected to a unicast peer
 
-    // join multicast
-    ::ip_mreq mreq;
-    ::memset(&mreq, 0x00, sizeof(mreq));
-    mreq.imr_multiaddr = ipAddress;
-    mreq.imr_interface = in_addr_any;
-    if (not set_socket_option(IPPROTO_IP, IP_ADD_MEMBERSHIP, mreq))
+    for (auto const & [existingGroup, existingSource] : multicastMemberships_)
+        if ((existingGroup == group) && (existingSource == source))
+            return connect_result::already_connected;
+
+    if (not set_multicast_membership(group, source, true))
     {
         // TODO: log failure
         return connect_result::connect_error;
     }
-    peerSocketAddress_ = {ipAddress, port_id{0}};
-    set_io_mode(system::io_mode::read);
+
+    if (multicastMemberships_.empty())
+    {
+        // report the destination group of each packet (see receive_message)
+        set_socket_option(IPPROTO_IP, IP_PKTINFO, 1);
+        set_io_mode(system::io_mode::read);
+    }
+    multicastMemberships_.push_back({group, source});
     return connect_result::success;
 }
 
 
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+bool bcpp::network::active_socket_impl<P>::leave
+(
+    ip_address group
+) requires (udp_concept<P>)
+{
+    return leave(group, ip_address{});
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+bool bcpp::network::active_socket_impl<P>::leave
+(
+    ip_address group,
+    ip_address source
+) requires (udp_concept<P>)
+{
+    for (auto iter = multicastMemberships_.begin(); iter != multicastMemberships_.end(); ++iter)
+    {
+        if ((iter->group_ == group) && (iter->source_ == source))
+        {
+            if (not set_multicast_membership(group, source, false))
+                return false; // still a member
+            multicastMemberships_.erase(iter);
+            return true;
+        }
+    }
+    return false;
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+bool bcpp::network::active_socket_impl<P>::set_multicast_membership
+(
+    ip_address group,
+    ip_address source,
+    bool add
+) requires (udp_concept<P>)
+{
+    auto interface = multicastInterface_.is_valid() ? multicastInterface_ : in_addr_any;
+    if (source.is_valid())
+    {
+        ::ip_mreq_source mreq;
+        ::memset(&mreq, 0x00, sizeof(mreq));
+        mreq.imr_multiaddr = group;
+        mreq.imr_interface = interface;
+        mreq.imr_sourceaddr = source;
+        return set_socket_option(IPPROTO_IP, add ? IP_ADD_SOURCE_MEMBERSHIP : IP_DROP_SOURCE_MEMBERSHIP, mreq);
+    }
+    ::ip_mreq mreq;
+    ::memset(&mreq, 0x00, sizeof(mreq));
+    mreq.imr_multiaddr = group;
+    mreq.imr_interface = interface;
+    return set_socket_option(IPPROTO_IP, add ? IP_ADD_MEMBERSHIP : IP_DROP_MEMBERSHIP, mreq);
+}
+
+
 //=============================================================================
 template <bcpp::network::network_transport_protocol P>
 bool bcpp::network::active_socket_impl<P>::disconnect
 (
 )
 {
-    if ((!is_connected()) || (!fileDescriptor_.is_valid()))
+    if (!fileDescriptor_.is_valid())
         return false;
 
     if constexpr (P == network_transport_protocol::udp)
     {
-        if (peerSocketAddress_.is_multicast())
+        // drop all multicast memberships.  any which fail to drop are retained.
+        std::erase_if(multicastMemberships_, [&](auto const & membership)
+                {
+                    return set_multicast_membership(membership.group_, membership.source_, false);
+                });
+        if (!multicastMemberships_.empty())
         {
-            // drop multicast membership
-            ::ip_mreq mreq;
-            ::memset(&mreq, 0x00, sizeof(mreq));
-            mreq.imr_multiaddr = peerSocketAddress_.get_ip_address();
-            mreq.imr_interface = in_addr_any;
-            if (not set_socket_option(IPPROTO_IP, IP_DROP_MEMBERSHIP, mreq))
-            {
-                // TODO: log failure
-                return false;
-            }
-            peerSocketAddress_ = {};
-            return true;
+            // TODO: log failure
+            return false;
         }
     }
     return true;
@@ -224,12 +487,7 @@ bool bcpp::network::active_socket_impl<P>::send
     send_completion_token sendCompletionToken
 )
 {
-    if (auto queued = sendQueue_.emplace(std::move(data), sendCompletionToken, socket_address{}); queued)
-    {
-        sendContract_.schedule();
-        return true;
-    }
-    return false;
+    return enqueue_send({std::move(data), sendCompletionToken, socket_address{}});
 }
 
 
@@ -256,12 +514,108 @@ bool bcpp::network::active_socket_impl<P>::send_to
 )
 requires (udp_concept<P>) 
 {
-    if (auto queued = sendQueue_.emplace(std::move(data), sendCompletionToken, destination); queued)
+    return enqueue_send({std::move(data), sendCompletionToken, destination});
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+bool bcpp::network::active_socket_impl<P>::send_file
+(
+    // queue length bytes of the file, starting at offset, to be sent via sendfile.
+    // the send is ordered with respect to all other sends on this socket.  the
+    // file descriptor must remain open until the send completes.
+    std::int32_t fileDescriptor,
+    std::uint64_t offset,
+    std::size_t length,
+    send_completion_token sendCompletionToken
+) requires (stream_concept<P>)
+{
+    if ((fileDescriptor < 0) || (length == 0))
+        return false;
+    return enqueue_send({file_segment{fileDescriptor, offset, length}, sendCompletionToken});
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+bool bcpp::network::active_socket_impl<P>::enqueue_send
+(
+    send_info && sendInfo
+)
+{
+    // account for the packet before it becomes visible to the send contract
+    // so that the consumer can never drive the counters below zero
+    auto packetSize = (sendInfo.packet_.size() + sendInfo.fileSegment_.length_);
+    auto queuedBytes = (sendQueueBytes_.fetch_add(packetSize, std::memory_order_relaxed) + packetSize);
+    auto queuedPackets = (sendQueuePackets_.fetch_add(1, std::memory_order_relaxed) + 1);
+
+    if (auto queued = sendQueue_.emplace(std::move(sendInfo)); !queued)
     {
-        sendContract_.schedule();
-        return true;
+        sendQueueBytes_.fetch_sub(packetSize, std::memory_order_relaxed);
+        sendQueuePackets_.fetch_sub(1, std::memory_order_relaxed);
+        on_send_queue_high(); // a full queue is always 'high'
+        sendContract_.schedule(); // ensures that drained is reported even if the queue empties in the meantime
+        return false;
     }
-    return false;
+
+    if (((sendQueueHighWatermarkBytes_ > 0) && (queuedBytes >= sendQueueHighWatermarkBytes_)) ||
+            ((sendQueueHighWatermarkPackets_ > 0) && (queuedPackets >= sendQueueHighWatermarkPackets_)))
+        on_send_queue_high();
+    sendContract_.schedule();
+    return true;
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+void bcpp::network::active_socket_impl<P>::on_send_queue_high
+(
+    // invoked on the sending thread.  reported once until the queue drains
+    // back to the low watermark.
+)
+{
+    if (auto wasHigh = sendQueueHigh_.exchange(true, std::memory_order_acq_rel); !wasHigh)
+        if (sendQueueHighHandler_)
+            sendQueueHighHandler_(id_);
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+void bcpp::network::active_socket_impl<P>::on_send_queue_consumed
+(
+    // invoked by the send contract as queued data is written to the socket
+    std::size_t bytes,
+    std::size_t packets
+)
+{
+    auto queuedBytes = (sendQueueBytes_.fetch_sub(bytes, std::memory_order_relaxed) - bytes);
+    auto queuedPackets = (sendQueuePackets_.fetch_sub(packets, std::memory_order_relaxed) - packets);
+    if ((sendQueueHigh_.load(std::memory_order_acquire)) && (is_below_low_watermark(queuedBytes, queuedPackets)))
+        if (auto wasHigh = sendQueueHigh_.exchange(false, std::memory_order_acq_rel); wasHigh)
+            if (sendQueueDrainedHandler_)
+                sendQueueDrainedHandler_(id_);
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+bool bcpp::network::active_socket_impl<P>::is_below_low_watermark
+(
+    // watermarks which are not enabled are ignored.  if no watermarks are
+    // enabled then 'high' was the result of a full queue and the queue is 
+    // considered drained only once it is empty.
+    std::size_t queuedBytes,
+    std::size_t queuedPackets
+) const noexcept
+{
+    auto bytesEnabled = (sendQueueHighWatermarkBytes_ > 0);
+    auto packetsEnabled = (sendQueueHighWatermarkPackets_ > 0);
+    if ((!bytesEnabled) && (!packetsEnabled))
+        return (queuedPackets == 0);
+    return (((!bytesEnabled) || (queuedBytes <= sendQueueLowWatermarkBytes_)) &&
+            ((!packetsEnabled) || (queuedPackets <= sendQueueLowWatermarkPackets_)));
 }
 
 
@@ -271,45 +625,122 @@ void bcpp::network::active_socket_impl<P>::execute_next_send
 (
 ) 
 { 
+    if constexpr (tcp_concept<P>)
+        if (zeroCopyInFlight_.load(std::memory_order_acquire) > 0)
+            drain_zero_copy_completions();
+
+    auto sendInfo = sendQueue_.front();
+    if (sendInfo == nullptr)
+    {
+        // nothing published yet.  the producer will schedule again once it is.
+        on_send_queue_consumed(0, 0);
+        return;
+    }
+
+    if (sendBrokenErrorCode_ != 0)
+    {
+        // sends queued since the connection broke
+        fail_queued_sends(sendBrokenErrorCode_);
+        return;
+    }
+
     if constexpr (udp_concept<P>)
     {
-        auto & [packet, sendCompletionToken, destination] = sendQueue_.front();
+        auto & packet = sendInfo->packet_;
+        auto & sendCompletionToken = sendInfo->sendToken_;
+        auto & destination = sendInfo->destination_;
         ::sockaddr_in sockAddr = destination;
         sockAddr.sin_family = AF_INET;
         auto p = destination.is_valid() ? reinterpret_cast<sockaddr const *>(&sockAddr) : nullptr;
         if (auto result = ::sendto(fileDescriptor_.get(), packet.data(), packet.size(), MSG_NOSIGNAL, p, (p == nullptr) ? 0 : sizeof(sockAddr)); result < 0)
         {
-            if (result != EAGAIN)
+            if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+            {
+                on_send_error(errno);
+                if (sendQueue_.empty())
+                    return;
+            }
+            else
             {
-                // issue send error callback here
+                NETWORK_TRACE_EVENT(send_would_block, id_.get(), 0);
             }
         }
         else
         {
+            NETWORK_TRACE_EVENT(send, id_.get(), result);
+            if (packetCapture_)
+                capture(capture_direction::send, packet.data(), result, destination.is_valid() ? destination : peerSocketAddress_, 0);
             sendCompletionToken();
-            if (auto sizeAfterDiscard = sendQueue_.discard(); sizeAfterDiscard == 0)
+            auto sizeAfterDiscard = sendQueue_.discard();
+            on_send_queue_consumed(result, 1);
+            if (sizeAfterDiscard == 0)
                 return; // no more data to send
         }
     }
     else
     {
-        auto & [packet, sendCompletionToken, _] = sendQueue_.front();
-        if (auto result = ::send(fileDescriptor_.get(), packet.data(), packet.size(), MSG_NOSIGNAL); result < 0)
+        if (sendInfo->fileSegment_.length_ > 0)
         {
-            if (result != EAGAIN)
+            execute_next_file_send();
+            return;
+        }
+
+        if (sendCoalescingSize_ > 0)
+        {
+            execute_next_coalesced_send();
+            return;
+        }
+
+        auto & packet = sendInfo->packet_;
+        auto & sendCompletionToken = sendInfo->sendToken_;
+        auto zeroCopy = ((zeroCopyThreshold_ > 0) && (packet.size() >= zeroCopyThreshold_) && 
+                (zeroCopyPending_.size() < zeroCopyPending_.capacity())); // otherwise the packet could not be pinned
+        if (zeroCopy)
+            zeroCopyInFlight_.fetch_add(1, std::memory_order_acq_rel); // before the send so that the completion can not be missed
+        if (auto result = ::send(fileDescriptor_.get(), packet.data(), packet.size(), MSG_NOSIGNAL | (zeroCopy ? MSG_ZEROCOPY : 0)); result < 0)
+        {
+            auto errorCode = errno;
+            if (zeroCopy)
+                zeroCopyInFlight_.fetch_sub(1, std::memory_order_acq_rel);
+            if ((errorCode != EAGAIN) && (errorCode != EWOULDBLOCK))
+            {
+                on_send_error(errorCode);
+                if (sendQueue_.empty())
+                    return;
+            }
+            else
             {
-                // issue send error callback here
+                NETWORK_TRACE_EVENT(send_would_block, id_.get(), 0);
             }
         }
         else
         {
+            NETWORK_TRACE_EVENT(send, id_.get(), result);
+            if (heartbeatInterval_.count() > 0)
+                lastSendTime_.store(get_activity_time(), std::memory_order_relaxed);
+            if (zeroCopy)
+            {
+                frontIsZeroCopy_ = true;
+                frontZeroCopySendId_ = zeroCopyNextSendId_++;
+            }
+            if (packetCapture_)
+                capture(capture_direction::send, packet.data(), result, peerSocketAddress_, 0);
             packet.discard(result);
             if (packet.empty())
             {
-                sendCompletionToken();
-                if (auto sizeAfterDiscard = sendQueue_.discard(); sizeAfterDiscard == 0)
+                if (std::exchange(frontIsZeroCopy_, false) && (!is_zero_copy_send_complete(frontZeroCopySendId_)))
+                    zeroCopyPending_.emplace(frontZeroCopySendId_, std::move(*sendInfo)); // pinned until completion
+                else
+                    sendCompletionToken();
+                auto sizeAfterDiscard = sendQueue_.discard();
+                on_send_queue_consumed(result, 1);
+                if (sizeAfterDiscard == 0)
                     return; // no more data to send
             }
+            else
+            {
+                on_send_queue_consumed(result, 0);
+            }
         }       
     }
 
@@ -317,6 +748,395 @@ void bcpp::network::active_socket_impl<P>::execute_next_send
 }
 
 
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+void bcpp::network::active_socket_impl<P>::execute_next_coalesced_send
+(
+    // gather as many queued packets as will fit within the coalescing size into
+    // a single write.  if a coalescing delay is configured and there is not yet 
+    // enough data to fill the write then hold the data for up to that delay in 
+    // anticipation of more packets being queued.
+) requires (connection_concept<P>)
+{
+    std::array<::iovec, max_coalesced_sends> ioVectors;
+    std::size_t count = 0;
+    std::size_t bytes = 0;
+    for (send_info * sendInfo = nullptr; ((count < ioVectors.size()) && (bytes < sendCoalescingSize_) && 
+            ((sendInfo = sendQueue_.peek(count)) != nullptr)); ++count)
+    {
+        if (sendInfo->fileSegment_.length_ > 0)
+            break; // files are not coalesced
+        ioVectors[count] = {.iov_base = sendInfo->packet_.data(), .iov_len = sendInfo->packet_.size()};
+        bytes += sendInfo->packet_.size();
+    }
+
+    if ((sendCoalescingDelay_.count() > 0) && (bytes < sendCoalescingSize_) && (count < ioVectors.size()))
+    {
+        // within latency budget.  wait for more data.  rather than spin, the contract
+        // is scheduled again by the next send or by the timer at the deadline.  the
+        // timer is (re)armed for the time remaining whenever the contract finds that
+        // the deadline has not yet been reached.  without a timer wheel, do not wait.
+        auto now = std::chrono::steady_clock::now();
+        if (sendCoalescingDeadline_ == std::chrono::steady_clock::time_point{})
+            sendCoalescingDeadline_ = (now + sendCoalescingDelay_);
+        if (now < sendCoalescingDeadline_)
+        {
+            if (auto timerWheel = timerWheel_.lock(); timerWheel)
+            {
+                timerWheel->arm(sendCoalescingTimerEntry_, sendCoalescingDeadline_ - now, std::chrono::nanoseconds(0));
+                return;
+            }
+        }
+    }
+    if (std::exchange(sendCoalescingDeadline_, {}) != std::chrono::steady_clock::time_point{})
+        if (auto timerWheel = timerWheel_.lock(); timerWheel)
+            timerWheel->cancel(sendCoalescingTimerEntry_);
+
+    ::msghdr messageHeader{.msg_iov = ioVectors.data(), .msg_iovlen = count};
+    auto result = ::sendmsg(fileDescriptor_.get(), &messageHeader, MSG_NOSIGNAL);
+    if (result < 0)
+    {
+        if ((errno != EAGAIN) && (errno != EWOULDBLOCK))
+        {
+            on_send_error(errno);
+            if (sendQueue_.empty())
+                return;
+        }
+        else
+        {
+            NETWORK_TRACE_EVENT(send_would_block, id_.get(), 0);
+        }
+        sendContract_.schedule();
+        return;
+    }
+    NETWORK_TRACE_EVENT(send, id_.get(), result);
+
+    if (heartbeatInterval_.count() > 0)
+        lastSendTime_.store(get_activity_time(), std::memory_order_relaxed);
+
+    if (packetCapture_)
+    {
+        // captured as one packet per queued packet (or part thereof) which was written
+        auto uncaptured = static_cast<std::size_t>(result);
+        for (std::size_t i = 0; ((i < count) && (uncaptured > 0)); ++i)
+        {
+            auto length = std::min(uncaptured, ioVectors[i].iov_len);
+            capture(capture_direction::send, ioVectors[i].iov_base, length, peerSocketAddress_, 0);
+            uncaptured -= length;
+        }
+    }
+
+    // complete each packet which was fully written.  the last may have been partially written.
+    auto remaining = static_cast<std::size_t>(result);
+    auto sizeAfterDiscard = sendQueue_.size();
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto & packet = sendQueue_.front()->packet_;
+        auto & sendCompletionToken = sendQueue_.front()->sendToken_;
+        auto bytesSent = packet.discard(remaining);
+        remaining -= bytesSent;
+        if (!packet.empty())
+        {
+            on_send_queue_consumed(bytesSent, 0);
+            break;
+        }
+        sendCompletionToken();
+        sizeAfterDiscard = sendQueue_.discard();
+        on_send_queue_consumed(bytesSent, 1);
+    }
+
+    if (sizeAfterDiscard > 0)
+        sendContract_.schedule();
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+void bcpp::network::active_socket_impl<P>::execute_next_file_send
+(
+    // send the file segment at the front of the send queue via sendfile so
+    // that the file's contents never pass through user space.
+) requires (connection_concept<P>)
+{
+    auto & sendInfo = *sendQueue_.front();
+    auto & fileSegment = sendInfo.fileSegment_;
+    auto offset = static_cast<::off_t>(fileSegment.offset_);
+    auto result = ::sendfile(fileDescriptor_.get(), fileSegment.fileDescriptor_, &offset, fileSegment.length_);
+    if (result <= 0)
+    {
+        auto errorCode = (result == 0) ? ENODATA : errno; // zero indicates that the file is shorter than the segment
+        if ((errorCode != EAGAIN) && (errorCode != EWOULDBLOCK))
+        {
+            on_send_error(errorCode);
+            if (sendQueue_.empty())
+                return;
+        }
+        else
+        {
+            NETWORK_TRACE_EVENT(send_would_block, id_.get(), 0);
+        }
+        sendContract_.schedule();
+        return;
+    }
+    NETWORK_TRACE_EVENT(send, id_.get(), result);
+
+    if (heartbeatInterval_.count() > 0)
+        lastSendTime_.store(get_activity_time(), std::memory_order_relaxed);
+    captureSendSequence_ += result; // file contents are not captured (they never enter user space)
+    fileSegment.offset_ += result;
+    fileSegment.length_ -= result;
+    if (fileSegment.length_ > 0)
+    {
+        on_send_queue_consumed(result, 0);
+        sendContract_.schedule();
+        return;
+    }
+
+    sendInfo.sendToken_();
+    auto sizeAfterDiscard = sendQueue_.discard();
+    on_send_queue_consumed(result, 1);
+    if (sizeAfterDiscard > 0)
+        sendContract_.schedule();
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+void bcpp::network::active_socket_impl<P>::on_poll_error
+(
+    // MSG_ZEROCOPY completions are reported via the error queue which raises
+    // EPOLLERR.  the error queue is drained by the send contract.
+)
+{
+    if (zeroCopyInFlight_.load(std::memory_order_acquire) > 0)
+    {
+        sendContract_.schedule();
+        return;
+    }
+    socket_base_impl::on_poll_error();
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+void bcpp::network::active_socket_impl<P>::drain_zero_copy_completions
+(
+) requires (tcp_concept<P>)
+{
+    while (true)
+    {
+        alignas(::cmsghdr) char controlBuffer[CMSG_SPACE(sizeof(::sock_extended_err) + sizeof(::sockaddr_in))];
+        ::msghdr messageHeader{.msg_control = controlBuffer, .msg_controllen = sizeof(controlBuffer)};
+        if (::recvmsg(fileDescriptor_.get(), &messageHeader, MSG_ERRQUEUE) < 0)
+            return; // error queue is empty
+
+        for (auto controlMessage = CMSG_FIRSTHDR(&messageHeader); controlMessage != nullptr; controlMessage = CMSG_NXTHDR(&messageHeader, controlMessage))
+        {
+            if ((controlMessage->cmsg_level != SOL_IP) || (controlMessage->cmsg_type != IP_RECVERR))
+                continue;
+            auto const & extendedError = *reinterpret_cast<::sock_extended_err const *>(CMSG_DATA(controlMessage));
+            if ((extendedError.ee_errno == 0) && (extendedError.ee_origin == SO_EE_ORIGIN_ZEROCOPY))
+                complete_zero_copy_sends(extendedError.ee_info, extendedError.ee_data); // SO_EE_CODE_ZEROCOPY_COPIED is also complete
+            else
+                socket_base_impl::on_poll_error();
+        }
+    }
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+void bcpp::network::active_socket_impl<P>::complete_zero_copy_sends
+(
+    // the kernel has released the pages for sends [first, last] (inclusive).
+    // tcp completes sends in order so every send up to and including last is done.
+    std::uint32_t first,
+    std::uint32_t last
+) requires (tcp_concept<P>)
+{
+    zeroCopyInFlight_.fetch_sub((last - first) + 1, std::memory_order_acq_rel);
+    zeroCopyCompletedSendId_ = last;
+    zeroCopyAnyCompleted_ = true;
+    for (auto * pending = zeroCopyPending_.front(); ((pending != nullptr) && (is_zero_copy_send_complete(pending->lastSendId_)));
+            pending = zeroCopyPending_.front())
+    {
+        if (pending->errorCode_ != 0)
+            pending->sendInfo_.sendToken_(pending->errorCode_); // the remainder of the packet failed to send
+        else
+            pending->sendInfo_.sendToken_();
+        zeroCopyPending_.discard(); // releases the packet (back to its buffer heap if any)
+    }
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+bool bcpp::network::active_socket_impl<P>::is_zero_copy_send_complete
+(
+    std::uint32_t sendId
+) const noexcept
+{
+    return ((zeroCopyAnyCompleted_) && (static_cast<std::int32_t>(sendId - zeroCopyCompletedSendId_) <= 0));
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+void bcpp::network::active_socket_impl<P>::on_send_error
+(
+    // the send at the front of the queue has failed.  report the error, fail
+    // the send's completion token and discard it so that a broken socket does
+    // not cause the send contract to retry the same send indefinitely.  a packet
+    // which is still pinned by an earlier MSG_ZEROCOPY send of part of it is 
+    // failed only upon that send's completion.  if the socket has been closed or
+    // the error has broken the connection then every queued send is failed in 
+    // one pass (as is any which is queued later) and the error is reported once.
+    std::int32_t errorCode
+)
+{
+    NETWORK_TRACE_EVENT(send_error, id_.get(), errorCode);
+    if (sendErrorHandler_)
+        sendErrorHandler_(id_, errorCode);
+    auto & sendInfo = *sendQueue_.front();
+    auto unsentBytes = (sendInfo.packet_.size() + sendInfo.fileSegment_.length_);
+    if (std::exchange(frontIsZeroCopy_, false) && (!is_zero_copy_send_complete(frontZeroCopySendId_)))
+    {
+        // part of the packet was sent with MSG_ZEROCOPY and the kernel can still
+        // have its pages pinned.  its token is failed once that send completes.
+        zeroCopyPending_.emplace(frontZeroCopySendId_, std::move(sendInfo), errorCode);
+    }
+    else
+    {
+        sendInfo.sendToken_(errorCode);
+    }
+    sendQueue_.discard();
+    on_send_queue_consumed(unsentBytes, 1);
+    if ((!fileDescriptor_.is_valid()) || (connection_concept<P> && is_connection_broken(errorCode)))
+    {
+        sendBrokenErrorCode_ = errorCode;
+        fail_queued_sends(errorCode);
+    }
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+void bcpp::network::active_socket_impl<P>::fail_queued_sends
+(
+    // fail the completion token of every send which is currently queued
+    std::int32_t errorCode
+)
+{
+    std::size_t unsentBytes = 0;
+    std::size_t unsentPackets = 0;
+    for (auto * sendInfo = sendQueue_.front(); sendInfo != nullptr; sendInfo = sendQueue_.front())
+    {
+        unsentBytes += (sendInfo->packet_.size() + sendInfo->fileSegment_.length_);
+        ++unsentPackets;
+        sendInfo->sendToken_(errorCode);
+        sendQueue_.discard();
+    }
+    on_send_queue_consumed(unsentBytes, unsentPackets);
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+std::int64_t bcpp::network::active_socket_impl<P>::get_activity_time
+(
+)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+void bcpp::network::active_socket_impl<P>::start_activity_timer
+(
+    // the activity timer is only created if an idle timeout or a heartbeat 
+    // interval is configured.  its contract is released as part of destroy.
+    work_contract_group & workContractGroup
+) requires (connection_concept<P>)
+{
+    if ((idleTimeout_.count() <= 0) && (heartbeatInterval_.count() <= 0))
+        return;
+
+    auto timerWheel = timerWheel_.lock();
+    if (!timerWheel)
+        return;
+
+    auto now = get_activity_time();
+    lastReceiveTime_.store(now, std::memory_order_relaxed);
+    lastSendTime_.store(now, std::memory_order_relaxed);
+    activityTimerContract_ = workContractGroup.create_contract([this](){this->on_activity_timer();}, [this](){this->destroy();});
+    auto interval = std::min((idleTimeout_.count() > 0) ? idleTimeout_ : std::chrono::nanoseconds::max(), 
+            (heartbeatInterval_.count() > 0) ? heartbeatInterval_ : std::chrono::nanoseconds::max());
+    timerWheel->arm(activityTimerEntry_, interval, std::chrono::nanoseconds(0));
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+void bcpp::network::active_socket_impl<P>::on_activity_timer
+(
+    // the activity timer has expired.  compare the time of the last receive and
+    // last send against the idle timeout and heartbeat interval, report whichever
+    // are due and then re-arm the timer for the earlier of the next deadlines.
+    // activity which occurred since the timer was armed simply pushes the deadline
+    // back so there is no per receive or per send timer maintenance.
+) requires (connection_concept<P>)
+{
+    auto now = get_activity_time();
+    auto nextDeadline = std::numeric_limits<std::int64_t>::max();
+
+    if (idleTimeout_.count() > 0)
+    {
+        auto idleDeadline = (lastReceiveTime_.load(std::memory_order_relaxed) + idleTimeout_.count());
+        if (now >= idleDeadline)
+        {
+            // report once per idle period
+            lastReceiveTime_.store(now, std::memory_order_relaxed);
+            idleDeadline = (now + idleTimeout_.count());
+            if (idleTimeoutHandler_)
+                idleTimeoutHandler_(id_);
+        }
+        nextDeadline = std::min(nextDeadline, idleDeadline);
+    }
+
+    if (heartbeatInterval_.count() > 0)
+    {
+        auto heartbeatDeadline = (lastSendTime_.load(std::memory_order_relaxed) + heartbeatInterval_.count());
+        if (now >= heartbeatDeadline)
+        {
+            lastSendTime_.store(now, std::memory_order_relaxed);
+            heartbeatDeadline = (now + heartbeatInterval_.count());
+            if (heartbeatHandler_)
+                heartbeatHandler_(id_);
+        }
+        nextDeadline = std::min(nextDeadline, heartbeatDeadline);
+    }
+
+    if (auto timerWheel = timerWheel_.lock(); timerWheel)
+        timerWheel->arm(activityTimerEntry_, std::chrono::nanoseconds(nextDeadline - now), std::chrono::nanoseconds(0));
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+void bcpp::network::active_socket_impl<P>::cancel_timers
+(
+    // the activity timer and the send coalescing timer
+)
+{
+    if (auto timerWheel = timerWheel_.lock(); timerWheel)
+    {
+        timerWheel->cancel(activityTimerEntry_);
+        timerWheel->cancel(sendCoalescingTimerEntry_);
+    }
+}
+
+
 //=============================================================================
 template <bcpp::network::network_transport_protocol P>
 std::uint32_t bcpp::network::active_socket_impl<P>::get_bytes_available
@@ -334,21 +1154,43 @@ std::uint32_t bcpp::network::active_socket_impl<P>::get_bytes_available
 template <bcpp::network::network_transport_protocol P>
 void bcpp::network::active_socket_impl<P>::receive
 (
-) requires (tcp_concept<P>)
+) requires (connection_concept<P>)
 {
+    if (!on_receive_executed())
+        return;
     if (!pendingReceivePacket_)
         pendingReceivePacket_ = std::move(packetAllocationHandler_(id_, readBufferSize_));
-    if (auto bytesReceived = ::recv(fileDescriptor_.get(), pendingReceivePacket_.data(), pendingReceivePacket_.capacity(), 0); bytesReceived > 0)
+    std::uint64_t timeStamp = 0;
+    auto bytesReceived = (packetCapture_) ? 
+            receive_time_stamped(pendingReceivePacket_.data(), pendingReceivePacket_.capacity(), nullptr, timeStamp) :
+            ::recv(fileDescriptor_.get(), pendingReceivePacket_.data(), pendingReceivePacket_.capacity(), 0);
+    if (bytesReceived > 0)
     {
+        NETWORK_TRACE_EVENT(receive, id_.get(), bytesReceived);
+        if (idleTimeout_.count() > 0)
+            lastReceiveTime_.store(get_activity_time(), std::memory_order_relaxed);
+        if (packetCapture_)
+            capture(capture_direction::receive, pendingReceivePacket_.data(), bytesReceived, peerSocketAddress_, timeStamp);
         pendingReceivePacket_.resize(bytesReceived);
         receiveHandler_(id_, std::move(pendingReceivePacket_), peerSocketAddress_);
         if (get_bytes_available() > 0)
-            on_polled(); // there is more data so reschedule the work contract
+            reschedule_receive(); // there is more data so reschedule the work contract
+        return;
+    }
+
+    if (bytesReceived == 0)
+    {   // graceful shutdown (recv does not set errno in this case).  for
+        // seqpacket an empty message can not be told apart from the peer's
+        // shutdown so it too is treated as such (empty messages are not supported)
+        close();
         return;
     }
 
     if ((errno == EWOULDBLOCK) || (errno == EAGAIN))   
+    {
+        NETWORK_TRACE_EVENT(receive_would_block, id_.get(), 0);
         return; // nothing to do
+    }
 
     if ((errno == ECONNRESET) || (errno == 0))
     {   // connection reset or graceful shutdown
@@ -357,6 +1199,7 @@ void bcpp::network::active_socket_impl<P>::receive
     }
 
     // an actual error
+    NETWORK_TRACE_EVENT(receive_error, id_.get(), errno);
     if (receiveErrorHandler_)
         receiveErrorHandler_(id_, errno);
 }
@@ -368,28 +1211,173 @@ void bcpp::network::active_socket_impl<P>::receive
 (
 ) requires (udp_concept<P>)
 {
+    if (!on_receive_executed())
+        return;
+    if ((segmentedReceiveHandler_) || (multicastReceiveHandler_))
+    {
+        receive_message();
+        return;
+    }
+
     if (auto bytesAvailable = get_bytes_available(); bytesAvailable > 0)
     {
         ::sockaddr_in sockAddrIn;
         ::socklen_t addressLength = sizeof(sockAddrIn);
+        std::uint64_t timeStamp = 0;
         if (!pendingReceivePacket_)
             pendingReceivePacket_ = std::move(packetAllocationHandler_(id_, readBufferSize_));
-        if (auto bytesReceived = ::recvfrom(fileDescriptor_.get(), pendingReceivePacket_.data(), pendingReceivePacket_.capacity(), 0, 
+        if (auto bytesReceived = (packetCapture_) ? 
+                receive_time_stamped(pendingReceivePacket_.data(), pendingReceivePacket_.capacity(), &sockAddrIn, timeStamp) :
+                ::recvfrom(fileDescriptor_.get(), pendingReceivePacket_.data(), pendingReceivePacket_.capacity(), 0, 
                 reinterpret_cast<::sockaddr *>(&sockAddrIn), &addressLength); bytesReceived >= 0)
         {
+            NETWORK_TRACE_EVENT(receive, id_.get(), bytesReceived);
+            if (packetCapture_)
+                capture(capture_direction::receive, pendingReceivePacket_.data(), bytesReceived, sockAddrIn, timeStamp);
             pendingReceivePacket_.resize(bytesReceived);
             receiveHandler_(id_, std::move(pendingReceivePacket_), sockAddrIn);
-            on_polled(); // there could be more ...
+            reschedule_receive(); // there could be more ...
+        }
+        else
+        {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                NETWORK_TRACE_EVENT(receive_would_block, id_.get(), 0);
+            }
+            else
+            {
+                NETWORK_TRACE_EVENT(receive_error, id_.get(), errno);
+                if (receiveErrorHandler_)
+                    receiveErrorHandler_(id_, errno);
+            }
+        }
+    }
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+void bcpp::network::active_socket_impl<P>::receive_message
+(
+    // as per udp receive but uses recvmsg in order to collect control messages.
+    // IP_PKTINFO reports the destination group of each packet which allows a 
+    // single socket to serve many multicast groups.  UDP_GRO reports the size 
+    // of the segments when the kernel has coalesced several datagrams into one packet.
+    // datagrams which were truncated (MSG_TRUNC) are dropped and reported.
+) requires (udp_concept<P>)
+{
+    if (auto bytesAvailable = get_bytes_available(); bytesAvailable > 0)
+    {
+        ::sockaddr_in sockAddrIn;
+        if (!pendingReceivePacket_)
+            pendingReceivePacket_ = std::move(packetAllocationHandler_(id_, readBufferSize_));
+        ::iovec ioVector{.iov_base = pendingReceivePacket_.data(), .iov_len = pendingReceivePacket_.capacity()};
+        alignas(::cmsghdr) char controlBuffer[CMSG_SPACE(sizeof(::in_pktinfo)) + CMSG_SPACE(sizeof(std::int32_t)) + CMSG_SPACE(sizeof(::timespec))];
+        ::msghdr messageHeader{.msg_name = &sockAddrIn, .msg_namelen = sizeof(sockAddrIn), .msg_iov = &ioVector, .msg_iovlen = 1,
+                .msg_control = controlBuffer, .msg_controllen = sizeof(controlBuffer)};
+        if (auto bytesReceived = ::recvmsg(fileDescriptor_.get(), &messageHeader, 0); bytesReceived >= 0)
+        {
+            NETWORK_TRACE_EVENT(receive, id_.get(), bytesReceived);
+            if (messageHeader.msg_flags & MSG_TRUNC)
+            {
+                // the datagram was larger than the read buffer.  drop it rather than deliver part of it.
+                NETWORK_TRACE_EVENT(receive_error, id_.get(), EMSGSIZE);
+                if (receiveErrorHandler_)
+                    receiveErrorHandler_(id_, EMSGSIZE);
+                reschedule_receive(); // there could be more ...
+                return;
+            }
+            ip_address destination;
+            std::size_t segmentSize = bytesReceived; // not coalesced unless reported otherwise
+            std::uint64_t timeStamp = 0;
+            for (auto controlMessage = CMSG_FIRSTHDR(&messageHeader); controlMessage != nullptr; controlMessage = CMSG_NXTHDR(&messageHeader, controlMessage))
+            {
+                if ((controlMessage->cmsg_level == IPPROTO_IP) && (controlMessage->cmsg_type == IP_PKTINFO))
+                    destination = reinterpret_cast<::in_pktinfo const *>(CMSG_DATA(controlMessage))->ipi_addr;
+                if ((controlMessage->cmsg_level == SOL_UDP) && (controlMessage->cmsg_type == UDP_GRO))
+                    segmentSize = *reinterpret_cast<std::int32_t const *>(CMSG_DATA(controlMessage));
+                if (auto kernelTimeStamp = get_kernel_time_stamp(controlMessage); kernelTimeStamp != 0)
+                    timeStamp = kernelTimeStamp;
+            }
+            if (packetCapture_)
+                capture(capture_direction::receive, pendingReceivePacket_.data(), bytesReceived, sockAddrIn, timeStamp);
+            pendingReceivePacket_.resize(bytesReceived);
+            if (segmentedReceiveHandler_)
+                segmentedReceiveHandler_(id_, std::move(pendingReceivePacket_), sockAddrIn, segmentSize);
+            else
+                multicastReceiveHandler_(id_, std::move(pendingReceivePacket_), sockAddrIn, destination);
+            reschedule_receive(); // there could be more ...
         }
         else
         {
-            if ((errno != EAGAIN) && (errno != EWOULDBLOCK) && (receiveErrorHandler_))
-                receiveErrorHandler_(id_, errno);
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                NETWORK_TRACE_EVENT(receive_would_block, id_.get(), 0);
+            }
+            else
+            {
+                NETWORK_TRACE_EVENT(receive_error, id_.get(), errno);
+                if (receiveErrorHandler_)
+                    receiveErrorHandler_(id_, errno);
+            }
         }
     }
 }
 
 
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+::ssize_t bcpp::network::active_socket_impl<P>::receive_time_stamped
+(
+    // as per recvfrom (or recv if the address is null) but also collects the
+    // kernel's receive time stamp (SO_TIMESTAMPNS) for the packet capture.
+    // the time stamp is left unchanged if the kernel does not provide one.
+    void * buffer,
+    std::size_t capacity,
+    ::sockaddr_in * sockAddrIn,
+    std::uint64_t & timeStamp
+)
+{
+    ::iovec ioVector{.iov_base = buffer, .iov_len = capacity};
+    alignas(::cmsghdr) char controlBuffer[CMSG_SPACE(sizeof(::timespec))];
+    ::msghdr messageHeader{.msg_name = sockAddrIn, .msg_namelen = static_cast<::socklen_t>((sockAddrIn == nullptr) ? 0 : sizeof(::sockaddr_in)), 
+            .msg_iov = &ioVector, .msg_iovlen = 1, .msg_control = controlBuffer, .msg_controllen = sizeof(controlBuffer)};
+    auto bytesReceived = ::recvmsg(fileDescriptor_.get(), &messageHeader, 0);
+    if (bytesReceived >= 0)
+        for (auto controlMessage = CMSG_FIRSTHDR(&messageHeader); controlMessage != nullptr; controlMessage = CMSG_NXTHDR(&messageHeader, controlMessage))
+            if (auto kernelTimeStamp = get_kernel_time_stamp(controlMessage); kernelTimeStamp != 0)
+                timeStamp = kernelTimeStamp;
+    return bytesReceived;
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+void bcpp::network::active_socket_impl<P>::capture
+(
+    // hand a copy of the packet to the packet capture.  the time stamp is zero 
+    // for 'now' (sends and receives for which the kernel provided none).
+    capture_direction direction,
+    void const * data,
+    std::size_t size,
+    socket_address peer,
+    std::uint64_t timeStamp
+) noexcept
+{
+    std::span payload(reinterpret_cast<std::byte const *>(data), size);
+    if (direction == capture_direction::send)
+    {
+        packetCapture_->capture(direction, P, socketAddress_, peer, payload, timeStamp, captureSendSequence_);
+        captureSendSequence_ += static_cast<std::uint32_t>(size);
+    }
+    else
+    {
+        packetCapture_->capture(direction, P, peer, socketAddress_, payload, timeStamp, captureReceiveSequence_);
+        captureReceiveSequence_ += static_cast<std::uint32_t>(size);
+    }
+}
+
+
 //=============================================================================
 template <bcpp::network::network_transport_protocol P>
 void bcpp::network::active_socket_impl<P>::destroy
@@ -403,11 +1391,16 @@ void bcpp::network::active_socket_impl<P>::destroy
 {
     if (receiveContract_.is_valid())
     {
-        // remove this socket from the poller 
+        // stop delivering to the owner immediately.  then remove this socket 
+        // from the poller and release the receive contract (the release is 
+        // performed in a batch by the polling thread)
+        closing_.store(true, std::memory_order_release);
         disconnect();
+        cancel_timers();
         if (auto poller = poller_.lock(); poller)
-            poller->unregister_socket(*this);        
-        receiveContract_.release();
+            poller->release_socket(*this);
+        else
+            receiveContract_.release();
     }    
     else
     {
@@ -415,9 +1408,19 @@ void bcpp::network::active_socket_impl<P>::destroy
         {
             sendContract_.release();
         }
+        else if (activityTimerContract_.is_valid())
+        {
+            activityTimerContract_.release();
+        }
         else
         {
-
+            cancel_timers(); // either timer could have re-armed prior to the release of its contract
+            for (auto * pending = zeroCopyPending_.front(); pending != nullptr; pending = zeroCopyPending_.front())
+            {
+                // the kernel will never report the completion of these to this socket
+                pending->sendInfo_.sendToken_((pending->errorCode_ != 0) ? pending->errorCode_ : ECANCELED);
+                zeroCopyPending_.discard();
+            }
             delete this;
         }
     }
@@ -430,6 +1433,8 @@ bool bcpp::network::active_socket_impl<P>::is_connected
 (
 ) const noexcept
 {
+    if constexpr (unix_concept<P>)
+        return unixPeerConnected_;
     return (peerSocketAddress_.is_valid());
 }
 
@@ -453,7 +1458,8 @@ auto bcpp::network::active_socket_impl<P>::get_peer_name
     ::sockaddr_in socketAddress;
     socketAddress.sin_family = AF_INET;
     ::socklen_t sizeofSocketAddress(sizeof(socketAddress));
-    if (::getpeername(fileDescriptor_.get(), (struct sockaddr *)&socketAddress, &sizeofSocketAddress) == 0)
+    if ((::getpeername(fileDescriptor_.get(), (struct sockaddr *)&socketAddress, &sizeofSocketAddress) == 0) && 
+            (socketAddress.sin_family == AF_INET))
         return {socketAddress};
     return {};
 }
@@ -464,4 +1470,12 @@ namespace bcpp::network
 {
     template class socket_impl<tcp_socket_traits>;
     template class socket_impl<udp_socket_traits>;
+    template class socket_impl<unix_stream_socket_traits>;
+    template class socket_impl<unix_seqpacket_socket_traits>;
+
+    // pooled blocks are only guaranteed block_alignment
+    static_assert(alignof(socket_impl<tcp_socket_traits>) <= socket_impl_allocator::block_alignment);
+    static_assert(alignof(socket_impl<udp_socket_traits>) <= socket_impl_allocator::block_alignment);
+    static_assert(alignof(socket_impl<unix_stream_socket_traits>) <= socket_impl_allocator::block_alignment);
+    static_assert(alignof(socket_impl<unix_seqpacket_socket_traits>) <= socket_impl_allocator::block_alignment);
 }
@@ -3,11 +3,14 @@
 #include "./socket_base_impl.h"
 
 #include <library/network/socket/socket.h>
+#include <library/network/socket/unix_socket_path.h>
+#include <library/network/capture/packet_capture.h>
 #include <library/network/poller/poller.h>
 #include <library/network/packet/packet.h>
+#include <library/network/queue/fixed_queue.h>
+#include <library/network/timer/timer_wheel.h>
 
 #include <include/io_mode.h>
-#include <include/spsc_fixed_queue.h>
 #include <library/system.h>
 
 #include <functional>
@@ -15,6 +18,13 @@
 #include <span>
 #include <tuple>
 #include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include <memory>
+
+#include <sys/socket.h>
+#include <sys/types.h>
 
 
 namespace bcpp::network
@@ -36,27 +46,63 @@ namespace bcpp::network
             using receive_error_handler = std::function<void(socket_id, std::int32_t)>;
             using hang_up_handler = std::function<void(socket_id)>;
             using peer_hang_up_handler = std::function<void(socket_id)>;
+            using send_queue_high_handler = std::function<void(socket_id)>;
+            using send_queue_drained_handler = std::function<void(socket_id)>;
+            using send_error_handler = std::function<void(socket_id, std::int32_t)>;
+            using idle_timeout_handler = std::function<void(socket_id)>;
+            using heartbeat_handler = std::function<void(socket_id)>;
+            using multicast_receive_handler = std::function<void(socket_id, packet, socket_address, ip_address)>;
+            using segmented_receive_handler = std::function<void(socket_id, packet, socket_address, std::size_t)>;
 
             receive_handler             receiveHandler_;
             receive_error_handler       receiveErrorHandler_;
             packet_allocation_handler   packetAllocationHandler_;
             hang_up_handler             hangUpHandler_;
             peer_hang_up_handler        peerHangUpHandler_;
+            send_queue_high_handler     sendQueueHighHandler_;
+            send_queue_drained_handler  sendQueueDrainedHandler_;
+            send_error_handler          sendErrorHandler_;
+            idle_timeout_handler        idleTimeoutHandler_;
+            heartbeat_handler           heartbeatHandler_;
+            multicast_receive_handler   multicastReceiveHandler_;
+            segmented_receive_handler   segmentedReceiveHandler_;
         };
 
         struct configuration
         {
-            static auto constexpr default_send_queue_capacity = ((1 << 20));//((1 << 10) * 8);
+            // every slot of the send queue is allocated (and zeroed) as the socket 
+            // is created so the default is kept modest.  high throughput senders 
+            // should configure a larger queue.
+            static auto constexpr default_send_queue_capacity = ((1 << 10) * 8);
 
             std::size_t     socketReceiveBufferSize_{0};
             std::size_t     socketSendBufferSize_{0};
             std::size_t     readBufferSize_{0};
             std::size_t     sendQueueSize_{default_send_queue_capacity};
+            producer_mode   sendQueueProducerMode_{producer_mode::single_producer};
+            std::size_t     sendQueueHighWatermarkBytes_{0};
+            std::size_t     sendQueueLowWatermarkBytes_{0};
+            std::size_t     sendQueueHighWatermarkPackets_{0};
+            std::size_t     sendQueueLowWatermarkPackets_{0};
             system::io_mode ioMode_{system::io_mode::read_write};
+            bool            reusePort_{false};
+
+            // tcp specific (other than zero copy these also apply to unix domain sockets)
+            std::size_t                 sendCoalescingSize_{0};
+            std::chrono::nanoseconds    sendCoalescingDelay_{0};
+            std::chrono::nanoseconds    idleTimeout_{0};
+            std::chrono::nanoseconds    heartbeatInterval_{0};
+            std::size_t                 zeroCopyThreshold_{0};
 
             // udp specific
             std::uint32_t   ttl_{0};
             std::uint32_t   multicastTtl_{0};
+            ip_address      multicastInterface_{};
+            bool            multicastLoop_{true};
+            std::uint16_t   sendSegmentSize_{0};
+
+            // tcp and udp only
+            std::shared_ptr<packet_capture>  packetCapture_{};
         };
 
         socket_impl
@@ -66,8 +112,9 @@ namespace bcpp::network
             event_handlers const &,
             work_contract_group &,
             work_contract_group &,
-            std::shared_ptr<poller> const &
-        );
+            std::shared_ptr<poller> const &,
+            std::shared_ptr<timer_wheel> const &
+        ) requires (!unix_concept<P>);
 
         socket_impl
         (
@@ -76,8 +123,20 @@ namespace bcpp::network
             event_handlers const &,
             work_contract_group &,
             work_contract_group &,
-            std::shared_ptr<poller> const &
-        ) requires (tcp_concept<P>);
+            std::shared_ptr<poller> const &,
+            std::shared_ptr<timer_wheel> const &
+        ) requires (connection_concept<P>);
+
+        socket_impl
+        (
+            unix_socket_path,
+            configuration const &,
+            event_handlers const &,
+            work_contract_group &,
+            work_contract_group &,
+            std::shared_ptr<poller> const &,
+            std::shared_ptr<timer_wheel> const &
+        ) requires (unix_concept<P>);
 
         virtual ~socket_impl() = default;
 
@@ -105,14 +164,27 @@ namespace bcpp::network
             send_completion_token
         ) requires (udp_concept<P>);
 
+        bool send_file
+        (
+            std::int32_t,
+            std::uint64_t,
+            std::size_t,
+            send_completion_token
+        ) requires (stream_concept<P>);
+
         connect_result connect_to
         (
             socket_address const &
-        ) noexcept;
+        ) noexcept requires (!unix_concept<P>);
+
+        connect_result connect_to
+        (
+            unix_socket_path const &
+        ) noexcept requires (unix_concept<P>);
 
         void receive() requires (udp_concept<P>);
 
-        void receive() requires (tcp_concept<P>);
+        void receive() requires (connection_concept<P>);
 
         void destroy();
 
@@ -125,24 +197,154 @@ namespace bcpp::network
             ip_address
         ) requires (udp_concept<P>);
 
+        connect_result join
+        (
+            ip_address,
+            ip_address
+        ) requires (udp_concept<P>);
+
+        bool leave
+        (
+            ip_address
+        ) requires (udp_concept<P>);
+
+        bool leave
+        (
+            ip_address,
+            ip_address
+        ) requires (udp_concept<P>);
+
     private:
 
+        // region of a file to be sent via sendfile (tcp only).  the file descriptor
+        // is owned by the caller.
+        struct file_segment
+        {
+            std::int32_t                fileDescriptor_{-1};
+            std::uint64_t               offset_{0};
+            std::size_t                 length_{0};
+        };
+
+        struct send_info 
+        {
+            send_info() = default;
+            send_info(packet p, send_completion_token sendCompletionToken, socket_address destination):
+                packet_(std::move(p)), sendToken_(sendCompletionToken), destination_(destination){}
+            send_info(file_segment fileSegment, send_completion_token sendCompletionToken):
+                sendToken_(sendCompletionToken), fileSegment_(fileSegment){}
+            send_info(send_info &&) = default;
+            send_info & operator = (send_info &&) = default;
+
+            packet                      packet_;
+            send_completion_token       sendToken_;
+            socket_address              destination_;
+            file_segment                fileSegment_;
+        };
+
         socket_address get_peer_name() const noexcept;
 
         bool disconnect();
 
+        bool set_multicast_membership
+        (
+            ip_address,
+            ip_address,
+            bool
+        ) requires (udp_concept<P>);
+
+        void receive_message() requires (udp_concept<P>);
+
+        ::ssize_t receive_time_stamped
+        (
+            void *,
+            std::size_t,
+            ::sockaddr_in *,
+            std::uint64_t &
+        );
+
+        void capture
+        (
+            capture_direction,
+            void const *,
+            std::size_t,
+            socket_address,
+            std::uint64_t
+        ) noexcept;
+
         std::uint32_t get_bytes_available() const noexcept;
 
         void on_hang_up() override;
 
         void on_peer_hang_up() override;
 
+        void on_poll_error() override;
+
+        void drain_zero_copy_completions() requires (tcp_concept<P>);
+
+        void complete_zero_copy_sends
+        (
+            std::uint32_t,
+            std::uint32_t
+        ) requires (tcp_concept<P>);
+
+        bool is_zero_copy_send_complete
+        (
+            std::uint32_t
+        ) const noexcept;
+
         void execute_next_send();
 
+        void execute_next_coalesced_send() requires (connection_concept<P>);
+
+        void on_send_error
+        (
+            std::int32_t
+        );
+
+        void fail_queued_sends
+        (
+            std::int32_t
+        );
+
+        bool enqueue_send
+        (
+            send_info &&
+        );
+
+        void execute_next_file_send() requires (connection_concept<P>);
+
+        void on_send_queue_high();
+
+        void on_send_queue_consumed
+        (
+            std::size_t,
+            std::size_t
+        );
+
+        bool is_below_low_watermark
+        (
+            std::size_t,
+            std::size_t
+        ) const noexcept;
+
+        void start_activity_timer
+        (
+            work_contract_group &
+        ) requires (connection_concept<P>);
+
+        void on_activity_timer() requires (connection_concept<P>);
+
+        void cancel_timers();
+
+        static std::int64_t get_activity_time();
+
         std::size_t                                         readBufferSize_;
 
         socket_address                                      peerSocketAddress_;
 
+        // unix domain peers have no socket_address (and are typically unnamed)
+        bool                                                unixPeerConnected_{false};
+
         std::weak_ptr<poller>                               poller_;
 
         typename event_handlers::receive_handler            receiveHandler_;
@@ -155,25 +357,128 @@ namespace bcpp::network
 
         event_handlers::peer_hang_up_handler                peerHangUpHandler_;
 
-        struct send_info 
+        event_handlers::send_queue_high_handler             sendQueueHighHandler_;
+
+        event_handlers::send_queue_drained_handler          sendQueueDrainedHandler_;
+
+        event_handlers::send_error_handler                  sendErrorHandler_;
+
+        event_handlers::idle_timeout_handler                idleTimeoutHandler_;
+
+        event_handlers::heartbeat_handler                   heartbeatHandler_;
+
+        typename event_handlers::multicast_receive_handler  multicastReceiveHandler_;
+
+        typename event_handlers::segmented_receive_handler  segmentedReceiveHandler_;
+
+        // multicast groups joined by this socket (udp only).  a source which is 
+        // not valid indicates an any source membership.
+        struct multicast_membership
         {
-            send_info() = default;
-            send_info(packet p, send_completion_token sendCompletionToken, socket_address destination):
-                packet_(std::move(p)), sendToken_(sendCompletionToken), destination_(destination){}
-            send_info(send_info &&) = default;
-            send_info & operator = (send_info &&) = default;
+            ip_address  group_;
+            ip_address  source_;
+        };
 
-            packet                      packet_;
-            send_completion_token       sendToken_;
-            socket_address              destination_;
+        std::vector<multicast_membership>                   multicastMemberships_;
+
+        ip_address                                          multicastInterface_;
+
+        fixed_queue<send_info>                              sendQueue_;
+
+        // the error which broke the connection or which followed the closing of 
+        // the socket (send contract only).  once set, queued sends are failed with 
+        // it rather than attempted.
+        std::int32_t                                        sendBrokenErrorCode_{0};
+
+        // MSG_ZEROCOPY (tcp only.  zero threshold disables).  packets which were sent
+        // with MSG_ZEROCOPY remain pinned (along with their completion token) until 
+        // the kernel reports completion of the last send which referenced them via
+        // the socket's error queue.  sends are identified by a per socket counter
+        // which the kernel increments for each successful MSG_ZEROCOPY send.  pinned
+        // sends are held in a ring with the capacity of the send queue (allocated only 
+        // if zero copy is enabled).  packets are copied rather than sent with 
+        // MSG_ZEROCOPY while the ring is full.  a packet which was partially sent
+        // when a later send failed is also held (until completion) and its token is
+        // then failed.  any which remain pinned when the socket is destroyed are 
+        // completed with ECANCELED (or their send's error).
+        struct zero_copy_send
+        {
+            std::uint32_t   lastSendId_;
+            send_info       sendInfo_;
+            std::int32_t    errorCode_{0};  // the token is failed with this upon completion if non zero
         };
 
-        spsc_fixed_queue<send_info>                         sendQueue_;
+        std::size_t                                         zeroCopyThreshold_;
+
+        std::uint32_t                                       zeroCopyNextSendId_{0};
+
+        std::uint32_t                                       zeroCopyCompletedSendId_{0};
+
+        bool                                                zeroCopyAnyCompleted_{false};
+
+        bool                                                frontIsZeroCopy_{false};
+
+        std::uint32_t                                       frontZeroCopySendId_{0};
+
+        fixed_queue<zero_copy_send>                         zeroCopyPending_;
+
+        std::atomic<std::uint32_t>                          zeroCopyInFlight_{0};
+
+        // send queue watermarks (zero disables the watermark)
+        std::size_t                                         sendQueueHighWatermarkBytes_;
+
+        std::size_t                                         sendQueueLowWatermarkBytes_;
+
+        std::size_t                                         sendQueueHighWatermarkPackets_;
+
+        std::size_t                                         sendQueueLowWatermarkPackets_;
+
+        std::atomic<std::size_t>                            sendQueueBytes_{0};
+
+        std::atomic<std::size_t>                            sendQueuePackets_{0};
+
+        std::atomic<bool>                                   sendQueueHigh_{false};
+
+        // send coalescing (zero size disables coalescing)
+        std::size_t                                         sendCoalescingSize_;
+
+        std::chrono::nanoseconds                            sendCoalescingDelay_;
+
+        std::chrono::steady_clock::time_point               sendCoalescingDeadline_{};
 
         work_contract                                  sendContract_;
 
+        // armed (on the timer wheel below) for the coalescing deadline.  its
+        // expiry schedules the send contract.
+        timer_wheel_entry                                   sendCoalescingTimerEntry_{sendContract_};
+
+        // idle timeout and heartbeat (tcp only.  zero disables).  activity times are
+        // recorded without touching the timer.  the single activity timer is re-armed
+        // lazily on expiry for whichever of the two deadlines is next.
+        std::chrono::nanoseconds                            idleTimeout_;
+
+        std::chrono::nanoseconds                            heartbeatInterval_;
+
+        std::atomic<std::int64_t>                           lastReceiveTime_{0};
+
+        std::atomic<std::int64_t>                           lastSendTime_{0};
+
+        std::weak_ptr<timer_wheel>                          timerWheel_;
+
+        work_contract                                       activityTimerContract_;
+
+        timer_wheel_entry                                   activityTimerEntry_{activityTimerContract_};
+
         packet                                              pendingReceivePacket_;
 
+        // packet capture (null unless configured).  the sequence numbers are the
+        // running byte counts of each direction (tcp only).
+        std::shared_ptr<packet_capture>                     packetCapture_;
+
+        std::uint32_t                                       captureReceiveSequence_{0};
+
+        std::uint32_t                                       captureSendSequence_{0};
+
     }; // class socket_impl<socket_traits<P, socket_type::active>>
 
 
@@ -183,5 +488,7 @@ namespace bcpp::network
 
     using tcp_socket_impl = active_socket_impl<network_transport_protocol::tcp>;
     using udp_socket_impl = active_socket_impl<network_transport_protocol::udp>;
+    using unix_stream_socket_impl = active_socket_impl<network_transport_protocol::unix_stream>;
+    using unix_seqpacket_socket_impl = active_socket_impl<network_transport_protocol::unix_seqpacket>;
 
 } // namespace bcpp::network
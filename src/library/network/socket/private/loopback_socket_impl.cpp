@@ -0,0 +1,217 @@
+#include "./loopback_socket_impl.h"
+#include <library/network/loopback/loopback_registry.h>
+
+#include <cerrno>
+
+
+//=============================================================================
+bcpp::network::loopback_socket_impl::socket_impl
+(
+    socket_address socketAddress,
+    configuration const & config,
+    event_handlers const & eventHandlers,
+    work_contract_group & sendWorkContractGroup,
+    work_contract_group & receiveWorkContractGroup
+) :
+    closeHandler_(eventHandlers.closeHandler_),
+    receiveHandler_(eventHandlers.receiveHandler_),
+    sendErrorHandler_(eventHandlers.sendErrorHandler_),
+    receiveBatchSize_(config.receiveBatchSize_ ? config.receiveBatchSize_ : default_receive_batch_size),
+    sendQueue_(config.sendQueueSize_ ? config.sendQueueSize_ : configuration::default_send_queue_capacity, config.sendQueueProducerMode_),
+    receiveQueue_(config.receiveQueueSize_ ? config.receiveQueueSize_ : configuration::default_receive_queue_capacity, producer_mode::multi_producer),
+    sendContract_(sendWorkContractGroup.create_contract([this](){this->execute_next_send();}, [this](){this->destroy();})),
+    receiveContract_(receiveWorkContractGroup.create_contract([this](){this->receive();}, [this](){this->destroy();}))
+{
+    // bind last so that no packet can be delivered to a partially constructed socket.
+    // if the address is already in use the socket is left invalid (closed)
+    socketAddress_ = loopback_registry::get().add(socketAddress, *this);
+    closed_ = (!socketAddress_.get_port_id().is_valid());
+}
+
+
+//=============================================================================
+bool bcpp::network::loopback_socket_impl::connect_to
+(
+    // set the default destination for send.  no handshake takes place so the
+    // destination need not exist (yet).  call prior to sending.
+    socket_address socketAddress
+)
+{
+    if (closed_)
+        return false;
+    peerSocketAddress_ = socketAddress;
+    return true;
+}
+
+
+//=============================================================================
+bool bcpp::network::loopback_socket_impl::send
+(
+    packet && data,
+    send_completion_token sendCompletionToken
+)
+{
+    return send_to(peerSocketAddress_, std::move(data), std::move(sendCompletionToken));
+}
+
+
+//=============================================================================
+bool bcpp::network::loopback_socket_impl::send_to
+(
+    socket_address destination,
+    packet && data,
+    send_completion_token sendCompletionToken
+)
+{
+    if (closed_)
+        return false;
+    if (!sendQueue_.emplace(std::move(data), destination, std::move(sendCompletionToken)))
+        return false;
+    sendContract_.schedule();
+    return true;
+}
+
+
+//=============================================================================
+void bcpp::network::loopback_socket_impl::execute_next_send
+(
+    // hand the packet at the front of the send queue to the destination socket.
+    // as with udp, a missing destination (or a full receive queue) fails the
+    // send rather than blocking.
+)
+{
+    if (auto * next = sendQueue_.front(); next != nullptr)
+    {
+        if (loopback_registry::get().deliver(next->address_, socketAddress_, std::move(next->packet_)))
+        {
+            next->sendCompletionToken_();
+        }
+        else
+        {
+            next->sendCompletionToken_(ECONNREFUSED);
+            if (sendErrorHandler_)
+                sendErrorHandler_(id_, ECONNREFUSED);
+        }
+        if (sendQueue_.discard() > 0)
+            sendContract_.schedule();
+    }
+}
+
+
+//=============================================================================
+bool bcpp::network::loopback_socket_impl::deliver
+(
+    // invoked by the registry on the sender's thread.  the packet is only moved
+    // from if the receive queue has room for it.
+    socket_address source,
+    packet && data
+)
+{
+    if (!receiveQueue_.emplace(std::move(data), source, send_completion_token{}))
+        return false;
+    receiveContract_.schedule();
+    return true;
+}
+
+
+//=============================================================================
+void bcpp::network::loopback_socket_impl::receive
+(
+)
+{
+    for (std::size_t i = 0; i < receiveBatchSize_; ++i)
+    {
+        auto * next = receiveQueue_.front();
+        if (next == nullptr)
+            return;
+        if (receiveHandler_)
+            receiveHandler_(id_, std::move(next->packet_), next->address_);
+        receiveQueue_.discard();
+    }
+    if (!receiveQueue_.empty())
+        receiveContract_.schedule();
+}
+
+
+//=============================================================================
+bool bcpp::network::loopback_socket_impl::close
+(
+)
+{
+    if (closed_.exchange(true))
+        return false;
+    loopback_registry::get().remove(socketAddress_);
+    if (closeHandler_)
+        closeHandler_(id_);
+    return true;
+}
+
+
+//=============================================================================
+bool bcpp::network::loopback_socket_impl::is_valid
+(
+) const noexcept
+{
+    return (!closed_);
+}
+
+
+//=============================================================================
+bool bcpp::network::loopback_socket_impl::is_connected
+(
+) const noexcept
+{
+    return ((!closed_) && (peerSocketAddress_.get_port_id().is_valid()));
+}
+
+
+//=============================================================================
+auto bcpp::network::loopback_socket_impl::get_socket_address
+(
+) const noexcept -> socket_address
+{
+    return socketAddress_;
+}
+
+
+//=============================================================================
+auto bcpp::network::loopback_socket_impl::get_peer_socket_address
+(
+) const noexcept -> socket_address
+{
+    return peerSocketAddress_;
+}
+
+
+//=============================================================================
+auto bcpp::network::loopback_socket_impl::get_id
+(
+) const noexcept -> socket_id
+{
+    return id_;
+}
+
+
+//=============================================================================
+void bcpp::network::loopback_socket_impl::destroy
+(
+    // use the work contracts to asynchronously delete 'this'.
+    // removing the socket from the registry first guarantees that
+    // no sender can schedule the receive contract once released.
+)
+{
+    if (receiveContract_.is_valid())
+    {
+        if (!closed_.exchange(true))
+            loopback_registry::get().remove(socketAddress_);
+        receiveContract_.release();
+    }
+    else if (sendContract_.is_valid())
+    {
+        sendContract_.release();
+    }
+    else
+    {
+        delete this;
+    }
+}
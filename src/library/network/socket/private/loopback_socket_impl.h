@@ -0,0 +1,152 @@
+#pragma once
+
+#include <library/network/socket/socket.h>
+#include <library/network/socket/send_completion_token.h>
+#include <library/network/ip/socket_address.h>
+#include <library/network/packet/packet.h>
+#include <library/network/queue/fixed_queue.h>
+#include <library/network/queue/producer_mode.h>
+
+#include <library/work_contract.h>
+
+#include <include/non_copyable.h>
+#include <include/non_movable.h>
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    // datagram transport which never leaves the process.  packets are moved
+    // (never copied) from the sender's send queue directly into the receive
+    // queue of the socket bound at the destination address.  there is no
+    // file descriptor and therefore no poller registration.  the receive
+    // contract is scheduled by the sender upon delivery.
+    template <>
+    class socket_impl<loopback_socket_traits> :
+        non_copyable,
+        non_movable
+    {
+    public:
+
+        using traits = loopback_socket_traits;
+
+        static auto constexpr default_receive_batch_size = 64;
+
+        struct event_handlers
+        {
+            using close_handler = std::function<void(socket_id)>;
+            using receive_handler = std::function<void(socket_id, packet, socket_address)>;
+            using send_error_handler = std::function<void(socket_id, std::int32_t)>;
+
+            close_handler               closeHandler_;
+            receive_handler             receiveHandler_;
+            send_error_handler          sendErrorHandler_;
+        };
+
+        struct configuration
+        {
+            static auto constexpr default_send_queue_capacity = 1024;
+            static auto constexpr default_receive_queue_capacity = 1024;
+
+            std::size_t     sendQueueSize_{default_send_queue_capacity};
+            producer_mode   sendQueueProducerMode_{producer_mode::single_producer};
+            std::size_t     receiveQueueSize_{default_receive_queue_capacity};
+            std::size_t     receiveBatchSize_{default_receive_batch_size};
+        };
+
+        socket_impl
+        (
+            socket_address,
+            configuration const &,
+            event_handlers const &,
+            work_contract_group &,
+            work_contract_group &
+        );
+
+        bool send
+        (
+            packet &&,
+            send_completion_token
+        );
+
+        bool send_to
+        (
+            socket_address,
+            packet &&,
+            send_completion_token
+        );
+
+        bool connect_to
+        (
+            socket_address
+        );
+
+        bool deliver
+        (
+            socket_address,
+            packet &&
+        );
+
+        bool close();
+
+        bool is_valid() const noexcept;
+
+        bool is_connected() const noexcept;
+
+        socket_address get_socket_address() const noexcept;
+
+        socket_address get_peer_socket_address() const noexcept;
+
+        socket_id get_id() const noexcept;
+
+        void destroy();
+
+    private:
+
+        struct datagram
+        {
+            packet                  packet_;
+            socket_address          address_;
+            send_completion_token   sendCompletionToken_;
+        };
+
+        void execute_next_send();
+
+        void receive();
+
+        socket_id                                           id_;
+
+        event_handlers::close_handler                       closeHandler_;
+
+        event_handlers::receive_handler                     receiveHandler_;
+
+        event_handlers::send_error_handler                  sendErrorHandler_;
+
+        socket_address                                      socketAddress_;
+
+        socket_address                                      peerSocketAddress_;
+
+        std::size_t                                         receiveBatchSize_;
+
+        fixed_queue<datagram>                               sendQueue_;
+
+        // any number of loopback sockets can deliver to this one concurrently
+        fixed_queue<datagram>                               receiveQueue_;
+
+        std::atomic<bool>                                   closed_{false};
+
+        work_contract                                       sendContract_;
+
+        work_contract                                       receiveContract_;
+
+    }; // class socket_impl<loopback_socket_traits>
+
+
+    using loopback_socket_impl = socket_impl<loopback_socket_traits>;
+
+} // namespace bcpp::network
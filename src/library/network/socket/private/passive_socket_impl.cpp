@@ -1,15 +1,22 @@
 #include "./passive_socket_impl.h"
 
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <string>
+
 
 //=============================================================================
-bcpp::network::passive_socket_impl::socket_impl
+template <bcpp::network::network_transport_protocol P>
+bcpp::network::passive_socket_impl<P>::socket_impl
 (
     socket_address socketAddress,
     configuration const & config,
     event_handlers const & eventHandlers,
     work_contract_group & workContractGroup,
     std::shared_ptr<poller> & p
-) :    
+) requires (tcp_concept<P>) :
     socket_base_impl(socketAddress, {.ioMode_ = config.ioMode_}, eventHandlers, ::socket(PF_INET, SOCK_STREAM, IPPROTO_TCP),
             workContractGroup.create_contract([this](){this->accept();}, [this](){this->destroy();})),
     poller_(p),
@@ -21,41 +28,82 @@ bcpp::network::passive_socket_impl::socket_impl
 
 
 //=============================================================================
-void bcpp::network::passive_socket_impl::accept
+template <bcpp::network::network_transport_protocol P>
+bcpp::network::passive_socket_impl<P>::socket_impl
+(
+    unix_socket_path unixSocketPath,
+    configuration const & config,
+    event_handlers const & eventHandlers,
+    work_contract_group & workContractGroup,
+    std::shared_ptr<poller> & p
+) requires (unix_concept<P>) :
+    socket_base_impl(unixSocketPath, {.ioMode_ = config.ioMode_}, eventHandlers,
+            ::socket(PF_UNIX, (P == network_transport_protocol::unix_stream) ? SOCK_STREAM : SOCK_SEQPACKET, 0),
+            workContractGroup.create_contract([this](){this->accept();}, [this](){this->destroy();})),
+    poller_(p),
+    acceptHandler_(eventHandlers.acceptHandler_),
+    unixSocketPath_(unixSocketPath)
+{
+    p->register_socket(*this);
+    ::listen(fileDescriptor_.get(), config.backlog_);
+}
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+void bcpp::network::passive_socket_impl<P>::accept
 (
 )
 {
-    ::sockaddr address;
+    if (!on_receive_executed())
+        return;
+    ::sockaddr_storage address;
     socklen_t addressLength = sizeof(address);
-    system::file_descriptor fileDescriptor(::accept(fileDescriptor_.get(), &address, &addressLength));
+    system::file_descriptor fileDescriptor(::accept(fileDescriptor_.get(), reinterpret_cast<::sockaddr *>(&address), &addressLength));
     if (fileDescriptor.is_valid())
     {
         if (acceptHandler_)
             acceptHandler_(id_, std::move(fileDescriptor));
-        on_polled(); // could be more
+        reschedule_receive(); // could be more
     }
 }
 
 
 //=============================================================================
-void bcpp::network::passive_socket_impl::destroy
+template <bcpp::network::network_transport_protocol P>
+void bcpp::network::passive_socket_impl<P>::destroy
 (
     // use the work contract to asynchronously delete 'this'.
     // doing it this way ensures that the work contract's primary
     // work can not be executed any longer just prior to deleting
-    // this.  This allows the primary work contract function to 
-    // use a raw 'this' 
+    // this.  This allows the primary work contract function to
+    // use a raw 'this'
 )
 {
     if (receiveContract_.is_valid())
     {
-        // remove this socket from the poller
+        // stop delivering to the owner immediately.  then remove this socket 
+        // from the poller and release the receive contract (the release is 
+        // performed in a batch by the polling thread)
+        closing_.store(true, std::memory_order_release);
         if (auto poller = poller_.lock(); poller)
-            poller->unregister_socket(*this);
-        receiveContract_.release();
+            poller->release_socket(*this);
+        else
+            receiveContract_.release();
     }
     else
     {
+        if ((unixSocketPath_.is_valid()) && (!unixSocketPath_.is_abstract()))
+            ::unlink(std::string(unixSocketPath_.get()).c_str());
         delete this;
     }
 }
+
+
+//=============================================================================
+namespace bcpp::network
+{
+    template class socket_impl<tcp_listener_socket_traits>;
+    template class socket_impl<unix_stream_listener_socket_traits>;
+    template class socket_impl<unix_seqpacket_listener_socket_traits>;
+}
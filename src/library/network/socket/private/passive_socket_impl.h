@@ -1,6 +1,7 @@
 #pragma once
 
 #include <library/network/socket/socket.h>
+#include <library/network/socket/unix_socket_path.h>
 #include <library/network/poller/poller.h>
 
 #include "./socket_base_impl.h"
@@ -15,13 +16,13 @@
 namespace bcpp::network
 {
 
-    template <>
-    class socket_impl<tcp_listener_socket_traits> :
+    template <network_transport_protocol P>
+    class socket_impl<socket_traits<P, socket_type::passive>> :
         public socket_base_impl
     {
     public:
 
-        using traits = tcp_listener_socket_traits;
+        using traits = socket_traits<P, socket_type::passive>;
 
         struct event_handlers : socket_base_impl::event_handlers
         {
@@ -43,7 +44,16 @@ namespace bcpp::network
             event_handlers const &,
             work_contract_group &,
             std::shared_ptr<poller> &
-        );
+        ) requires (tcp_concept<P>);
+
+        socket_impl
+        (
+            unix_socket_path,
+            configuration const &,
+            event_handlers const &,
+            work_contract_group &,
+            std::shared_ptr<poller> &
+        ) requires (unix_concept<P>);
 
         void destroy();
 
@@ -55,10 +65,16 @@ namespace bcpp::network
 
         typename event_handlers::accept_handler     acceptHandler_;
 
-    }; // namespace socket_impl<tcp_listener_socket_traits> 
+        // the path to which a unix domain listener is bound.  removed on destroy.
+        unix_socket_path                            unixSocketPath_;
+
+    }; // namespace socket_impl<socket_traits<P, socket_type::passive>>
 
-    using passive_socket_impl = socket_impl<tcp_listener_socket_traits>;
+    template <network_transport_protocol P>
+    using passive_socket_impl = socket_impl<socket_traits<P, socket_type::passive>>;
 
-    using tcp_listener_socket_impl = socket_impl<tcp_listener_socket_traits>;
+    using tcp_listener_socket_impl = passive_socket_impl<network_transport_protocol::tcp>;
+    using unix_stream_listener_socket_impl = passive_socket_impl<network_transport_protocol::unix_stream>;
+    using unix_seqpacket_listener_socket_impl = passive_socket_impl<network_transport_protocol::unix_seqpacket>;
 
 } // namespace bcpp::network
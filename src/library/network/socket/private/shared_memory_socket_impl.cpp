@@ -0,0 +1,151 @@
+#include "./shared_memory_socket_impl.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <array>
+#include <stdexcept>
+
+
+//=============================================================================
+bcpp::network::shared_memory_socket_impl::socket_impl
+(
+    std::string name,
+    configuration const & config,
+    event_handlers const & eventHandlers,
+    work_contract_group & receiveWorkContractGroup,
+    std::shared_ptr<poller> const & p
+) :
+    socket_base_impl({}, eventHandlers, ::socket(PF_UNIX, SOCK_DGRAM, 0),
+            receiveWorkContractGroup.create_contract([this](){this->receive();}, [this](){this->destroy();})),
+    poller_(p),
+    receiveHandler_(eventHandlers.receiveHandler_),
+    mode_(config.mode_),
+    spin_(config.spin_),
+    receiveBatchSize_(config.receiveBatchSize_ ? config.receiveBatchSize_ : default_receive_batch_size)
+{
+    if ((name.empty()) || (name.front() != '/'))
+        name = ('/' + name); // posix shared memory names begin with a single slash
+    doorBellPath_ = get_door_bell_path(name);
+
+    switch (mode_)
+    {
+        case shared_memory_mode::receive:
+        {
+            ring_ = shared_memory_ring::create(name, config.ring_);
+            bind(doorBellPath_);
+            p->register_socket(*this);
+            receiveContract_.schedule(); // collect anything published before registration (and start spinning)
+            break;
+        }
+        case shared_memory_mode::send:
+        {
+            ring_ = shared_memory_ring::attach(name);
+            break;
+        }
+        default:
+        {
+            throw std::runtime_error("invalid shared memory mode");
+        }
+    }
+}
+
+
+//=============================================================================
+auto bcpp::network::shared_memory_socket_impl::get_door_bell_path
+(
+    std::string const & name
+) -> unix_socket_path
+{
+    return unix_socket_path(std::string(1, unix_socket_path::abstract_prefix) + "bcpp_network_shm" + name);
+}
+
+
+//=============================================================================
+bool bcpp::network::shared_memory_socket_impl::send
+(
+    // the message is copied into the ring immediately so the completion token
+    // is invoked before send returns.  returns false if the ring is full or if
+    // the packet is larger than the ring's slots.
+    packet && data,
+    send_completion_token sendCompletionToken
+)
+{
+    if ((!ring_.is_valid()) || (!ring_.push(data)))
+        return false;
+    if (ring_.take_wake_up_request())
+        ring_door_bell();
+    sendCompletionToken();
+    return true;
+}
+
+
+//=============================================================================
+void bcpp::network::shared_memory_socket_impl::ring_door_bell
+(
+)
+{
+    static char constexpr door_bell = 0;
+    ::sockaddr_un sockAddrUn = doorBellPath_;
+    ::sendto(fileDescriptor_.get(), &door_bell, sizeof(door_bell), MSG_DONTWAIT | MSG_NOSIGNAL,
+            reinterpret_cast<::sockaddr const *>(&sockAddrUn), doorBellPath_.get_socket_address_length());
+}
+
+
+//=============================================================================
+void bcpp::network::shared_memory_socket_impl::receive
+(
+    // deliver up to one batch of messages.  each packet refers to the message in
+    // place within the ring and is only valid for the duration of the receive
+    // handler.  the slot is released back to the producers once the handler returns.
+)
+{
+    if (!on_receive_executed())
+        return;
+    for (std::size_t i = 0; i < receiveBatchSize_; ++i)
+    {
+        auto message = ring_.front();
+        if (message.data() == nullptr)
+            break;
+        if (receiveHandler_)
+            receiveHandler_(id_, packet(message), socket_address{});
+        ring_.discard();
+    }
+
+    if (!spin_)
+    {
+        // drain the door bell before requesting another wake up so that the next
+        // ring produces a fresh (edge triggered) event
+        std::array<char, 64> doorBells;
+        while (::recv(fileDescriptor_.get(), doorBells.data(), doorBells.size(), MSG_DONTWAIT) > 0)
+            ;
+        if (ring_.request_wake_up())
+            return; // idle until the door bell rings
+    }
+    receiveContract_.schedule();
+}
+
+
+//=============================================================================
+void bcpp::network::shared_memory_socket_impl::destroy
+(
+    // use the work contract to asynchronously delete 'this'.
+    // doing it this way ensures that the work contract's primary
+    // work can not be executed any longer just prior to deleting
+    // this.  This allows the primary work contract function to
+    // use a raw 'this'
+)
+{
+    if (receiveContract_.is_valid())
+    {
+        closing_.store(true, std::memory_order_release); // stop delivering to the owner immediately
+        if (auto poller = poller_.lock(); (poller) && (mode_ == shared_memory_mode::receive))
+            poller->release_socket(*this);
+        else
+            receiveContract_.release();
+    }
+    else
+    {
+        delete this;
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "./socket_base_impl.h"
+
+#include <library/network/socket/socket.h>
+#include <library/network/socket/unix_socket_path.h>
+#include <library/network/poller/poller.h>
+#include <library/network/packet/packet.h>
+#include <library/network/shared_memory/shared_memory_ring.h>
+#include <library/network/shared_memory/shared_memory_mode.h>
+
+#include <library/work_contract.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+
+
+namespace bcpp::network
+{
+
+    template <>
+    class socket_impl<shared_memory_socket_traits> :
+        public socket_base_impl
+    {
+    public:
+
+        using traits = shared_memory_socket_traits;
+
+        static auto constexpr default_receive_batch_size = 64;
+
+        struct event_handlers : socket_base_impl::event_handlers
+        {
+            using receive_handler = std::function<void(socket_id, packet, socket_address)>;
+
+            receive_handler             receiveHandler_;
+        };
+
+        struct configuration
+        {
+            shared_memory_mode                  mode_{shared_memory_mode::receive};
+            shared_memory_ring::configuration   ring_;
+            bool                                spin_{false};
+            std::size_t                         receiveBatchSize_{default_receive_batch_size};
+        };
+
+        socket_impl
+        (
+            std::string,
+            configuration const &,
+            event_handlers const &,
+            work_contract_group &,
+            std::shared_ptr<poller> const &
+        );
+
+        bool send
+        (
+            packet &&,
+            send_completion_token
+        );
+
+        void destroy();
+
+    private:
+
+        void receive();
+
+        void ring_door_bell();
+
+        static unix_socket_path get_door_bell_path
+        (
+            std::string const &
+        );
+
+        std::weak_ptr<poller>                               poller_;
+
+        event_handlers::receive_handler                     receiveHandler_;
+
+        shared_memory_mode                                  mode_;
+
+        // spin mode keeps the receive contract scheduled so the ring is polled
+        // continuously and producers never need to ring the door bell.
+        bool                                                spin_;
+
+        std::size_t                                         receiveBatchSize_;
+
+        // the door bell is a unix domain datagram socket bound (in the abstract
+        // namespace) by the receiver.  it is this socket which is registered with
+        // the poller.  producers only ring it when the receiver has requested a
+        // wake up prior to going idle.
+        unix_socket_path                                    doorBellPath_;
+
+        shared_memory_ring                                  ring_;
+
+    }; // class socket_impl<shared_memory_socket_traits>
+
+
+    using shared_memory_socket_impl = socket_impl<shared_memory_socket_traits>;
+
+} // namespace bcpp::network
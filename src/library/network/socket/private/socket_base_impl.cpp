@@ -1,4 +1,5 @@
 #include "./socket_base_impl.h"
+#include "./socket_impl_allocator.h"
 
 #include <sys/socket.h>
 #include <netinet/in.h>
@@ -10,6 +11,7 @@
 #include <cerrno>
 
 #include <cstdint>
+#include <string>
 #include <string_view>
 #include <exception>
 
@@ -30,6 +32,8 @@ bcpp::network::socket_base_impl::socket_base_impl
 {
     if (not set_socket_option(SOL_SOCKET, SO_REUSEADDR, 1))
         throw std::runtime_error("reuse address failure");
+    if ((config.reusePort_) && (not set_socket_option(SOL_SOCKET, SO_REUSEPORT, 1)))
+        throw std::runtime_error("reuse port failure");
     if (!socketAddress.is_multicast())
     {
         bind(socketAddress);
@@ -82,6 +86,37 @@ catch (std::exception const &)
 
 
 
+//=============================================================================
+bcpp::network::socket_base_impl::socket_base_impl
+(
+    // unix domain sockets which are bound to a path (listeners)
+    unix_socket_path unixSocketPath,
+    configuration const & config,
+    event_handlers const & eventHandlers,
+    system::file_descriptor fileDescriptor,
+    work_contract workContract
+) try :
+    fileDescriptor_(std::move(fileDescriptor)),
+    closeHandler_(eventHandlers.closeHandler_),
+    pollErrorHandler_(eventHandlers.pollErrorHandler_),
+    receiveContract_(std::move(workContract))
+{
+    bind(unixSocketPath);
+    if (auto success = set_synchronicity(synchronization_mode::non_blocking); !success)
+        throw std::runtime_error("set non_blocking failure");
+    if (auto success = set_io_mode(config.ioMode_); !success)
+        throw std::runtime_error("set_io_mode failure");
+}
+catch (std::exception const &)
+{
+    fileDescriptor_ = {};
+    socketAddress_ = {};
+    closeHandler_ = nullptr;
+    pollErrorHandler_ = nullptr;
+    std::rethrow_exception(std::current_exception());
+}
+
+
 //=============================================================================
 bcpp::network::socket_base_impl::~socket_base_impl
 (
@@ -91,6 +126,51 @@ bcpp::network::socket_base_impl::~socket_base_impl
 }
 
 
+//=============================================================================
+void * bcpp::network::socket_base_impl::operator new
+(
+    std::size_t size
+)
+{
+    return socket_impl_allocator::get().allocate(size);
+}
+
+
+//=============================================================================
+void bcpp::network::socket_base_impl::operator delete
+(
+    // the destructor is virtual so 'size' is that of the most derived impl
+    void * address,
+    std::size_t size
+) noexcept
+{
+    socket_impl_allocator::get().release(address, size);
+}
+
+
+//=============================================================================
+void * bcpp::network::socket_base_impl::operator new
+(
+    std::size_t size,
+    std::align_val_t alignment
+)
+{
+    return socket_impl_allocator::get().allocate(size, static_cast<std::size_t>(alignment));
+}
+
+
+//=============================================================================
+void bcpp::network::socket_base_impl::operator delete
+(
+    void * address,
+    std::size_t size,
+    std::align_val_t alignment
+) noexcept
+{
+    socket_impl_allocator::get().release(address, size, static_cast<std::size_t>(alignment));
+}
+
+
 //=============================================================================
 std::optional<std::int32_t> bcpp::network::socket_base_impl::get_socket_option
 (
@@ -108,8 +188,32 @@ std::optional<std::int32_t> bcpp::network::socket_base_impl::get_socket_option
 //=============================================================================
 void bcpp::network::socket_base_impl::on_polled
 (
+    // invoked by the poller only.  the schedule is time stamped for the 
+    // dispatch latency histogram.
+)
+{
+    if (closing_.load(std::memory_order_acquire))
+        return;
+    if (dispatchLatencyHistogram_ != nullptr)
+    {
+        // keep the earliest time stamp if already scheduled but not yet serviced
+        std::uint64_t expected = 0;
+        scheduleTime_.compare_exchange_strong(expected, read_tsc(), std::memory_order_relaxed);
+    }
+    reschedule_receive();
+}
+
+
+//=============================================================================
+void bcpp::network::socket_base_impl::reschedule_receive
+(
+    // invoked by the receive work when there could be more to receive.  not
+    // time stamped as the delay is not that of a dispatch by the poller.
 )
 {
+    if (closing_.load(std::memory_order_acquire))
+        return;
+    NETWORK_TRACE_EVENT(contract_scheduled, id_.get(), 0);
     receiveContract_.schedule();
 }
 
@@ -129,10 +233,11 @@ auto bcpp::network::socket_base_impl::get_socket_name
 (
 ) const noexcept -> socket_address
 {
-    ::sockaddr_in socketAddress;
+    ::sockaddr_storage socketAddress;
     ::socklen_t sizeofSocketAddress(sizeof(socketAddress));
-    if (::getsockname(fileDescriptor_.get(), (struct sockaddr *)&socketAddress, &sizeofSocketAddress) == 0)
-        return socketAddress;
+    if ((::getsockname(fileDescriptor_.get(), (struct sockaddr *)&socketAddress, &sizeofSocketAddress) == 0) && 
+            (socketAddress.ss_family == AF_INET)) // unix domain sockets have no socket_address
+        return *reinterpret_cast<::sockaddr_in const *>(&socketAddress);
     return {};
 }
 
@@ -153,6 +258,26 @@ void bcpp::network::socket_base_impl::bind
 }
 
 
+//=============================================================================
+void bcpp::network::socket_base_impl::bind
+(
+    // any stale file system entry left behind by a previous listener is removed
+    // first.  abstract paths are released by the kernel when the socket closes.
+    unix_socket_path const & unixSocketPath
+)
+{
+    if (!fileDescriptor_.is_valid())
+        throw std::runtime_error("invalid file descriptor");
+    if (!unixSocketPath.is_valid())
+        throw std::runtime_error("invalid unix socket path");
+    if (!unixSocketPath.is_abstract())
+        ::unlink(std::string(unixSocketPath.get()).c_str());
+    ::sockaddr_un sockAddrUn = unixSocketPath;
+    if (::bind(fileDescriptor_.get(), (sockaddr const *)&sockAddrUn, unixSocketPath.get_socket_address_length()) == -1)
+        throw std::runtime_error("bind_error");
+}
+
+
 //=============================================================================
 bool bcpp::network::socket_base_impl::close
 (
@@ -4,6 +4,10 @@
 #include <library/network/socket/connect_result.h>
 #include <library/network/poller/poller.h>
 #include <library/network/ip/socket_address.h>
+#include <library/network/instrumentation/latency_histogram.h>
+#include <library/network/instrumentation/trace.h>
+#include <library/network/instrumentation/tsc.h>
+#include <library/network/socket/unix_socket_path.h>
 #include <include/file_descriptor.h>
 #include <include/io_mode.h>
 #include <include/synchronization_mode.h>
@@ -14,7 +18,10 @@
 #include <include/non_copyable.h>
 #include <include/non_movable.h>
 
+#include <atomic>
+#include <cstddef>
 #include <functional>
+#include <new>
 #include <optional>
 
 
@@ -40,6 +47,7 @@ namespace bcpp::network
         struct configuration
         {
             system::io_mode ioMode_{system::io_mode::read_write};
+            bool            reusePort_{false};
         };
 
         socket_base_impl
@@ -59,8 +67,44 @@ namespace bcpp::network
             work_contract
         );
 
+        socket_base_impl
+        (
+            unix_socket_path,
+            configuration const &,
+            event_handlers const &,
+            system::file_descriptor,
+            work_contract
+        );
+
         virtual ~socket_base_impl();
 
+        // impls are drawn from (and returned to) the socket_impl_allocator.
+        // impls are over aligned (cache line aligned queues) so it is the
+        // aligned forms which are selected by new and delete expressions.
+        static void * operator new
+        (
+            std::size_t
+        );
+
+        static void * operator new
+        (
+            std::size_t,
+            std::align_val_t
+        );
+
+        static void operator delete
+        (
+            void *,
+            std::size_t
+        ) noexcept;
+
+        static void operator delete
+        (
+            void *,
+            std::size_t,
+            std::align_val_t
+        ) noexcept;
+
         bool close();
 
         bool is_valid() const noexcept;
@@ -115,13 +159,22 @@ namespace bcpp::network
 
         void on_polled();
 
-        void on_poll_error();
+        void reschedule_receive();
+
+        bool on_receive_executed() noexcept;
+
+        virtual void on_poll_error();
 
         void bind
         (
             socket_address const &
         );
 
+        void bind
+        (
+            unix_socket_path const &
+        );
+
         socket_address get_socket_name() const noexcept;
 
         system::file_descriptor             fileDescriptor_;
@@ -136,6 +189,17 @@ namespace bcpp::network
 
         work_contract                       receiveContract_;
 
+        // assigned by the poller upon registration if dispatch latency is instrumented
+        latency_histogram *                 dispatchLatencyHistogram_{nullptr};
+
+        // tsc at which poll scheduled the receive contract (zero once serviced)
+        std::atomic<std::uint64_t>          scheduleTime_{0};
+
+        // set by destroy.  from then on the socket is neither scheduled by poll
+        // nor does its receive work invoke any handlers (even though its release
+        // by the poller, and therefore its deletion, is asynchronous)
+        std::atomic<bool>                   closing_{false};
+
     }; // class socket_base_impl
 
 } // namespace bcpp::network
@@ -152,3 +216,22 @@ bool bcpp::network::socket_base_impl::set_socket_option
 {
     return (::setsockopt(fileDescriptor_.get(), level, optionName, &value, sizeof(value)) == 0);
 }
+
+
+//=============================================================================
+inline bool bcpp::network::socket_base_impl::on_receive_executed
+(
+    // invoked at the start of the receive contract's work.  records the time
+    // since the contract was first scheduled by poll (reschedules by the 
+    // receive work itself are not time stamped).
+    // returns false if the socket is closing (the work must do nothing).
+) noexcept
+{
+    if (closing_.load(std::memory_order_acquire))
+        return false;
+    NETWORK_TRACE_EVENT(contract_executed, id_.get(), 0);
+    if (dispatchLatencyHistogram_ != nullptr)
+        if (auto scheduleTime = scheduleTime_.exchange(0, std::memory_order_relaxed); scheduleTime != 0)
+            dispatchLatencyHistogram_->record(read_tsc() - scheduleTime);
+    return true;
+}
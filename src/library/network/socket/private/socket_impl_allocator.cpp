@@ -0,0 +1,106 @@
+#include "./socket_impl_allocator.h"
+
+#include <algorithm>
+#include <mutex>
+#include <new>
+
+
+//=============================================================================
+auto bcpp::network::socket_impl_allocator::get
+(
+    // deliberately never destroyed.  impls can be released by service threads
+    // after static destruction has begun.
+) -> socket_impl_allocator &
+{
+    static auto * socketImplAllocator = new socket_impl_allocator;
+    return *socketImplAllocator;
+}
+
+
+//=============================================================================
+bcpp::network::socket_impl_allocator::socket_impl_allocator
+(
+)
+{
+    for (auto & sizeClass : sizeClasses_)
+        sizeClass.freeList_.reserve(max_cached_per_size_class);
+}
+
+
+//=============================================================================
+std::size_t bcpp::network::socket_impl_allocator::get_size_class_index
+(
+    // returns num_size_classes for blocks which are not pooled
+    std::size_t size,
+    std::size_t alignment
+) noexcept
+{
+    if ((size > max_pooled_size) || (alignment > block_alignment))
+        return num_size_classes;
+    return ((std::max(size, std::size_t{1}) + size_class_granularity - 1) / size_class_granularity) - 1;
+}
+
+
+//=============================================================================
+void * bcpp::network::socket_impl_allocator::allocate
+(
+    std::size_t size,
+    std::size_t alignment
+)
+{
+    ++allocations_;
+    auto index = get_size_class_index(size, alignment);
+    if (index == num_size_classes)
+        return ::operator new(size, std::align_val_t{std::max(alignment, block_alignment)});
+
+    auto & sizeClass = sizeClasses_[index];
+    {
+        std::lock_guard lockGuard(sizeClass.atomicSpinLock_);
+        if (!sizeClass.freeList_.empty())
+        {
+            auto * address = sizeClass.freeList_.back();
+            sizeClass.freeList_.pop_back();
+            ++poolHits_;
+            --cached_;
+            return address;
+        }
+    }
+    // allocate the full size class so that the block can be reused by any impl of the class
+    return ::operator new((index + 1) * size_class_granularity, std::align_val_t{block_alignment});
+}
+
+
+//=============================================================================
+void bcpp::network::socket_impl_allocator::release
+(
+    // size and alignment must be those which were passed to allocate
+    void * address,
+    std::size_t size,
+    std::size_t alignment
+) noexcept
+{
+    if (address == nullptr)
+        return;
+    auto index = get_size_class_index(size, alignment);
+    if (index < num_size_classes)
+    {
+        auto & sizeClass = sizeClasses_[index];
+        std::lock_guard lockGuard(sizeClass.atomicSpinLock_);
+        if (sizeClass.freeList_.size() < max_cached_per_size_class)
+        {
+            sizeClass.freeList_.push_back(address); // capacity reserved up front so this can not throw
+            ++cached_;
+            return;
+        }
+    }
+    ::operator delete(address, std::align_val_t{std::max(alignment, block_alignment)});
+}
+
+
+//=============================================================================
+auto bcpp::network::socket_impl_allocator::get_statistics
+(
+) const noexcept -> statistics
+{
+    return {.allocations_ = allocations_, .poolHits_ = poolHits_, .cached_ = cached_};
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <include/atomic_spin_lock.h>
+#include <include/non_copyable.h>
+#include <include/non_movable.h>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    // process wide cache of the memory used by socket impls.  short lived
+    // sockets (ex: one request per connection clients) would otherwise return
+    // every impl to the general purpose allocator only to request a block of
+    // the very same size moments later, usually from a different thread.
+    // released blocks are kept in a free list per size class (up to a limit)
+    // and handed back out by the next allocation of that class.  blocks which
+    // are too large (or too strictly aligned) to be pooled go straight to the
+    // global allocator.  every block is aligned to at least block_alignment
+    // (impls contain cache line aligned queues) so that any pooled block can
+    // be reused by any impl of the same size class.
+    class socket_impl_allocator :
+        non_copyable,
+        non_movable
+    {
+    public:
+
+        static auto constexpr size_class_granularity = 256;
+        static auto constexpr max_pooled_size = (16 * 1024);
+        static auto constexpr max_cached_per_size_class = 4096;
+        static auto constexpr block_alignment = std::size_t{64};
+
+        struct statistics
+        {
+            std::uint64_t   allocations_;
+            std::uint64_t   poolHits_;      // allocations satisfied by the free lists
+            std::uint64_t   cached_;        // blocks currently held in the free lists
+        };
+
+        static socket_impl_allocator & get();
+
+        void * allocate
+        (
+            std::size_t,
+            std::size_t = block_alignment
+        );
+
+        void release
+        (
+            void *,
+            std::size_t,
+            std::size_t = block_alignment
+        ) noexcept;
+
+        statistics get_statistics() const noexcept;
+
+    private:
+
+        static auto constexpr num_size_classes = (max_pooled_size / size_class_granularity);
+
+        struct size_class
+        {
+            atomic_spin_lock        atomicSpinLock_;
+            std::vector<void *>     freeList_;
+        };
+
+        socket_impl_allocator();
+
+        static std::size_t get_size_class_index
+        (
+            std::size_t,
+            std::size_t
+        ) noexcept;
+
+        std::array<size_class, num_size_classes>    sizeClasses_;
+
+        std::atomic<std::uint64_t>                  allocations_{0};
+
+        std::atomic<std::uint64_t>                  poolHits_{0};
+
+        std::atomic<std::uint64_t>                  cached_{0};
+
+    }; // class socket_impl_allocator
+
+} // namespace bcpp::network
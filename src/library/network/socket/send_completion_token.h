@@ -1,19 +1,244 @@
 #pragma once
 
-#include <include/non_copyable.h>
-
-#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 
 namespace bcpp::network
 {
 
-    struct send_completion_token
+    //=========================================================================
+    // one shot callback issued once a queued send has been written to the socket.
+    // the callable is stored inline (no heap allocation) and must therefore fit
+    // within inline_capacity bytes.  capture by reference or capture a pointer
+    // to larger state if necessary.
+    // callables of the form void(void *) are invoked on success only. callables 
+    // of the form void(void *, std::int32_t) are invoked on success (with 0) and 
+    // also when the send fails (with the errno of the failure).
+    class send_completion_token
     {
-        std::function<void(void *)> callback_;
-        void * value_{nullptr};
-        void operator()(){if (callback_) callback_(value_); callback_ = nullptr;}
-        operator bool() const{return (callback_ != nullptr);}
-    };
+    public:
+
+        static auto constexpr inline_capacity = 48;
+
+        send_completion_token() = default;
+
+        template <typename F>
+        requires (!std::is_same_v<std::decay_t<F>, send_completion_token>) &&
+                (std::is_invocable_v<std::decay_t<F> &, void *> || std::is_invocable_v<std::decay_t<F> &, void *, std::int32_t>)
+        send_completion_token
+        (
+            F &&,
+            void * = nullptr
+        );
+
+        send_completion_token
+        (
+            send_completion_token const &
+        );
+
+        send_completion_token
+        (
+            send_completion_token &&
+        );
+
+        send_completion_token & operator =
+        (
+            send_completion_token const &
+        );
+
+        send_completion_token & operator =
+        (
+            send_completion_token &&
+        );
+
+        ~send_completion_token();
+
+        void operator()();
+
+        void operator()
+        (
+            std::int32_t
+        );
+
+        operator bool() const;
+
+    private:
+
+        struct operations
+        {
+            void (*invoke_)(void *, void *, std::int32_t);
+            void (*copy_)(void *, void const *);
+            void (*move_)(void *, void *);
+            void (*destroy_)(void *);
+        };
+
+        template <typename F>
+        static constexpr operations operations_for
+        {
+            .invoke_ = [](void * callable, void * value, std::int32_t errorCode)
+                    {
+                        auto & f = *std::launder(reinterpret_cast<F *>(callable));
+                        if constexpr (std::is_invocable_v<F &, void *, std::int32_t>)
+                            f(value, errorCode);
+                        else if (errorCode == 0)
+                            f(value);
+                    },
+            .copy_ = [](void * destination, void const * source){new (destination) F(*std::launder(reinterpret_cast<F const *>(source)));},
+            .move_ = [](void * destination, void * source){new (destination) F(std::move(*std::launder(reinterpret_cast<F *>(source))));},
+            .destroy_ = [](void * callable){std::launder(reinterpret_cast<F *>(callable))->~F();}
+        };
+
+        void reset();
+
+        alignas(std::max_align_t) std::byte storage_[inline_capacity];
+
+        operations const *                  operations_{nullptr};
+
+        void *                              value_{nullptr};
+
+    }; // class send_completion_token
 
 } // namespace bcpp::network
+
+
+//=============================================================================
+template <typename F>
+requires (!std::is_same_v<std::decay_t<F>, bcpp::network::send_completion_token>) &&
+        (std::is_invocable_v<std::decay_t<F> &, void *> || std::is_invocable_v<std::decay_t<F> &, void *, std::int32_t>)
+inline bcpp::network::send_completion_token::send_completion_token
+(
+    F && callable,
+    void * value
+):
+    operations_(&operations_for<std::decay_t<F>>),
+    value_(value)
+{
+    using callable_type = std::decay_t<F>;
+    static_assert(sizeof(callable_type) <= inline_capacity, "send_completion_token: callable exceeds inline capacity");
+    static_assert(alignof(callable_type) <= alignof(std::max_align_t), "send_completion_token: callable is over aligned");
+    new (storage_) callable_type(std::forward<F>(callable));
+}
+
+
+//=============================================================================
+inline bcpp::network::send_completion_token::send_completion_token
+(
+    send_completion_token const & other
+):
+    operations_(other.operations_),
+    value_(other.value_)
+{
+    if (operations_ != nullptr)
+        operations_->copy_(storage_, other.storage_);
+}
+
+
+//=============================================================================
+inline bcpp::network::send_completion_token::send_completion_token
+(
+    send_completion_token && other
+):
+    operations_(other.operations_),
+    value_(other.value_)
+{
+    if (operations_ != nullptr)
+    {
+        operations_->move_(storage_, other.storage_);
+        other.reset();
+    }
+}
+
+
+//=============================================================================
+inline auto bcpp::network::send_completion_token::operator =
+(
+    send_completion_token const & other
+) -> send_completion_token &
+{
+    if (&other != this)
+    {
+        reset();
+        if (other.operations_ != nullptr)
+            other.operations_->copy_(storage_, other.storage_);
+        operations_ = other.operations_;
+        value_ = other.value_;
+    }
+    return *this;
+}
+
+
+//=============================================================================
+inline auto bcpp::network::send_completion_token::operator =
+(
+    send_completion_token && other
+) -> send_completion_token &
+{
+    if (&other != this)
+    {
+        reset();
+        if (other.operations_ != nullptr)
+            other.operations_->move_(storage_, other.storage_);
+        operations_ = other.operations_;
+        value_ = other.value_;
+        other.reset();
+    }
+    return *this;
+}
+
+
+//=============================================================================
+inline bcpp::network::send_completion_token::~send_completion_token
+(
+)
+{
+    reset();
+}
+
+
+//=============================================================================
+inline void bcpp::network::send_completion_token::reset
+(
+)
+{
+    if (auto operations = std::exchange(operations_, nullptr); operations != nullptr)
+        operations->destroy_(storage_);
+    value_ = nullptr;
+}
+
+
+//=============================================================================
+inline void bcpp::network::send_completion_token::operator()
+(
+    // send succeeded
+)
+{
+    (*this)(0);
+}
+
+
+//=============================================================================
+inline void bcpp::network::send_completion_token::operator()
+(
+    // send completed with the specified error code (0 indicates success)
+    std::int32_t errorCode
+)
+{
+    if (operations_ != nullptr)
+    {
+        operations_->invoke_(storage_, value_, errorCode);
+        reset();
+    }
+}
+
+
+//=============================================================================
+inline bcpp::network::send_completion_token::operator bool
+(
+) const
+{
+    return (operations_ != nullptr);
+}
@@ -0,0 +1,95 @@
+#include "./shared_memory_socket.h"
+#include "./private/shared_memory_socket_impl.h"
+
+#include <iostream>
+
+
+//=============================================================================
+bcpp::network::shared_memory_socket::socket
+(
+    std::string name,
+    configuration const & config,
+    event_handlers const & eventHandlers,
+    work_contract_group &,
+    work_contract_group & receiveWorkContractGroup,
+    std::shared_ptr<poller> & p,
+    std::shared_ptr<timer_wheel> const &
+)
+try
+{
+    shared_memory_ring::configuration ringConfiguration;
+    if (config.capacity_ > 0)
+        ringConfiguration.capacity_ = config.capacity_;
+    if (config.slotSize_ > 0)
+        ringConfiguration.slotSize_ = config.slotSize_;
+    ringConfiguration.producerMode_ = config.producerMode_;
+
+    impl_ = std::move(decltype(impl_)(new impl_type(
+            std::move(name),
+            {
+                .mode_ = config.mode_,
+                .ring_ = ringConfiguration,
+                .spin_ = config.spin_,
+                .receiveBatchSize_ = config.receiveBatchSize_
+            },
+            {
+                eventHandlers.closeHandler_,
+                eventHandlers.pollErrorHandler_,
+                eventHandlers.receiveHandler_
+            },
+            receiveWorkContractGroup, p),
+            [](auto * impl){impl->destroy();}));
+}
+catch (std::exception const & exception)
+{
+    std::cerr << "shared_memory_socket ctor failure.  reason: " << exception.what() << "\n";
+    impl_.reset();
+}
+
+
+//=============================================================================
+bool bcpp::network::shared_memory_socket::send
+(
+    packet && data
+)
+{
+    return send(std::move(data), {});
+}
+
+
+//=============================================================================
+bool bcpp::network::shared_memory_socket::send
+(
+    packet && data,
+    send_completion_token sendCompletionToken
+)
+{
+    return (impl_) ? impl_->send(std::move(data), sendCompletionToken) : false;
+}
+
+
+//=============================================================================
+bool bcpp::network::shared_memory_socket::close
+(
+)
+{
+    return (impl_) ? impl_->close() : false;
+}
+
+
+//=============================================================================
+bool bcpp::network::shared_memory_socket::is_valid
+(
+) const noexcept
+{
+    return (impl_) ? impl_->is_valid() : false;
+}
+
+
+//=============================================================================
+auto bcpp::network::shared_memory_socket::get_id
+(
+) const -> socket_id
+{
+    return (impl_) ? impl_->get_id() : socket_id{};
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "./socket.h"
+#include "./send_completion_token.h"
+#include "./traits/traits.h"
+
+#include <library/work_contract.h>
+#include <library/network/poller/poller.h>
+#include <library/network/ip/socket_address.h>
+#include <library/network/packet/packet.h>
+#include <library/network/queue/producer_mode.h>
+#include <library/network/shared_memory/shared_memory_mode.h>
+#include <library/network/timer/timer_wheel.h>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <cstdint>
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    // same host transport over a named shared memory ring.  the receiving socket
+    // creates the ring and any number of sending sockets (in any process) attach
+    // to it by name.  sends are a copy into the ring with no system call (unless
+    // the receiver is idle and must be woken).  received packets refer directly
+    // to the message within the ring and are only valid during the receive handler.
+    template <>
+    class socket<shared_memory_socket_traits>
+    {
+    public:
+
+        using traits = shared_memory_socket_traits;
+
+        struct event_handlers
+        {
+            using close_handler = std::function<void(socket_id)>;
+            using poll_error_handler = std::function<void(socket_id)>;
+            using receive_handler = std::function<void(socket_id, packet, socket_address)>;
+
+            close_handler               closeHandler_;
+            poll_error_handler          pollErrorHandler_;
+            receive_handler             receiveHandler_;
+        };
+
+        struct configuration
+        {
+            shared_memory_mode mode_{shared_memory_mode::receive};
+            std::size_t capacity_{0};       // slots in the ring.  receiver only (0 = default)
+            std::size_t slotSize_{0};       // largest message.  receiver only (0 = default)
+            producer_mode producerMode_{producer_mode::single_producer}; // multi_producer if several senders.  receiver only
+            bool spin_{false};              // receiver polls the ring continuously rather than sleeping on the door bell
+            std::size_t receiveBatchSize_{0}; // messages delivered per receive contract invocation (0 = default)
+        };
+
+        socket(socket const &) = delete;
+        socket & operator = (socket const &) = delete;
+
+        socket() = default;
+        socket(socket &&) = default;
+        socket & operator = (socket &&) = default;
+
+        socket
+        (
+            std::string,
+            configuration const &,
+            event_handlers const &,
+            work_contract_group &,
+            work_contract_group &,
+            std::shared_ptr<poller> &,
+            std::shared_ptr<timer_wheel> const &
+        );
+
+        ~socket() = default;
+
+        bool send
+        (
+            packet &&
+        );
+
+        bool send
+        (
+            packet &&,
+            send_completion_token
+        );
+
+        bool close();
+
+        bool is_valid() const noexcept;
+
+        socket_id get_id() const;
+
+    private:
+
+        using impl_type = socket_impl<traits>;
+
+        std::unique_ptr<impl_type, std::function<void(impl_type *)>>   impl_;
+
+    }; // class socket<shared_memory_socket_traits>
+
+
+    using shared_memory_socket = socket<shared_memory_socket_traits>;
+
+} // namespace bcpp::network
@@ -9,14 +9,19 @@ namespace bcpp::network
 {
 
     //=========================================================================
-    // the protocol type (udp or tcp)
+    // the protocol type (udp, tcp or one of the same host protocols)
     enum class network_transport_protocol : std::uint32_t
     {
         undefined                       = 0,
         transmission_control_protocol   = 1,
         tcp                             = transmission_control_protocol,
         user_datagram_protocol          = 2,
-        udp                             = user_datagram_protocol
+        udp                             = user_datagram_protocol,
+        unix_stream                     = 3,    // AF_UNIX, SOCK_STREAM
+        unix_sequenced_packet           = 4,    // AF_UNIX, SOCK_SEQPACKET
+        unix_seqpacket                  = unix_sequenced_packet,
+        shared_memory                   = 5,    // same host shared memory ring
+        loopback                        = 6     // in process (no kernel involvement)
     };
 
 
@@ -31,4 +36,35 @@ namespace bcpp::network
     template <network_transport_protocol T>
     concept tcp_concept = (T == network_transport_protocol::tcp);
 
+
+    //=========================================================================
+    // alias for unix domain sockets (either stream or sequenced packet)
+    template <network_transport_protocol T>
+    concept unix_concept = ((T == network_transport_protocol::unix_stream) || (T == network_transport_protocol::unix_seqpacket));
+
+
+    //=========================================================================
+    // alias for byte stream sockets (no message boundaries)
+    template <network_transport_protocol T>
+    concept stream_concept = ((T == network_transport_protocol::tcp) || (T == network_transport_protocol::unix_stream));
+
+
+    //=========================================================================
+    // alias for shared memory ring sockets
+    template <network_transport_protocol T>
+    concept shared_memory_concept = (T == network_transport_protocol::shared_memory);
+
+
+    //=========================================================================
+    // alias for in process loopback sockets
+    template <network_transport_protocol T>
+    concept loopback_concept = (T == network_transport_protocol::loopback);
+
+
+    //=========================================================================
+    // alias for connection oriented sockets (those which are connected to a
+    // single peer either by connecting or by being accepted by a listener)
+    template <network_transport_protocol T>
+    concept connection_concept = (tcp_concept<T> || unix_concept<T>);
+
 } // namespace bcpp::network
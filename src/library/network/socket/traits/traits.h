@@ -12,7 +12,7 @@ namespace bcpp::network
 
     //=========================================================================
     // socket traits define two properties for the socket
-    // 1: the protocol (udp or tcp)
+    // 1: the protocol (udp, tcp, unix_stream, unix_seqpacket, shared_memory or loopback)
     // 2: the type of socket (active or passive) 
     template <network_transport_protocol T0, socket_type T1>
     struct socket_traits
@@ -27,6 +27,12 @@ namespace bcpp::network
     using tcp_socket_traits = socket_traits<network_transport_protocol::tcp, socket_type::active>;
     using tcp_listener_socket_traits = socket_traits<network_transport_protocol::tcp, socket_type::passive>;
     using udp_socket_traits = socket_traits<network_transport_protocol::udp, socket_type::active>;
+    using unix_stream_socket_traits = socket_traits<network_transport_protocol::unix_stream, socket_type::active>;
+    using unix_stream_listener_socket_traits = socket_traits<network_transport_protocol::unix_stream, socket_type::passive>;
+    using unix_seqpacket_socket_traits = socket_traits<network_transport_protocol::unix_seqpacket, socket_type::active>;
+    using unix_seqpacket_listener_socket_traits = socket_traits<network_transport_protocol::unix_seqpacket, socket_type::passive>;
+    using shared_memory_socket_traits = socket_traits<network_transport_protocol::shared_memory, socket_type::active>;
+    using loopback_socket_traits = socket_traits<network_transport_protocol::loopback, socket_type::active>;
 
     //=========================================================================
     template <typename T>
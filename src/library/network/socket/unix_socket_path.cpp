@@ -0,0 +1,94 @@
+#include "./unix_socket_path.h"
+
+#include <algorithm>
+#include <cstddef>
+
+
+//=============================================================================
+bcpp::network::unix_socket_path::unix_socket_path
+(
+    // paths which are too long to fit within sockaddr_un result in an invalid path
+    std::string_view value
+)
+{
+    if ((value.empty()) || (value.size() > max_length))
+        return;
+    std::copy(value.begin(), value.end(), path_.begin());
+    length_ = value.size();
+}
+
+
+//=============================================================================
+bcpp::network::unix_socket_path::unix_socket_path
+(
+    // as returned by getsockname/getpeername/accept.  unnamed sockets (such as
+    // the client side of most connections) result in an invalid path.
+    ::sockaddr_un const & socketAddress,
+    ::socklen_t socketAddressLength
+) noexcept
+{
+    if ((socketAddress.sun_family != AF_UNIX) || (socketAddressLength <= offsetof(::sockaddr_un, sun_path)))
+        return;
+    auto length = std::min<std::size_t>(socketAddressLength - offsetof(::sockaddr_un, sun_path), max_length);
+    std::string_view path(socketAddress.sun_path, length);
+    if (path.front() == 0)
+    {
+        // abstract namespace
+        path_[0] = abstract_prefix;
+        std::copy(path.begin() + 1, path.end(), path_.begin() + 1);
+        length_ = length;
+        return;
+    }
+    length_ = path.substr(0, path.find('\0')).size();
+    std::copy_n(path.begin(), length_, path_.begin());
+}
+
+
+//=============================================================================
+bcpp::network::unix_socket_path::operator ::sockaddr_un
+(
+) const noexcept
+{
+    ::sockaddr_un socketAddress{.sun_family = AF_UNIX, .sun_path = {}};
+    std::copy_n(path_.begin(), length_, socketAddress.sun_path);
+    if (is_abstract())
+        socketAddress.sun_path[0] = 0;
+    return socketAddress;
+}
+
+
+//=============================================================================
+::socklen_t bcpp::network::unix_socket_path::get_socket_address_length
+(
+    // abstract names are not null terminated and their length is significant
+) const noexcept
+{
+    return static_cast<::socklen_t>(offsetof(::sockaddr_un, sun_path) + length_ + (is_abstract() ? 0 : 1));
+}
+
+
+//=============================================================================
+std::string_view bcpp::network::unix_socket_path::get
+(
+) const noexcept
+{
+    return {path_.data(), length_};
+}
+
+
+//=============================================================================
+bool bcpp::network::unix_socket_path::is_valid
+(
+) const noexcept
+{
+    return (length_ > 0);
+}
+
+
+//=============================================================================
+bool bcpp::network::unix_socket_path::is_abstract
+(
+) const noexcept
+{
+    return ((length_ > 0) && (path_[0] == abstract_prefix));
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <iostream>
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    // the address of a unix domain socket.  either a file system path or, when
+    // the path begins with '@', a name in the linux abstract namespace (which
+    // leaves nothing behind in the file system).
+    class unix_socket_path
+    {
+    public:
+
+        static auto constexpr max_length = (sizeof(::sockaddr_un::sun_path) - 1);
+        static auto constexpr abstract_prefix = '@';
+
+        unix_socket_path() noexcept = default;
+        unix_socket_path(unix_socket_path const &) noexcept = default;
+        unix_socket_path & operator = (unix_socket_path const &) noexcept = default;
+        unix_socket_path(unix_socket_path &&) noexcept = default;
+        unix_socket_path & operator = (unix_socket_path &&) noexcept = default;
+
+        template <std::size_t N>
+        unix_socket_path
+        (
+            char const (&)[N]
+        );
+
+        unix_socket_path
+        (
+            std::string_view
+        );
+
+        unix_socket_path
+        (
+            ::sockaddr_un const &,
+            ::socklen_t
+        ) noexcept;
+
+        operator ::sockaddr_un() const noexcept;
+
+        ::socklen_t get_socket_address_length() const noexcept;
+
+        std::string_view get() const noexcept;
+
+        bool is_valid() const noexcept;
+
+        bool is_abstract() const noexcept;
+
+    private:
+
+        std::array<char, max_length + 1>    path_{};
+
+        std::size_t                         length_{0};
+
+    }; // class unix_socket_path
+
+
+    //=========================================================================
+    [[maybe_unused]]
+    static std::string to_string
+    (
+        unix_socket_path const & unixSocketPath
+    )
+    {
+        return std::string(unixSocketPath.get());
+    }
+
+} // namespace bcpp::network
+
+
+//=============================================================================
+template <std::size_t N>
+inline bcpp::network::unix_socket_path::unix_socket_path
+(
+    char const (&value)[N]
+):
+    unix_socket_path(std::string_view(value, ((N > 0) && (value[N - 1] == 0)) ? (N - 1) : N))
+{
+}
+
+
+//=============================================================================
+[[maybe_unused]]
+static std::ostream & operator <<
+(
+    std::ostream & stream,
+    bcpp::network::unix_socket_path const & unixSocketPath
+)
+{
+    stream << to_string(unixSocketPath);
+    return stream;
+}
@@ -0,0 +1,71 @@
+#include "./timer_impl.h"
+
+
+//=============================================================================
+bcpp::network::timer_impl::timer_impl
+(
+    configuration const & config,
+    event_handlers const & eventHandlers,
+    work_contract_group & workContractGroup,
+    std::shared_ptr<timer_wheel> const & timerWheel
+):
+    timerWheel_(timerWheel),
+    period_(config.period_),
+    expiryHandler_(eventHandlers.expiryHandler_),
+    workContract_(workContractGroup.create_contract([this](){this->expire();}, [this](){this->destroy();}))
+{
+}
+
+
+//=============================================================================
+bool bcpp::network::timer_impl::start
+(
+    // arm (or re-arm) the timer to expire after the specified duration.
+    // if the timer is periodic it will continue to expire every period thereafter.
+    std::chrono::nanoseconds duration
+)
+{
+    if (auto timerWheel = timerWheel_.lock(); timerWheel)
+        return timerWheel->arm(timerWheelEntry_, duration, period_);
+    return false;
+}
+
+
+//=============================================================================
+bool bcpp::network::timer_impl::stop
+(
+)
+{
+    if (auto timerWheel = timerWheel_.lock(); timerWheel)
+        return timerWheel->cancel(timerWheelEntry_);
+    return false;
+}
+
+
+//=============================================================================
+void bcpp::network::timer_impl::expire
+(
+)
+{
+    if (expiryHandler_)
+        expiryHandler_();
+}
+
+
+//=============================================================================
+void bcpp::network::timer_impl::destroy
+(
+    // use the work contract to asynchronously delete 'this'.
+    // see active_socket_impl::destroy
+)
+{
+    stop();
+    if (workContract_.is_valid())
+    {
+        workContract_.release();
+    }
+    else
+    {
+        delete this;
+    }
+}
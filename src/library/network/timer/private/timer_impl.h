@@ -0,0 +1,70 @@
+#pragma once
+
+#include <library/network/timer/timer_wheel.h>
+
+#include <include/non_copyable.h>
+#include <include/non_movable.h>
+
+#include <library/work_contract.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+
+namespace bcpp::network
+{
+
+    class timer_impl :
+        non_copyable,
+        non_movable
+    {
+    public:
+
+        struct event_handlers
+        {
+            using expiry_handler = std::function<void()>;
+
+            expiry_handler  expiryHandler_;
+        };
+
+        struct configuration
+        {
+            std::chrono::nanoseconds    period_{0};
+        };
+
+        timer_impl
+        (
+            configuration const &,
+            event_handlers const &,
+            work_contract_group &,
+            std::shared_ptr<timer_wheel> const &
+        );
+
+        bool start
+        (
+            std::chrono::nanoseconds
+        );
+
+        bool stop();
+
+        void destroy();
+
+    private:
+
+        void expire();
+
+        std::weak_ptr<timer_wheel>              timerWheel_;
+
+        std::chrono::nanoseconds                period_;
+
+        event_handlers::expiry_handler          expiryHandler_;
+
+        work_contract                           workContract_;
+
+        timer_wheel_entry                       timerWheelEntry_{workContract_};
+
+    }; // class timer_impl
+
+} // namespace bcpp::network
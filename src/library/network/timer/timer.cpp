@@ -0,0 +1,45 @@
+#include "./timer.h"
+#include "./private/timer_impl.h"
+
+
+//=============================================================================
+bcpp::network::timer::timer
+(
+    configuration const & config,
+    event_handlers const & eventHandlers,
+    work_contract_group & workContractGroup,
+    std::shared_ptr<timer_wheel> const & timerWheel
+):
+    impl_(new timer_impl({.period_ = config.period_}, {eventHandlers.expiryHandler_}, workContractGroup, timerWheel),
+            [](auto * impl){impl->destroy();})
+{
+}
+
+
+//=============================================================================
+bool bcpp::network::timer::start
+(
+    // arm (or re-arm) the timer to expire after the specified duration
+    std::chrono::nanoseconds duration
+)
+{
+    return (impl_) ? impl_->start(duration) : false;
+}
+
+
+//=============================================================================
+bool bcpp::network::timer::stop
+(
+)
+{
+    return (impl_) ? impl_->stop() : false;
+}
+
+
+//=============================================================================
+bool bcpp::network::timer::is_valid
+(
+) const noexcept
+{
+    return (impl_ != nullptr);
+}
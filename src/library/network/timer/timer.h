@@ -0,0 +1,71 @@
+#pragma once
+
+#include "./timer_wheel.h"
+
+#include <library/work_contract.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+
+
+namespace bcpp::network
+{
+
+    class timer_impl;
+
+
+    //=========================================================================
+    // a one shot or periodic timer which is driven by the timer wheel of the
+    // virtual network interface which created it.  the expiry handler is invoked
+    // asynchronously via a work contract.
+    class timer
+    {
+    public:
+
+        struct event_handlers
+        {
+            using expiry_handler = std::function<void()>;
+
+            expiry_handler  expiryHandler_;
+        };
+
+        struct configuration
+        {
+            std::chrono::nanoseconds    period_{0}; // 0 = one shot
+        };
+
+        timer() = default;
+
+        timer
+        (
+            configuration const &,
+            event_handlers const &,
+            work_contract_group &,
+            std::shared_ptr<timer_wheel> const &
+        );
+
+        timer(timer const &) = delete;
+        timer & operator = (timer const &) = delete;
+
+        timer(timer &&) = default;
+        timer & operator = (timer &&) = default;
+
+        ~timer() = default;
+
+        bool start
+        (
+            std::chrono::nanoseconds
+        );
+
+        bool stop();
+
+        bool is_valid() const noexcept;
+
+    private:
+
+        std::unique_ptr<timer_impl, std::function<void(timer_impl *)>>   impl_;
+
+    }; // class timer
+
+} // namespace bcpp::network
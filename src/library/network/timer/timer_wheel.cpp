@@ -0,0 +1,289 @@
+#include "./timer_wheel.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <mutex>
+#include <utility>
+
+
+//=============================================================================
+auto bcpp::network::timer_wheel::create
+(
+    configuration const & config
+) -> std::shared_ptr<timer_wheel>
+{
+    return std::shared_ptr<timer_wheel>(new timer_wheel(config));
+}
+
+
+//=============================================================================
+bcpp::network::timer_wheel::timer_wheel
+(
+    configuration const & config
+):
+    resolution_((config.resolution_.count() > 0) ? config.resolution_ : default_resolution),
+    epoch_(std::chrono::steady_clock::now())
+{
+}
+
+
+//=============================================================================
+bcpp::network::timer_wheel::~timer_wheel
+(
+)
+{
+    // disarm any timers which remain.  they will never expire.
+    std::lock_guard lockGuard(atomicSpinLock_);
+    for (auto levelIndex = 0; levelIndex <= overflow_level; ++levelIndex)
+        for (auto slotIndex = 0; slotIndex < (std::int32_t)slots_per_level; ++slotIndex)
+            for (auto timer = detach_slot(levelIndex, slotIndex); timer != nullptr; )
+                std::exchange(timer, timer->next_)->level_ = -1;
+}
+
+
+//=============================================================================
+std::uint64_t bcpp::network::timer_wheel::get_tick
+(
+) const
+{
+    return ((std::chrono::steady_clock::now() - epoch_) / resolution_);
+}
+
+
+//=============================================================================
+std::uint64_t bcpp::network::timer_wheel::to_ticks
+(
+    // convert duration to ticks (rounded up)
+    std::chrono::nanoseconds duration
+) const
+{
+    if (duration.count() <= 0)
+        return 0;
+    return ((duration.count() + resolution_.count() - 1) / resolution_.count());
+}
+
+
+//=============================================================================
+bool bcpp::network::timer_wheel::arm
+(
+    timer_wheel_entry & timer,
+    std::chrono::nanoseconds duration,
+    std::chrono::nanoseconds period
+)
+{
+    auto now = get_tick();
+    std::lock_guard lockGuard(atomicSpinLock_);
+    if (timer.level_ >= 0)
+        remove(timer);
+    timer.expiryTick_ = (std::max(now, currentTick_) + std::max(to_ticks(duration), std::uint64_t(1)));
+    timer.periodTicks_ = to_ticks(period);
+    insert(timer);
+    publish_next_event_tick();
+    return true;
+}
+
+
+//=============================================================================
+bool bcpp::network::timer_wheel::cancel
+(
+    timer_wheel_entry & timer
+)
+{
+    std::lock_guard lockGuard(atomicSpinLock_);
+    if (timer.level_ < 0)
+        return false;
+    remove(timer);
+    publish_next_event_tick();
+    return true;
+}
+
+
+//=============================================================================
+void bcpp::network::timer_wheel::insert
+(
+    // place the timer in the level which corresponds to the most significant
+    // digit (6 bits per digit) in which its expiry differs from the current tick.
+    // timers which expire at (or before) the current tick go in the current slot
+    // of level zero.  timers which expire beyond the range of the top level go
+    // in the overflow level.
+    timer_wheel_entry & timer
+)
+{
+    auto expiryTick = std::max(timer.expiryTick_, currentTick_);
+    std::int32_t levelIndex = 0;
+    if (expiryTick > currentTick_)
+        levelIndex = std::min(((63 - std::countl_zero(expiryTick ^ currentTick_)) / bits_per_level), overflow_level);
+    std::int32_t slotIndex = (levelIndex == overflow_level) ? 0 : ((expiryTick >> (levelIndex * bits_per_level)) & slot_mask);
+
+    auto & level = levels_[levelIndex];
+    auto & head = level.slots_[slotIndex];
+    timer.previous_ = nullptr;
+    timer.next_ = head;
+    if (head != nullptr)
+        head->previous_ = &timer;
+    head = &timer;
+    level.occupied_ |= (1ull << slotIndex);
+    timer.level_ = levelIndex;
+    timer.slot_ = slotIndex;
+    ++size_;
+}
+
+
+//=============================================================================
+void bcpp::network::timer_wheel::remove
+(
+    timer_wheel_entry & timer
+)
+{
+    auto & level = levels_[timer.level_];
+    if (timer.previous_ != nullptr)
+        timer.previous_->next_ = timer.next_;
+    else
+        level.slots_[timer.slot_] = timer.next_;
+    if (timer.next_ != nullptr)
+        timer.next_->previous_ = timer.previous_;
+    if (level.slots_[timer.slot_] == nullptr)
+        level.occupied_ &= ~(1ull << timer.slot_);
+    timer.next_ = timer.previous_ = nullptr;
+    timer.level_ = -1;
+    --size_;
+}
+
+
+//=============================================================================
+auto bcpp::network::timer_wheel::detach_slot
+(
+    // remove and return the entire list of timers in the specified slot
+    std::int32_t levelIndex,
+    std::int32_t slotIndex
+) -> timer_wheel_entry *
+{
+    auto & level = levels_[levelIndex];
+    auto head = std::exchange(level.slots_[slotIndex], nullptr);
+    level.occupied_ &= ~(1ull << slotIndex);
+    for (auto timer = head; timer != nullptr; timer = timer->next_)
+        --size_;
+    return head;
+}
+
+
+//=============================================================================
+std::uint64_t bcpp::network::timer_wheel::get_next_event_tick
+(
+    // returns the earliest tick at which any level has a slot which is due to
+    // either expire (level zero) or cascade (all other levels).
+    // all occupied slots at any level are beyond that level's current slot.
+) const
+{
+    auto nextEventTick = std::numeric_limits<std::uint64_t>::max();
+    if (levels_[overflow_level].occupied_ != 0)
+        nextEventTick = (((currentTick_ >> overflow_shift) + 1) << overflow_shift);
+    for (auto levelIndex = 0; levelIndex < number_of_levels; ++levelIndex)
+    {
+        auto shift = (levelIndex * bits_per_level);
+        auto currentSlot = ((currentTick_ >> shift) & slot_mask);
+        auto occupied = (currentSlot == slot_mask) ? 0 : (levels_[levelIndex].occupied_ & (~0ull << (currentSlot + 1)));
+        if (occupied != 0)
+        {
+            auto parentShift = (shift + bits_per_level);
+            auto base = ((currentTick_ >> parentShift) << parentShift);
+            nextEventTick = std::min(nextEventTick, base | (std::uint64_t(std::countr_zero(occupied)) << shift));
+        }
+    }
+    return nextEventTick;
+}
+
+
+//=============================================================================
+void bcpp::network::timer_wheel::publish_next_event_tick
+(
+    // invoked with the lock held after any change to the wheel
+)
+{
+    nextEventTick_.store((size_ > 0) ? get_next_event_tick() : no_event_tick, std::memory_order_release);
+}
+
+
+//=============================================================================
+void bcpp::network::timer_wheel::process_tick
+(
+    // the current tick has just been reached.  cascade any higher level slots
+    // which begin at this tick then expire everything in the current level zero slot.
+)
+{
+    for (auto levelIndex = overflow_level; levelIndex > 0; --levelIndex)
+    {
+        auto shift = (levelIndex * bits_per_level);
+        if ((currentTick_ & ((1ull << shift) - 1)) != 0)
+            continue;
+        std::int32_t slotIndex = (levelIndex == overflow_level) ? 0 : ((currentTick_ >> shift) & slot_mask);
+        if ((levels_[levelIndex].occupied_ & (1ull << slotIndex)) == 0)
+            continue;
+        for (auto timer = detach_slot(levelIndex, slotIndex); timer != nullptr; )
+            insert(*std::exchange(timer, timer->next_));
+    }
+
+    for (auto timer = detach_slot(0, currentTick_ & slot_mask); timer != nullptr; )
+    {
+        auto & expired = *std::exchange(timer, timer->next_);
+        expired.level_ = -1;
+        expired.workContract_->schedule();
+        if (expired.periodTicks_ > 0)
+        {
+            expired.expiryTick_ += expired.periodTicks_;
+            if (expired.expiryTick_ <= currentTick_)
+                expired.expiryTick_ = (currentTick_ + expired.periodTicks_); // skip any periods which were missed
+            insert(expired);
+        }
+    }
+}
+
+
+//=============================================================================
+void bcpp::network::timer_wheel::advance
+(
+    // process all timers which have expired as of now.  if no event is due
+    // or another thread is already advancing the wheel then there is nothing
+    // to do.
+)
+{
+    auto publishedEventTick = nextEventTick_.load(std::memory_order_acquire);
+    if (publishedEventTick == no_event_tick)
+        return;
+    auto now = get_tick();
+    if (publishedEventTick > now)
+        return;
+
+    std::unique_lock uniqueLock(atomicSpinLock_, std::try_to_lock);
+    if (!uniqueLock.owns_lock())
+        return;
+
+    while (currentTick_ < now)
+    {
+        auto nextEventTick = (size_ > 0) ? get_next_event_tick() : now + 1;
+        if (nextEventTick > now)
+        {
+            currentTick_ = now;
+            break;
+        }
+        currentTick_ = nextEventTick;
+        process_tick();
+    }
+    publish_next_event_tick();
+}
+
+
+//=============================================================================
+auto bcpp::network::timer_wheel::get_time_until_next_expiry
+(
+    // returns the time remaining until the wheel next requires advancing
+    // or nanoseconds::max() if there are no timers armed.
+) -> std::chrono::nanoseconds
+{
+    auto nextEventTick = nextEventTick_.load(std::memory_order_acquire);
+    if (nextEventTick == no_event_tick)
+        return std::chrono::nanoseconds::max();
+    auto now = get_tick();
+    return (nextEventTick > now) ? (std::int64_t(nextEventTick - now) * resolution_) : std::chrono::nanoseconds(0);
+}
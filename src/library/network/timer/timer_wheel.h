@@ -0,0 +1,136 @@
+#pragma once
+
+#include "./timer_wheel_entry.h"
+
+#include <include/atomic_spin_lock.h>
+#include <include/non_copyable.h>
+#include <include/non_movable.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+
+namespace bcpp::network
+{
+
+    //=========================================================================
+    // hierarchical timing wheel.  each level has 64 slots and each successive
+    // level covers 64 times the range of the level below it.  a timer is placed
+    // in the level which corresponds to the most significant tick digit in which
+    // its expiry differs from the current tick and is cascaded down to lower levels
+    // as time approaches its expiry.  arming and cancelling are O(1).
+    // the wheel is advanced by the thread(s) which poll the virtual network interface.
+    // the tick of the next event is published atomically so that polling threads
+    // can skip the lock (and, if no timer is armed, the clock) when nothing is due.
+    // expired timers are not invoked by the wheel, rather their work contracts are
+    // scheduled and the handler is invoked when the contract is serviced.
+    class timer_wheel :
+        public std::enable_shared_from_this<timer_wheel>,
+        non_copyable,
+        non_movable
+    {
+    public:
+
+        static auto constexpr default_resolution = std::chrono::microseconds(1);
+
+        struct configuration
+        {
+            std::chrono::nanoseconds    resolution_{default_resolution};
+        };
+
+        static std::shared_ptr<timer_wheel> create
+        (
+            configuration const &
+        );
+
+        ~timer_wheel();
+
+        bool arm
+        (
+            timer_wheel_entry &,
+            std::chrono::nanoseconds,
+            std::chrono::nanoseconds
+        );
+
+        bool cancel
+        (
+            timer_wheel_entry &
+        );
+
+        void advance();
+
+        std::chrono::nanoseconds get_time_until_next_expiry();
+
+    private:
+
+        static auto constexpr bits_per_level = 6;
+        static auto constexpr slots_per_level = (1ull << bits_per_level);
+        static auto constexpr slot_mask = (slots_per_level - 1);
+        static auto constexpr number_of_levels = 8;
+        static auto constexpr overflow_level = number_of_levels;
+        static auto constexpr overflow_shift = (bits_per_level * number_of_levels);
+        static auto constexpr no_event_tick = ~0ull;
+
+        struct level
+        {
+            std::uint64_t                                       occupied_{0};
+            std::array<timer_wheel_entry *, slots_per_level>    slots_{};
+        };
+
+        timer_wheel
+        (
+            configuration const &
+        );
+
+        std::uint64_t get_tick() const;
+
+        std::uint64_t to_ticks
+        (
+            std::chrono::nanoseconds
+        ) const;
+
+        std::uint64_t get_next_event_tick() const;
+
+        void publish_next_event_tick();
+
+        void insert
+        (
+            timer_wheel_entry &
+        );
+
+        void remove
+        (
+            timer_wheel_entry &
+        );
+
+        timer_wheel_entry * detach_slot
+        (
+            std::int32_t,
+            std::int32_t
+        );
+
+        void process_tick();
+
+        std::chrono::nanoseconds                resolution_;
+
+        std::chrono::steady_clock::time_point   epoch_;
+
+        std::uint64_t                           currentTick_{0};
+
+        std::size_t                             size_{0};
+
+        // the additional (overflow) level holds, in its first slot, timers which
+        // expire beyond the range of the top level of the wheel
+        std::array<level, number_of_levels + 1> levels_;
+
+        atomic_spin_lock                        atomicSpinLock_;
+
+        // get_next_event_tick as of the last change to the wheel (max if empty)
+        std::atomic<std::uint64_t>              nextEventTick_{no_event_tick};
+
+    }; // class timer_wheel
+
+} // namespace bcpp::network
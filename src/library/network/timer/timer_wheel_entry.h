@@ -0,0 +1,54 @@
+#pragma once
+
+#include <library/work_contract.h>
+
+#include <cstdint>
+
+
+namespace bcpp::network
+{
+
+    class timer_wheel;
+
+
+    //=========================================================================
+    // intrusive node by which anything with a work contract can be armed in a
+    // timer wheel.  upon expiry the wheel schedules the associated work contract.
+    // the owner of the entry must cancel it prior to destroying the entry.
+    class timer_wheel_entry
+    {
+    public:
+
+        timer_wheel_entry
+        (
+            work_contract & workContract
+        ):
+            workContract_(&workContract)
+        {
+        }
+
+        timer_wheel_entry(timer_wheel_entry const &) = delete;
+        timer_wheel_entry & operator = (timer_wheel_entry const &) = delete;
+
+    private:
+
+        friend class timer_wheel;
+
+        work_contract *                         workContract_;
+
+        // the following are owned by the timer wheel and guarded by its lock
+        timer_wheel_entry *                     next_{nullptr};
+
+        timer_wheel_entry *                     previous_{nullptr};
+
+        std::uint64_t                           expiryTick_{0};
+
+        std::uint64_t                           periodTicks_{0};
+
+        std::int32_t                            level_{-1};
+
+        std::int32_t                            slot_{0};
+
+    }; // class timer_wheel_entry
+
+} // namespace bcpp::network
@@ -0,0 +1,70 @@
+#include <library/network/queue/fixed_queue.h>
+
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+
+//=============================================================================
+int main
+(
+    int,
+    char **
+)
+{
+    static auto constexpr number_of_producers = 4;
+    static auto constexpr items_per_producer = (1 << 18);
+
+    struct item
+    {
+        std::uint32_t producer_;
+        std::uint32_t sequence_;
+    };
+
+    std::cout << "create multi producer queue\n";
+    bcpp::network::fixed_queue<item> queue(1 << 10, bcpp::network::producer_mode::multi_producer);
+
+    std::atomic<bool> start{false};
+    std::vector<std::jthread> producers;
+    for (auto i = 0; i < number_of_producers; ++i)
+        producers.emplace_back([&, i]()
+                {
+                    while (!start)
+                        std::this_thread::yield();
+                    for (std::uint32_t sequence = 0; sequence < items_per_producer; ++sequence)
+                        while (!queue.emplace(item{static_cast<std::uint32_t>(i), sequence}))
+                            std::this_thread::yield();
+                });
+
+    std::cout << "\tconsume from " << number_of_producers << " producers\n";
+    std::array<std::uint32_t, number_of_producers> expected{};
+    start = true;
+    for (auto received = 0ull; received < (number_of_producers * items_per_producer); )
+    {
+        if (auto p = queue.front(); p != nullptr)
+        {
+            if (p->sequence_ != expected[p->producer_]++)
+            {
+                std::cerr << "Out of order item from producer " << p->producer_ << "\n";
+                return -1;
+            }
+            queue.discard();
+            ++received;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    if (!queue.empty())
+    {
+        std::cerr << "Queue not empty after consuming all items\n";
+        return -1;
+    }
+    std::cout << "success\n";
+    return 0;
+}
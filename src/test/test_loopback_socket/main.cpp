@@ -0,0 +1,123 @@
+#include <library/network.h>
+
+#include <iostream>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstring>
+
+
+//=============================================================================
+int main
+(
+    int,
+    char **
+)
+{
+    using namespace std::chrono;
+    static auto constexpr num_messages = 100'000;
+
+    std::cout << "create virtual network interface\n";
+    bcpp::network::virtual_network_interface virtualNetworkInterface;
+    if (!virtualNetworkInterface.is_valid())
+    {
+        std::cerr << "Failed to create virtual network interface\n";
+        return -1;
+    }
+
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    std::uint64_t echoed = 0;
+    bool inOrder = true;
+
+    std::cout << "\tcreate loopback echo socket\n";
+    bcpp::network::loopback_socket * echoSocketPtr = nullptr;
+    auto echoSocket = virtualNetworkInterface.create_loopback_socket(bcpp::network::port_id(3000), 
+            {.sendQueueSize_ = 1 << 17, .receiveQueueSize_ = 1 << 17},
+            {
+                .receiveHandler_ = [&](auto, bcpp::network::packet packet, auto source)
+                {
+                    // the packet is the very same buffer that the sender sent.  return it.
+                    echoSocketPtr->send_to(source, std::move(packet));
+                }
+            });
+    echoSocketPtr = &echoSocket;
+    if (!echoSocket.is_valid())
+    {
+        std::cerr << "Failed to create loopback echo socket\n";
+        return -1;
+    }
+
+    std::cout << "\tverify that the address can not be bound twice\n";
+    auto duplicate = virtualNetworkInterface.create_loopback_socket(bcpp::network::port_id(3000), {}, {});
+    if (duplicate.is_valid())
+    {
+        std::cerr << "Loopback address bound twice\n";
+        return -1;
+    }
+
+    std::cout << "\tcreate loopback client socket\n";
+    auto clientSocket = virtualNetworkInterface.create_loopback_socket(bcpp::network::port_id_any, 
+            {.sendQueueSize_ = 1 << 17, .receiveQueueSize_ = 1 << 17},
+            {
+                .receiveHandler_ = [&](auto, bcpp::network::packet packet, auto)
+                {
+                    std::uint64_t sequence;
+                    std::memcpy(&sequence, packet.data(), sizeof(sequence));
+                    std::unique_lock uniqueLock(mutex);
+                    inOrder &= (sequence == echoed);
+                    ++echoed;
+                    conditionVariable.notify_all();
+                }
+            });
+    if ((!clientSocket.is_valid()) || (!clientSocket.connect_to(echoSocket.get_socket_address())))
+    {
+        std::cerr << "Failed to create loopback client socket\n";
+        return -1;
+    }
+
+    std::jthread workerThread([&](std::stop_token const & stopToken)
+            {
+                while (!stopToken.stop_requested())
+                    virtualNetworkInterface.service_sockets();
+        });
+
+    std::atomic<std::uint64_t> completed = 0;
+    for (std::uint64_t sequence = 0; sequence < num_messages; )
+    {
+        bcpp::network::packet packet(sizeof(sequence));
+        packet.resize(sizeof(sequence));
+        std::memcpy(packet.data(), &sequence, sizeof(sequence));
+        if (clientSocket.send(std::move(packet), {[&](auto){++completed;}}))
+            ++sequence;
+        else
+            std::this_thread::yield(); // send queue is full
+    }
+
+    std::unique_lock uniqueLock(mutex);
+    if (!conditionVariable.wait_for(uniqueLock, 5s, [&](){return (echoed == num_messages);}))
+    {
+        std::cerr << "Failed to receive all echoes.  received = " << echoed << "\n";
+        return -1;
+    }
+    if ((!inOrder) || (completed != num_messages))
+    {
+        std::cerr << "Messages received out of order or send completions missing\n";
+        return -1;
+    }
+
+    std::cout << "\tverify that sending to an unbound address fails the send\n";
+    std::atomic<std::int32_t> errorCode = 0;
+    clientSocket.send_to({bcpp::network::ip_address("127.0.0.1"), bcpp::network::port_id(3001)}, bcpp::network::packet(8), 
+            {[&](auto, std::int32_t error){errorCode = error;}});
+    uniqueLock.unlock();
+    for (auto start = steady_clock::now(); (errorCode == 0) && (steady_clock::now() - start < 5s); )
+        std::this_thread::yield();
+    if (errorCode != ECONNREFUSED)
+    {
+        std::cerr << "Expected ECONNREFUSED sending to an unbound loopback address\n";
+        return -1;
+    }
+    std::cout << "success\n";
+    return 0;
+}
@@ -0,0 +1,197 @@
+#include <library/network.h>
+
+#include <iostream>
+#include <fstream>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+
+namespace
+{
+    static auto constexpr num_messages = 100;
+    static auto constexpr message_size = 2048;        // the udp read buffer size
+    static auto constexpr truncated_snap_length = 1024;
+    static auto constexpr udp_packet_overhead = 28; // synthesized ipv4 and udp headers
+
+
+    //=========================================================================
+    bool verify_pcap
+    (
+        // the capture of the client socket holds each send and each echo
+        char const * path,
+        std::size_t snapLength
+    )
+    {
+        using namespace bcpp::network;
+        std::ifstream stream(path, std::ios::binary);
+        pcap::file_header fileHeader;
+        stream.read(reinterpret_cast<char *>(&fileHeader), sizeof(fileHeader));
+        if ((!stream) || (fileHeader.magic_ != pcap::nanosecond_magic) || (fileHeader.linkType_ != pcap::linktype_raw))
+            return false;
+        auto count = 0;
+        pcap::record_header recordHeader;
+        while (stream.read(reinterpret_cast<char *>(&recordHeader), sizeof(recordHeader)))
+        {
+            std::vector<std::uint8_t> data(recordHeader.capturedLength_);
+            stream.read(reinterpret_cast<char *>(data.data()), data.size());
+            if ((recordHeader.capturedLength_ != (std::min<std::size_t>(message_size, snapLength) + udp_packet_overhead)) ||
+                    (recordHeader.originalLength_ != (message_size + udp_packet_overhead)) || (data[0] != 0x45) || (data[9] != IPPROTO_UDP))
+                return false;
+            ++count;
+        }
+        return (count == (num_messages * 2));
+    }
+
+
+    //=========================================================================
+    bool verify_pcapng
+    (
+        char const * path
+    )
+    {
+        using namespace bcpp::network;
+        std::ifstream stream(path, std::ios::binary);
+        std::vector<char> contents((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+        std::size_t offset = 0;
+        auto inbound = 0;
+        auto outbound = 0;
+        while ((offset + sizeof(pcapng::block_header)) <= contents.size())
+        {
+            pcapng::block_header blockHeader;
+            std::memcpy(&blockHeader, contents.data() + offset, sizeof(blockHeader));
+            if ((blockHeader.totalLength_ < 12) || ((offset + blockHeader.totalLength_) > contents.size()))
+                return false;
+            if (blockHeader.type_ == pcapng::enhanced_packet_block_type)
+            {
+                pcapng::enhanced_packet_block_trailer trailer;
+                std::memcpy(&trailer, contents.data() + offset + blockHeader.totalLength_ - sizeof(trailer), sizeof(trailer));
+                inbound += (trailer.flags_ == pcapng::epb_flags_inbound);
+                outbound += (trailer.flags_ == pcapng::epb_flags_outbound);
+            }
+            offset += blockHeader.totalLength_;
+        }
+        return ((offset == contents.size()) && (inbound == num_messages) && (outbound == num_messages));
+    }
+}
+
+
+//=============================================================================
+int main
+(
+    int,
+    char **
+)
+{
+    using namespace std::chrono;
+
+    std::cout << "create virtual network interface\n";
+    bcpp::network::virtual_network_interface virtualNetworkInterface;
+    if (!virtualNetworkInterface.is_valid())
+    {
+        std::cerr << "Failed to create virtual network interface\n";
+        return -1;
+    }
+
+    std::jthread pollerThread([&](std::stop_token const & stopToken)
+            {
+                while (!stopToken.stop_requested())
+                    virtualNetworkInterface.poll();
+            });
+    std::jthread workerThread([&](std::stop_token const & stopToken)
+            {
+                while (!stopToken.stop_requested())
+                    virtualNetworkInterface.service_sockets();
+            });
+
+    bcpp::network::udp_socket * echoSocketPtr = nullptr;
+    auto echoSocket = virtualNetworkInterface.create_udp_socket({},
+            {
+                .receiveHandler_ = [&](auto, bcpp::network::packet packet, auto source)
+                {
+                    echoSocketPtr->send_to(source, std::move(packet));
+                }
+            });
+    echoSocketPtr = &echoSocket;
+    if (!echoSocket.is_valid())
+    {
+        std::cerr << "Failed to create udp echo socket\n";
+        return -1;
+    }
+
+    struct capture_run
+    {
+        bcpp::network::capture_format   format_;
+        char const *                    path_;
+        std::size_t                     snapLength_;
+    };
+
+    for (auto [format, path, snapLength] : {capture_run{bcpp::network::capture_format::pcap, "/tmp/test_packet_capture.pcap", message_size},
+            capture_run{bcpp::network::capture_format::pcapng, "/tmp/test_packet_capture.pcapng", message_size},
+            capture_run{bcpp::network::capture_format::pcap, "/tmp/test_packet_capture_truncated.pcap", truncated_snap_length}})
+    {
+        std::cout << "\tcapture udp echo to " << path << "\n";
+        auto packetCapture = bcpp::network::packet_capture::create({.path_ = path, .format_ = format, .snapLength_ = snapLength});
+        if (!packetCapture)
+        {
+            std::cerr << "Failed to create packet capture\n";
+            return -1;
+        }
+
+        std::mutex mutex;
+        std::condition_variable conditionVariable;
+        auto echoed = 0;
+        {
+            auto clientSocket = virtualNetworkInterface.create_udp_socket({.packetCapture_ = packetCapture},
+                    {
+                        .receiveHandler_ = [&](auto, bcpp::network::packet, auto)
+                        {
+                            std::unique_lock uniqueLock(mutex);
+                            ++echoed;
+                            conditionVariable.notify_all();
+                        }
+                    });
+            if ((!clientSocket.is_valid()) || (clientSocket.connect_to(echoSocket.get_socket_address()) != bcpp::network::connect_result::success))
+            {
+                std::cerr << "Failed to create udp client socket\n";
+                return -1;
+            }
+            for (auto i = 0; i < num_messages; ++i)
+            {
+                bcpp::network::packet packet(message_size);
+                packet.resize(message_size);
+                clientSocket.send(std::move(packet));
+                std::unique_lock uniqueLock(mutex);
+                if (!conditionVariable.wait_for(uniqueLock, 5s, [&](){return (echoed == (i + 1));}))
+                {
+                    std::cerr << "Failed to receive echo\n";
+                    return -1;
+                }
+            }
+        }
+
+        auto statistics = packetCapture->get_statistics();
+        auto expectedTruncated = (snapLength < message_size) ? statistics.captured_ : 0;
+        if ((statistics.captured_ != (num_messages * 2)) || (statistics.dropped_ != 0) || (statistics.truncated_ != expectedTruncated))
+        {
+            std::cerr << "Unexpected capture statistics.  captured = " << statistics.captured_ << ", dropped = " << statistics.dropped_ << 
+                    ", truncated = " << statistics.truncated_ << "\n";
+            return -1;
+        }
+        // the socket releases its reference asynchronously.  destruction of the capture writes any queued packets.
+        while (packetCapture.use_count() > 1)
+            std::this_thread::yield();
+        packetCapture.reset();
+
+        std::cout << "\tverify capture file\n";
+        if (!((format == bcpp::network::capture_format::pcap) ? verify_pcap(path, snapLength) : verify_pcapng(path)))
+        {
+            std::cerr << "Invalid capture file\n";
+            return -1;
+        }
+    }
+    std::cout << "success\n";
+    return 0;
+}
@@ -4,6 +4,8 @@
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
+#include <optional>
+#include <vector>
 
 
 //=============================================================================
@@ -19,6 +21,138 @@ auto get_network_interface
 }
 
 
+//=============================================================================
+int test_peer_close
+(
+    // the peer closes while sends are queued.  every queued send's token must
+    // be invoked exactly once.  once a send has failed every later send must 
+    // fail (with a non zero errno) and the error is reported only once.
+    bcpp::network::virtual_network_interface & virtualNetworkInterface
+)
+{
+    using namespace std::chrono;
+
+    static auto constexpr num_sends = 4096;
+    static auto constexpr sends_before_peer_close = 256;
+    static auto constexpr sends_after_close = 256;
+    static auto constexpr packet_size = 1024;
+
+    struct send_result
+    {
+        std::atomic<std::uint32_t>  count_{0};
+        std::atomic<std::int32_t>   errorCode_{0};
+    };
+
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    std::optional<bcpp::network::tcp_socket> peerSocket;
+    auto closed = false;
+    std::atomic<std::uint32_t> sendErrorReports{0};
+    std::vector<send_result> sendResults(num_sends + sends_after_close);
+
+    std::cout << "\tclose peer while sends are queued\n";
+    auto tcpListenerSocket = virtualNetworkInterface.create_tcp_socket({.portId_ = bcpp::network::port_id_any}, 
+            {
+                .acceptHandler_ = [&](auto, bcpp::system::file_descriptor fileDescriptor)
+                {
+                    std::unique_lock uniqueLock(mutex);
+                    peerSocket.emplace(virtualNetworkInterface.accept_tcp_socket(std::move(fileDescriptor), {}, {}));
+                    conditionVariable.notify_all();
+                }
+            });
+    auto tcpSocket = virtualNetworkInterface.create_tcp_socket(tcpListenerSocket.get_socket_address(), {}, 
+            {
+                .closeHandler_ = [&](auto)
+                {
+                    std::unique_lock uniqueLock(mutex);
+                    closed = true;
+                    conditionVariable.notify_all();
+                },
+                .sendErrorHandler_ = [&](auto, auto){++sendErrorReports;}
+            });
+    std::unique_lock uniqueLock(mutex);
+    if ((!tcpSocket.is_valid()) || (!conditionVariable.wait_for(uniqueLock, 1s, [&](){return peerSocket.has_value();})))
+    {
+        std::cerr << "Failed to connect to tcp listener socket\n";
+        return -1;
+    }
+    uniqueLock.unlock();
+
+    auto send = [&](std::size_t index)
+            {
+                bcpp::network::packet packet(packet_size);
+                packet.resize(packet_size);
+                while (!tcpSocket.send(std::move(packet), bcpp::network::send_completion_token([&, index](void *, std::int32_t errorCode)
+                        {
+                            sendResults[index].errorCode_ = errorCode;
+                            ++sendResults[index].count_;
+                        })))
+                {
+                    std::this_thread::yield(); // send queue is full
+                    packet = bcpp::network::packet(packet_size);
+                    packet.resize(packet_size);
+                }
+            };
+    for (std::size_t i = 0; i < num_sends; ++i)
+    {
+        if (i == sends_before_peer_close)
+        {
+            std::unique_lock uniqueLock(mutex);
+            peerSocket.reset();
+        }
+        send(i);
+    }
+
+    // sends which are queued after the socket has closed must all fail
+    uniqueLock.lock();
+    if (!conditionVariable.wait_for(uniqueLock, 2s, [&](){return closed;}))
+    {
+        std::cerr << "Socket was not closed when its peer closed\n";
+        return -1;
+    }
+    uniqueLock.unlock();
+    for (std::size_t i = num_sends; i < sendResults.size(); ++i)
+        send(i);
+
+    auto allInvoked = [&]()
+            {
+                for (auto const & sendResult : sendResults)
+                    if (sendResult.count_ == 0)
+                        return false;
+                return true;
+            };
+    for (auto deadline = steady_clock::now() + 2s; (!allInvoked()) && (steady_clock::now() < deadline); )
+        std::this_thread::sleep_for(1ms);
+
+    auto failed = false;
+    for (std::size_t i = 0; i < sendResults.size(); ++i)
+    {
+        if (sendResults[i].count_ != 1)
+        {
+            std::cerr << "Send completion " << i << " invoked " << sendResults[i].count_ << " times\n";
+            return -1;
+        }
+        if ((failed) && (sendResults[i].errorCode_ == 0))
+        {
+            std::cerr << "Send " << i << " succeeded after an earlier send failed\n";
+            return -1;
+        }
+        failed |= (sendResults[i].errorCode_ != 0);
+    }
+    if ((!failed) || (sendResults.back().errorCode_ == 0))
+    {
+        std::cerr << "Expected the sends queued after the peer closed to fail\n";
+        return -1;
+    }
+    if (sendErrorReports != 1)
+    {
+        std::cerr << "Expected the send error to be reported once.  reported = " << sendErrorReports << "\n";
+        return -1;
+    }
+    return 0;
+}
+
+
 //=============================================================================
 int main
 (
@@ -75,7 +209,7 @@ int main
                 sendCompletion = true;
                 conditionVariable.notify_all();
             }};
-    tcpSocket.send(""_packet, sendCompletionToken);
+    tcpSocket.send(bcpp::network::packet{}, sendCompletionToken);
 
     std::unique_lock uniqueLock(mutex);
     if (!conditionVariable.wait_for(uniqueLock, 1s, [&](){return sendCompletion.load();}))
@@ -83,6 +217,10 @@ int main
         std::cerr << "Failed to receive send completion callback\n";
         return -1;
     }
+    uniqueLock.unlock();
+
+    if (test_peer_close(virtualNetworkInterface) != 0)
+        return -1;
     std::cout << "success\n";
     return 0;
 }
@@ -0,0 +1,135 @@
+#include <library/network.h>
+
+#include <iostream>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+#include <sys/socket.h>
+#include <poll.h>
+
+
+namespace
+{
+    static auto constexpr packet_size = (1 << 10);
+    static auto constexpr num_packets = (1 << 10);
+    // the send buffer is pinned (disabling autotuning) so that the kernel 
+    // absorbs far less than the high watermark while the peer is not reading.
+    // the queue can then not drain to the low watermark until the peer reads
+    static auto constexpr socket_send_buffer_size = ((1 << 10) * 64);
+    static auto constexpr high_watermark_bytes = ((1 << 10) * 512);
+    static auto constexpr low_watermark_bytes = ((1 << 10) * 64);
+}
+
+
+//=============================================================================
+int main
+(
+    int,
+    char **
+)
+{
+    using namespace std::chrono;
+
+    std::cout << "create virtual network interface\n";
+    bcpp::network::virtual_network_interface virtualNetworkInterface;
+    if (!virtualNetworkInterface.is_valid())
+    {
+        std::cerr << "Failed to create virtual network interface\n";
+        return -1;
+    }
+
+    std::jthread workerThread([&](std::stop_token const & stopToken)
+            {
+                while (!stopToken.stop_requested())
+                {
+                    virtualNetworkInterface.poll();
+                    virtualNetworkInterface.service_sockets();
+                }
+            });
+
+    // the accepted connection is not given to a socket so that nothing is read 
+    // from it (and the send queue backs up) until the test chooses to
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    bcpp::system::file_descriptor peerFileDescriptor;
+    std::atomic<std::uint32_t> highEvents{0};
+    std::atomic<std::uint32_t> drainedEvents{0};
+    std::cout << "\tcreate tcp listener socket\n";
+    auto tcpListenerSocket = virtualNetworkInterface.create_tcp_socket({.portId_ = bcpp::network::port_id_any}, 
+            {
+                .acceptHandler_ = [&](auto, bcpp::system::file_descriptor fileDescriptor)
+                {
+                    std::unique_lock uniqueLock(mutex);
+                    peerFileDescriptor = std::move(fileDescriptor);
+                    conditionVariable.notify_all();
+                }
+            });
+    if (!tcpListenerSocket.is_valid())
+    {
+        std::cerr << "Failed to create tcp listener socket\n";
+        return -1;
+    }
+
+    auto tcpSocket = virtualNetworkInterface.create_tcp_socket(tcpListenerSocket.get_socket_address(), 
+            {
+                .socketSendBufferSize_ = socket_send_buffer_size,
+                .sendQueueHighWatermarkBytes_ = high_watermark_bytes,
+                .sendQueueLowWatermarkBytes_ = low_watermark_bytes
+            },
+            {
+                .sendQueueHighHandler_ = [&](auto){++highEvents;},
+                .sendQueueDrainedHandler_ = [&](auto){++drainedEvents;}
+            });
+    std::unique_lock uniqueLock(mutex);
+    if ((!tcpSocket.is_valid()) || (!conditionVariable.wait_for(uniqueLock, 1s, [&](){return peerFileDescriptor.is_valid();})))
+    {
+        std::cerr << "Failed to connect to tcp listener socket\n";
+        return -1;
+    }
+    uniqueLock.unlock();
+
+    std::cout << "\tfill the send queue past the high watermark\n";
+    for (auto i = 0; i < num_packets; ++i)
+    {
+        bcpp::network::packet packet(packet_size);
+        packet.resize(packet_size);
+        if (!tcpSocket.send(std::move(packet)))
+        {
+            std::cerr << "Send queue unexpectedly full\n";
+            return -1;
+        }
+    }
+    std::this_thread::sleep_for(100ms);
+    if ((highEvents != 1) || (drainedEvents != 0))
+    {
+        std::cerr << "Expected one high event and no drained event.  high = " << highEvents << ", drained = " << drainedEvents << "\n";
+        return -1;
+    }
+
+    std::cout << "\tdrain the send queue below the low watermark\n";
+    std::size_t received = 0;
+    for (auto deadline = steady_clock::now() + 5s; (received < (num_packets * packet_size)) && (steady_clock::now() < deadline); )
+    {
+        ::pollfd pollFileDescriptor{.fd = peerFileDescriptor.get(), .events = POLLIN};
+        if (::poll(&pollFileDescriptor, 1, 100) <= 0)
+            continue;
+        char buffer[packet_size * 64];
+        if (auto result = ::recv(peerFileDescriptor.get(), buffer, sizeof(buffer), 0); result > 0)
+            received += result;
+    }
+    std::this_thread::sleep_for(100ms);
+    if (received != (num_packets * packet_size))
+    {
+        std::cerr << "Failed to receive data.  received = " << received << "\n";
+        return -1;
+    }
+    if ((highEvents != 1) || (drainedEvents != 1))
+    {
+        std::cerr << "Expected exactly one high and one drained event.  high = " << highEvents << ", drained = " << drainedEvents << "\n";
+        return -1;
+    }
+    std::cout << "success\n";
+    return 0;
+}
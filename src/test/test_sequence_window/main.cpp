@@ -0,0 +1,97 @@
+#include <library/network/arbitration/sequence_window.h>
+
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <cstdint>
+
+
+//=============================================================================
+int main
+(
+    int,
+    char **
+)
+{
+    using claim_type = bcpp::network::sequence_window::claim_type;
+
+    std::cout << "single feed with gap and recovery\n";
+    {
+        bcpp::network::sequence_window sequenceWindow(64);
+        if ((sequenceWindow.claim(100).type_ != claim_type::next) || (sequenceWindow.claim(101).type_ != claim_type::next))
+        {
+            std::cerr << "expected next\n";
+            return -1;
+        }
+        if (auto [type, gapBegin, gapEnd] = sequenceWindow.claim(105); (type != claim_type::gap) || (gapBegin != 102) || (gapEnd != 105))
+        {
+            std::cerr << "expected gap of [102, 105)\n";
+            return -1;
+        }
+        if ((sequenceWindow.claim(103).type_ != claim_type::recovered) || (sequenceWindow.claim(103).type_ != claim_type::duplicate))
+        {
+            std::cerr << "expected recovery followed by duplicate\n";
+            return -1;
+        }
+        if (sequenceWindow.claim(101).type_ != claim_type::duplicate)
+        {
+            std::cerr << "expected duplicate\n";
+            return -1;
+        }
+    }
+
+    static auto constexpr number_of_sequences = (1 << 18);
+    std::cout << "two concurrent feeds carrying " << number_of_sequences << " sequences\n";
+    {
+        bcpp::network::sequence_window sequenceWindow(1 << 10);
+        std::vector<std::atomic<std::uint32_t>> forwarded(number_of_sequences);
+        std::atomic<std::uint64_t> gaps{0};
+        std::atomic<std::uint64_t> recoveries{0};
+        std::atomic<bool> start{false};
+        std::vector<std::jthread> feeds;
+        for (auto feed = 0; feed < 2; ++feed)
+            feeds.emplace_back([&]()
+                    {
+                        while (!start)
+                            std::this_thread::yield();
+                        for (std::uint64_t sequence = 0; sequence < number_of_sequences; ++sequence)
+                        {
+                            if ((sequence % 1024) == 0)
+                                std::this_thread::yield();
+                            auto type = sequenceWindow.claim(sequence).type_;
+                            if (type != claim_type::duplicate)
+                                ++forwarded[sequence];
+                            if (type == claim_type::gap)
+                                ++gaps;
+                            if (type == claim_type::recovered)
+                                ++recoveries;
+                        }
+                    });
+        start = true;
+        feeds.clear();
+
+        for (std::uint64_t sequence = 0; sequence < number_of_sequences; ++sequence)
+        {
+            if (forwarded[sequence] != 1)
+            {
+                std::cerr << "sequence " << sequence << " forwarded " << forwarded[sequence] << " times\n";
+                return -1;
+            }
+        }
+        if (sequenceWindow.get_highest_sequence() != (number_of_sequences - 1))
+        {
+            std::cerr << "unexpected highest sequence\n";
+            return -1;
+        }
+        if ((gaps != 0) || (recoveries != 0))
+        {
+            // neither feed lost a message so interleaving of the feeds must not be reported as loss
+            std::cerr << "unexpected gaps (" << gaps << ") or recoveries (" << recoveries << ")\n";
+            return -1;
+        }
+    }
+
+    std::cout << "success\n";
+    return 0;
+}
@@ -0,0 +1,96 @@
+#include <library/network.h>
+
+#include <iostream>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstring>
+
+
+//=============================================================================
+int main
+(
+    int,
+    char **
+)
+{
+    using namespace std::chrono;
+    static auto constexpr num_messages = 100'000;
+
+    std::cout << "create virtual network interface\n";
+    bcpp::network::virtual_network_interface virtualNetworkInterface;
+    if (!virtualNetworkInterface.is_valid())
+    {
+        std::cerr << "Failed to create virtual network interface\n";
+        return -1;
+    }
+
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    std::uint64_t received = 0;
+    bool inOrder = true;
+
+    std::cout << "\tcreate shared memory receiver\n";
+    auto receiver = virtualNetworkInterface.create_shared_memory_socket("test_shared_memory_socket", 
+            {.mode_ = bcpp::network::shared_memory_mode::receive, .capacity_ = 256},
+            {
+                .receiveHandler_ = [&](auto, bcpp::network::packet packet, auto)
+                {
+                    // the packet refers to the message within the ring
+                    std::uint64_t sequence;
+                    std::memcpy(&sequence, packet.data(), sizeof(sequence));
+                    std::unique_lock uniqueLock(mutex);
+                    inOrder &= (sequence == received);
+                    ++received;
+                    conditionVariable.notify_all();
+                }
+            });
+    if (!receiver.is_valid())
+    {
+        std::cerr << "Failed to create shared memory receiver\n";
+        return -1;
+    }
+
+    std::cout << "\tcreate shared memory sender\n";
+    auto sender = virtualNetworkInterface.create_shared_memory_socket("test_shared_memory_socket", 
+            {.mode_ = bcpp::network::shared_memory_mode::send}, {});
+    if (!sender.is_valid())
+    {
+        std::cerr << "Failed to create shared memory sender\n";
+        return -1;
+    }
+
+    std::jthread workerThread([&](std::stop_token const & stopToken)
+            {
+                while (!stopToken.stop_requested())
+                {
+                    virtualNetworkInterface.poll();
+                    virtualNetworkInterface.service_sockets();
+                }
+        });
+
+    for (std::uint64_t sequence = 0; sequence < num_messages; )
+    {
+        bcpp::network::packet packet(sizeof(sequence));
+        packet.resize(sizeof(sequence));
+        std::memcpy(packet.data(), &sequence, sizeof(sequence));
+        if (sender.send(std::move(packet)))
+            ++sequence;
+        else
+            std::this_thread::yield(); // ring is full
+    }
+
+    std::unique_lock uniqueLock(mutex);
+    if (!conditionVariable.wait_for(uniqueLock, 5s, [&](){return (received == num_messages);}))
+    {
+        std::cerr << "Failed to receive all messages.  received = " << received << "\n";
+        return -1;
+    }
+    if (!inOrder)
+    {
+        std::cerr << "Messages received out of order\n";
+        return -1;
+    }
+    std::cout << "success\n";
+    return 0;
+}
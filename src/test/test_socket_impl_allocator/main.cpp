@@ -0,0 +1,76 @@
+#include <library/network/socket/private/socket_impl_allocator.h>
+
+#include <iostream>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace
+{
+    // stands in for a socket impl (which contains cache line aligned queues)
+    struct alignas(64) over_aligned
+    {
+        std::byte contents_[1000];
+    };
+
+
+    //=========================================================================
+    bool is_aligned
+    (
+        void const * address,
+        std::size_t alignment
+    )
+    {
+        return ((reinterpret_cast<std::uintptr_t>(address) % alignment) == 0);
+    }
+}
+
+
+//=============================================================================
+int main
+(
+    int,
+    char **
+)
+{
+    using allocator = bcpp::network::socket_impl_allocator;
+    static auto constexpr blocks_per_size = 64;
+
+    std::cout << "allocate every size class\n";
+    for (auto alignment : {alignof(std::max_align_t), alignof(over_aligned), allocator::block_alignment * 2})
+    {
+        for (std::size_t size = 1; size <= (allocator::max_pooled_size + allocator::size_class_granularity); size += 61)
+        {
+            // twice so that the second round is drawn from the free lists
+            for (auto round = 0; round < 2; ++round)
+            {
+                std::vector<void *> blocks;
+                for (auto i = 0; i < blocks_per_size; ++i)
+                {
+                    blocks.push_back(allocator::get().allocate(size, alignment));
+                    if (!is_aligned(blocks.back(), alignment))
+                    {
+                        std::cerr << "Misaligned block.  size = " << size << ", alignment = " << alignment << "\n";
+                        return -1;
+                    }
+                }
+                for (auto block : blocks)
+                    allocator::get().release(block, size, alignment);
+            }
+        }
+    }
+
+    std::cout << "allocate over aligned type\n";
+    auto statistics = allocator::get().get_statistics();
+    auto * block = allocator::get().allocate(sizeof(over_aligned), alignof(over_aligned));
+    if ((!is_aligned(block, alignof(over_aligned))) || (allocator::get().get_statistics().poolHits_ != (statistics.poolHits_ + 1)))
+    {
+        std::cerr << "Expected an aligned block from the free list\n";
+        return -1;
+    }
+    allocator::get().release(block, sizeof(over_aligned), alignof(over_aligned));
+
+    std::cout << "success\n";
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <library/network.h>
+
+#include <iostream>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+
+//=============================================================================
+int main
+(
+    int,
+    char **
+)
+{
+    using namespace std::chrono;
+
+    bcpp::network::virtual_network_interface virtualNetworkInterface;
+
+    std::cout << "create one shot and periodic timers\n";
+    std::atomic<std::int32_t> oneShotCount{0};
+    std::atomic<std::int32_t> periodicCount{0};
+    std::atomic<std::int32_t> cancelledCount{0};
+    auto oneShotTimer = virtualNetworkInterface.create_timer({}, {.expiryHandler_ = [&](){++oneShotCount;}});
+    auto periodicTimer = virtualNetworkInterface.create_timer({.period_ = milliseconds(10)}, {.expiryHandler_ = [&](){++periodicCount;}});
+    auto cancelledTimer = virtualNetworkInterface.create_timer({}, {.expiryHandler_ = [&](){++cancelledCount;}});
+
+    auto startTime = steady_clock::now();
+    oneShotTimer.start(milliseconds(25));
+    periodicTimer.start(milliseconds(10));
+    cancelledTimer.start(milliseconds(20));
+    cancelledTimer.stop();
+
+    std::cout << "\tpoll for 105 ms\n";
+    auto oneShotExpiry = steady_clock::time_point{};
+    while (steady_clock::now() < (startTime + milliseconds(105)))
+    {
+        virtualNetworkInterface.poll(milliseconds(50));
+        virtualNetworkInterface.service_sockets();
+        if ((oneShotCount > 0) && (oneShotExpiry == steady_clock::time_point{}))
+            oneShotExpiry = steady_clock::now();
+    }
+    periodicTimer.stop();
+
+    if (oneShotCount != 1)
+    {
+        std::cerr << "one shot timer expired " << oneShotCount << " times\n";
+        return -1;
+    }
+    if ((oneShotExpiry - startTime) < milliseconds(25))
+    {
+        std::cerr << "one shot timer expired early\n";
+        return -1;
+    }
+    if ((periodicCount < 9) || (periodicCount > 10))
+    {
+        std::cerr << "periodic timer expired " << periodicCount << " times\n";
+        return -1;
+    }
+    if (cancelledCount != 0)
+    {
+        std::cerr << "cancelled timer expired\n";
+        return -1;
+    }
+    std::cout << "success\n";
+    return 0;
+}
@@ -0,0 +1,83 @@
+#include <library/network/instrumentation/trace.h>
+
+#include <iostream>
+#include <fstream>
+#include <thread>
+#include <vector>
+#include <cstring>
+#include <cstdio>
+
+
+//=============================================================================
+int main
+(
+    int,
+    char **
+)
+{
+    using namespace bcpp::network;
+    static auto constexpr num_threads = 4;
+    static auto constexpr ring_capacity = 1024;
+    static auto constexpr events_per_thread = 3000; // wraps each ring
+
+    auto & traceRecorder = trace_recorder::get();
+
+    std::cout << "record while disabled\n";
+    traceRecorder.record(trace_event_type::receive, 1, 100);
+
+    std::cout << "record from " << num_threads << " threads\n";
+    traceRecorder.enable(ring_capacity);
+    {
+        std::vector<std::jthread> threads;
+        for (auto i = 0; i < num_threads; ++i)
+            threads.emplace_back([&, i]()
+                    {
+                        for (auto j = 0; j < events_per_thread; ++j)
+                            traceRecorder.record(trace_event_type::send, i + 1, j);
+                    });
+    }
+    traceRecorder.disable();
+
+    std::cout << "\tdump\n";
+    auto path = "/tmp/test_trace.bin";
+    if (!traceRecorder.dump(path))
+    {
+        std::cerr << "Failed to dump trace\n";
+        return -1;
+    }
+
+    std::cout << "\tverify dump\n";
+    std::ifstream stream(path, std::ios::binary);
+    trace_file_header fileHeader;
+    stream.read(reinterpret_cast<char *>(&fileHeader), sizeof(fileHeader));
+    if ((std::memcmp(fileHeader.magic_, trace_file_header::magic, sizeof(fileHeader.magic_)) != 0) || (fileHeader.ringCount_ != num_threads))
+    {
+        std::cerr << "Invalid trace file header\n";
+        return -1;
+    }
+    for (auto i = 0u; i < fileHeader.ringCount_; ++i)
+    {
+        trace_ring_header ringHeader;
+        stream.read(reinterpret_cast<char *>(&ringHeader), sizeof(ringHeader));
+        if (ringHeader.eventCount_ != ring_capacity)
+        {
+            std::cerr << "Expected the most recent " << ring_capacity << " events but found " << ringHeader.eventCount_ << "\n";
+            return -1;
+        }
+        std::vector<trace_event> events(ringHeader.eventCount_);
+        stream.read(reinterpret_cast<char *>(events.data()), events.size() * sizeof(trace_event));
+        for (auto j = 0u; j < events.size(); ++j)
+        {
+            // oldest first and all from the same thread (socket id)
+            if ((events[j].type_ != trace_event_type::send) || (events[j].value_ != static_cast<std::int32_t>(events_per_thread - ring_capacity + j)) ||
+                    (events[j].socketId_ != events[0].socketId_) || ((j > 0) && (events[j].tsc_ < events[j - 1].tsc_)))
+            {
+                std::cerr << "Unexpected event in ring " << i << "\n";
+                return -1;
+            }
+        }
+    }
+    std::remove(path);
+    std::cout << "success\n";
+    return 0;
+}
@@ -0,0 +1,151 @@
+#include <library/network.h>
+
+#include <iostream>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <cstdint>
+#include <cerrno>
+
+
+namespace
+{
+    static auto constexpr segment_size = 1000;
+    static auto constexpr num_segments = 5;
+    static auto constexpr last_segment_size = 500;
+    static auto constexpr gso_packet_size = (((num_segments - 1) * segment_size) + last_segment_size);
+    static auto constexpr oversized_datagram_size = 4000;   // larger than the default udp read buffer
+    static auto constexpr datagram_size = 100;
+}
+
+
+//=============================================================================
+int main
+(
+    int,
+    char **
+)
+{
+    using namespace std::chrono;
+
+    std::cout << "create virtual network interface\n";
+    bcpp::network::virtual_network_interface virtualNetworkInterface;
+    if (!virtualNetworkInterface.is_valid())
+    {
+        std::cerr << "Failed to create virtual network interface\n";
+        return -1;
+    }
+
+    std::jthread workerThread([&](std::stop_token const & stopToken)
+            {
+                while (!stopToken.stop_requested())
+                {
+                    virtualNetworkInterface.poll();
+                    virtualNetworkInterface.service_sockets();
+                }
+            });
+
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+
+    std::cout << "\tsend one packet of " << num_segments << " segments with UDP_SEGMENT and receive with UDP_GRO\n";
+    {
+        // each received packet is split back into datagrams of the reported segment size
+        std::vector<std::size_t> datagramSizes;
+        bool corrupt = false;
+        auto receiver = virtualNetworkInterface.create_udp_socket({}, 
+                {
+                    .segmentedReceiveHandler_ = [&](auto, bcpp::network::packet packet, auto, std::size_t segmentSize)
+                    {
+                        std::unique_lock uniqueLock(mutex);
+                        for (std::size_t offset = 0; offset < packet.size(); offset += segmentSize)
+                        {
+                            auto size = std::min(segmentSize, packet.size() - offset);
+                            for (std::size_t i = 0; i < size; ++i)
+                                corrupt |= (packet.data()[offset + i] != static_cast<std::uint8_t>(datagramSizes.size()));
+                            datagramSizes.push_back(size);
+                        }
+                        conditionVariable.notify_all();
+                    }
+                });
+        auto sender = virtualNetworkInterface.create_udp_socket({.sendSegmentSize_ = segment_size}, {});
+        if ((!receiver.is_valid()) || (!sender.is_valid()))
+        {
+            std::cerr << "Failed to create udp sockets\n";
+            return -1;
+        }
+
+        bcpp::network::packet packet(gso_packet_size);
+        packet.resize(gso_packet_size);
+        for (std::size_t i = 0; i < gso_packet_size; ++i)
+            packet.data()[i] = static_cast<std::uint8_t>(i / segment_size); // the index of the segment
+        sender.send_to(receiver.get_socket_address(), std::move(packet));
+
+        std::unique_lock uniqueLock(mutex);
+        if (!conditionVariable.wait_for(uniqueLock, 1s, [&](){return (datagramSizes.size() >= num_segments);}))
+        {
+            std::cerr << "Failed to receive segments.  received = " << datagramSizes.size() << "\n";
+            return -1;
+        }
+        std::this_thread::sleep_for(50ms); // allow for any unexpected extra datagrams
+        if (datagramSizes != std::vector<std::size_t>{segment_size, segment_size, segment_size, segment_size, last_segment_size})
+        {
+            std::cerr << "Unexpected datagram sizes\n";
+            return -1;
+        }
+        if (corrupt)
+        {
+            std::cerr << "Corrupt segment payload\n";
+            return -1;
+        }
+    }
+
+    std::cout << "\tdrop a datagram which is larger than the read buffer\n";
+    {
+        std::vector<std::size_t> datagramSizes;
+        std::vector<std::int32_t> receiveErrors;
+        auto receiver = virtualNetworkInterface.create_udp_socket({}, 
+                {
+                    .receiveErrorHandler_ = [&](auto, std::int32_t errorCode)
+                    {
+                        std::unique_lock uniqueLock(mutex);
+                        receiveErrors.push_back(errorCode);
+                        conditionVariable.notify_all();
+                    },
+                    .multicastReceiveHandler_ = [&](auto, bcpp::network::packet packet, auto, auto)
+                    {
+                        std::unique_lock uniqueLock(mutex);
+                        datagramSizes.push_back(packet.size());
+                        conditionVariable.notify_all();
+                    }
+                });
+        auto sender = virtualNetworkInterface.create_udp_socket({}, {});
+        if ((!receiver.is_valid()) || (!sender.is_valid()))
+        {
+            std::cerr << "Failed to create udp sockets\n";
+            return -1;
+        }
+
+        for (auto size : {oversized_datagram_size, datagram_size})
+        {
+            bcpp::network::packet packet(size);
+            packet.resize(size);
+            sender.send_to(receiver.get_socket_address(), std::move(packet));
+        }
+
+        std::unique_lock uniqueLock(mutex);
+        if (!conditionVariable.wait_for(uniqueLock, 1s, [&](){return (!datagramSizes.empty()) && (!receiveErrors.empty());}))
+        {
+            std::cerr << "Failed to receive datagram and error\n";
+            return -1;
+        }
+        if ((datagramSizes != std::vector<std::size_t>{datagram_size}) || (receiveErrors != std::vector<std::int32_t>{EMSGSIZE}))
+        {
+            std::cerr << "Expected the oversized datagram to be dropped with EMSGSIZE\n";
+            return -1;
+        }
+    }
+
+    std::cout << "success\n";
+    return 0;
+}
@@ -0,0 +1,125 @@
+#include <library/network.h>
+
+#include <iostream>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <string>
+#include <vector>
+
+
+//=============================================================================
+template <bcpp::network::network_transport_protocol P>
+int test_unix_socket
+(
+    bcpp::network::virtual_network_interface & virtualNetworkInterface,
+    bcpp::network::unix_socket_path unixSocketPath
+)
+{
+    using namespace std::chrono;
+
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    std::vector<bcpp::network::active_socket<P>> acceptedSockets;
+    std::string received;
+    auto peerClosed = false;
+    std::string const expected = "hello0hello1hello2";
+
+    std::cout << "\tcreate unix listener socket " << unixSocketPath << "\n";
+    auto listenerSocket = virtualNetworkInterface.create_unix_listener_socket<P>(unixSocketPath, {}, 
+            {
+                .acceptHandler_ = [&](auto, bcpp::system::file_descriptor fileDescriptor)
+                {
+                    std::cout << "\taccepted connection\n";
+                    std::unique_lock uniqueLock(mutex);
+                    acceptedSockets.push_back(virtualNetworkInterface.accept_unix_socket<P>(std::move(fileDescriptor), {},
+                            {
+                                .closeHandler_ = [&](auto)
+                                {
+                                    std::unique_lock uniqueLock(mutex);
+                                    peerClosed = true;
+                                    conditionVariable.notify_all();
+                                },
+                                .receiveHandler_ = [&](auto, bcpp::network::packet packet, auto)
+                                {
+                                    std::unique_lock uniqueLock(mutex);
+                                    received.append(reinterpret_cast<char const *>(packet.data()), packet.size());
+                                    conditionVariable.notify_all();
+                                }
+                            }));
+                }
+            });
+    if (!listenerSocket.is_valid())
+    {
+        std::cerr << "Failed to create unix listener socket\n";
+        return -1;
+    }
+
+    auto unixSocket = virtualNetworkInterface.create_unix_socket<P>(unixSocketPath, {}, {});
+    if (!unixSocket.is_connected())
+    {
+        std::cerr << "Failed to connect to unix listener socket\n";
+        return -1;
+    }
+
+    for (auto i = 0; i < 3; ++i)
+    {
+        auto message = "hello" + std::to_string(i);
+        bcpp::network::packet packet(message.size());
+        packet.resize(message.size());
+        std::copy(message.begin(), message.end(), reinterpret_cast<char *>(packet.data()));
+        unixSocket.send(std::move(packet));
+    }
+
+    std::unique_lock uniqueLock(mutex);
+    if (!conditionVariable.wait_for(uniqueLock, 1s, [&](){return (received == expected);}))
+    {
+        std::cerr << "Failed to receive data.  received = " << received << "\n";
+        return -1;
+    }
+
+    std::cout << "\tclose unix socket\n";
+    unixSocket.close();
+    if (!conditionVariable.wait_for(uniqueLock, 1s, [&](){return peerClosed;}))
+    {
+        std::cerr << "Accepted socket was not closed when its peer closed\n";
+        return -1;
+    }
+    return 0;
+}
+
+
+//=============================================================================
+int main
+(
+    int,
+    char **
+)
+{
+    std::cout << "create virtual network interface\n";
+    bcpp::network::virtual_network_interface virtualNetworkInterface;
+    if (!virtualNetworkInterface.is_valid())
+    {
+        std::cerr << "Failed to create virtual network interface\n";
+        return -1;
+    }
+
+    std::jthread workerThread([&](std::stop_token const & stopToken)
+            {
+                while (!stopToken.stop_requested())
+                {
+                    virtualNetworkInterface.poll();
+                    virtualNetworkInterface.service_sockets();
+                }
+        });
+
+    using enum bcpp::network::network_transport_protocol;
+    if (test_unix_socket<unix_stream>(virtualNetworkInterface, "/tmp/test_unix_stream_socket") != 0)
+        return -1;
+    if (test_unix_socket<unix_seqpacket>(virtualNetworkInterface, "/tmp/test_unix_seqpacket_socket") != 0)
+        return -1;
+    if (test_unix_socket<unix_stream>(virtualNetworkInterface, "@test_unix_abstract_socket") != 0)
+        return -1;
+    std::cout << "success\n";
+    return 0;
+}
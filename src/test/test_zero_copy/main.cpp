@@ -0,0 +1,159 @@
+#include <library/network.h>
+
+#include <iostream>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <cstdint>
+
+#include <sys/socket.h>
+#include <poll.h>
+
+
+namespace
+{
+    static auto constexpr num_packets = 16;
+    static auto constexpr packet_size = ((1 << 10) * 64);
+    static auto constexpr zero_copy_threshold = ((1 << 10) * 4);
+
+
+    //=========================================================================
+    std::uint8_t get_payload_byte
+    (
+        std::size_t packetIndex,
+        std::size_t offset
+    )
+    {
+        return static_cast<std::uint8_t>((packetIndex * 7) + offset);
+    }
+}
+
+
+//=============================================================================
+int main
+(
+    int,
+    char **
+)
+{
+    using namespace std::chrono;
+
+    std::cout << "create virtual network interface\n";
+    bcpp::network::virtual_network_interface virtualNetworkInterface;
+    if (!virtualNetworkInterface.is_valid())
+    {
+        std::cerr << "Failed to create virtual network interface\n";
+        return -1;
+    }
+
+    std::jthread workerThread([&](std::stop_token const & stopToken)
+            {
+                while (!stopToken.stop_requested())
+                {
+                    virtualNetworkInterface.poll();
+                    virtualNetworkInterface.service_sockets();
+                }
+            });
+
+    // the accepted connection is not given to a socket so that nothing is read 
+    // from it until the test chooses to.  until then the kernel keeps the pages
+    // of the zero copy sends which do not fit in the peer's receive window pinned.
+    std::mutex mutex;
+    std::condition_variable conditionVariable;
+    bcpp::system::file_descriptor peerFileDescriptor;
+    std::vector<std::size_t> completed;
+    std::cout << "\tcreate tcp listener socket\n";
+    auto tcpListenerSocket = virtualNetworkInterface.create_tcp_socket({.portId_ = bcpp::network::port_id_any}, 
+            {
+                .acceptHandler_ = [&](auto, bcpp::system::file_descriptor fileDescriptor)
+                {
+                    std::unique_lock uniqueLock(mutex);
+                    peerFileDescriptor = std::move(fileDescriptor);
+                    conditionVariable.notify_all();
+                }
+            });
+    if (!tcpListenerSocket.is_valid())
+    {
+        std::cerr << "Failed to create tcp listener socket\n";
+        return -1;
+    }
+
+    auto tcpSocket = virtualNetworkInterface.create_tcp_socket(tcpListenerSocket.get_socket_address(), 
+            {.zeroCopyThreshold_ = zero_copy_threshold}, {});
+    std::unique_lock uniqueLock(mutex);
+    if ((!tcpSocket.is_valid()) || (!conditionVariable.wait_for(uniqueLock, 1s, [&](){return peerFileDescriptor.is_valid();})))
+    {
+        std::cerr << "Failed to connect to tcp listener socket\n";
+        return -1;
+    }
+    uniqueLock.unlock();
+
+    std::cout << "\tsend " << num_packets << " packets of " << packet_size << " bytes with MSG_ZEROCOPY\n";
+    for (std::size_t i = 0; i < num_packets; ++i)
+    {
+        bcpp::network::packet packet(packet_size);
+        packet.resize(packet_size);
+        for (std::size_t j = 0; j < packet_size; ++j)
+            packet.data()[j] = get_payload_byte(i, j);
+        tcpSocket.send(std::move(packet), bcpp::network::send_completion_token([&, i](void *, std::int32_t errorCode)
+                {
+                    std::unique_lock uniqueLock(mutex);
+                    completed.push_back((errorCode == 0) ? i : ~std::size_t(0));
+                    conditionVariable.notify_all();
+                }));
+    }
+
+    // the peer's receive window can hold only a fraction of the data so at least 
+    // the last sends are still referenced by the kernel.  they must not complete.
+    std::this_thread::sleep_for(200ms);
+    uniqueLock.lock();
+    if (completed.size() >= num_packets)
+    {
+        std::cerr << "Sends completed while the kernel could still reference the packets\n";
+        return -1;
+    }
+    uniqueLock.unlock();
+
+    std::cout << "\treceive and verify payload\n";
+    std::vector<std::uint8_t> received;
+    received.reserve(num_packets * packet_size);
+    for (auto deadline = steady_clock::now() + 5s; (received.size() < (num_packets * packet_size)) && (steady_clock::now() < deadline); )
+    {
+        ::pollfd pollFileDescriptor{.fd = peerFileDescriptor.get(), .events = POLLIN};
+        if (::poll(&pollFileDescriptor, 1, 100) <= 0)
+            continue;
+        std::uint8_t buffer[packet_size];
+        if (auto result = ::recv(peerFileDescriptor.get(), buffer, sizeof(buffer), 0); result > 0)
+            received.insert(received.end(), buffer, buffer + result);
+    }
+    if (received.size() != (num_packets * packet_size))
+    {
+        std::cerr << "Failed to receive data.  received = " << received.size() << "\n";
+        return -1;
+    }
+    for (std::size_t i = 0; i < received.size(); ++i)
+    {
+        if (received[i] != get_payload_byte(i / packet_size, i % packet_size))
+        {
+            std::cerr << "Corrupt payload at offset " << i << "\n";
+            return -1;
+        }
+    }
+
+    uniqueLock.lock();
+    if (!conditionVariable.wait_for(uniqueLock, 2s, [&](){return (completed.size() == num_packets);}))
+    {
+        std::cerr << "Failed to receive send completions.  completed = " << completed.size() << "\n";
+        return -1;
+    }
+    for (std::size_t i = 0; i < num_packets; ++i)
+    {
+        if (completed[i] != i)
+        {
+            std::cerr << "Send completion " << i << " out of order or failed\n";
+            return -1;
+        }
+    }
+    std::cout << "success\n";
+    return 0;
+}
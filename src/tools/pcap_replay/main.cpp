@@ -0,0 +1,599 @@
+#include <library/network.h>
+#include <library/network/capture/pcap_format.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+
+namespace
+{
+
+    using namespace bcpp::network;
+
+    static auto constexpr spin_threshold = std::chrono::microseconds(200);
+    static auto constexpr send_queue_size = (1 << 16);
+    static auto constexpr completion_timeout = std::chrono::seconds(5);
+
+    static auto constexpr linktype_null = 0;
+    static auto constexpr linktype_ethernet = 1;
+    static auto constexpr linktype_linux_sll = 113;
+    static auto constexpr linktype_ipv4 = 228;
+    static auto constexpr linktype_linux_sll2 = 276;
+
+    static auto constexpr ethertype_ipv4 = 0x0800;
+    static auto constexpr ethertype_vlan = 0x8100;
+    static auto constexpr ethertype_qinq = 0x88a8;
+
+
+    //=========================================================================
+    // a udp payload within the capture file along with its original destination
+    struct replay_packet
+    {
+        std::uint64_t   timeStamp_;     // nanoseconds
+        socket_address  destination_;
+        std::size_t     offset_;
+        std::size_t     length_;
+    };
+
+
+    //=========================================================================
+    struct capture_contents
+    {
+        std::vector<std::uint8_t>   data_;
+        std::vector<replay_packet>  packets_;
+        std::uint64_t               skipped_{0};    // not ipv4 udp, fragmented or truncated
+    };
+
+
+    //=========================================================================
+    std::uint16_t get_uint16
+    (
+        // a field in the byte order of the capture file
+        std::uint8_t const * source,
+        bool swap
+    )
+    {
+        std::uint16_t value;
+        std::memcpy(&value, source, sizeof(value));
+        return swap ? static_cast<std::uint16_t>((value >> 8) | (value << 8)) : value;
+    }
+
+
+    //=========================================================================
+    std::uint32_t get_uint32
+    (
+        // a field in the byte order of the capture file
+        std::uint8_t const * source,
+        bool swap
+    )
+    {
+        std::uint32_t value;
+        std::memcpy(&value, source, sizeof(value));
+        return swap ? ((value >> 24) | ((value >> 8) & 0xff00) | ((value << 8) & 0xff0000) | (value << 24)) : value;
+    }
+
+
+    //=========================================================================
+    std::uint16_t get_network_uint16
+    (
+        std::uint8_t const * source
+    )
+    {
+        return static_cast<std::uint16_t>((source[0] << 8) | source[1]);
+    }
+
+
+    //=========================================================================
+    std::optional<std::size_t> get_ip_offset
+    (
+        // the offset of the ipv4 header within a frame of the given link type.
+        // none if the frame does not carry ipv4.
+        std::uint32_t linkType,
+        std::span<std::uint8_t const> frame
+    )
+    {
+        switch (linkType)
+        {
+            case pcap::linktype_raw:
+            case linktype_ipv4:
+                return 0;
+            case linktype_null:
+                if ((frame.size() >= 4) && ((frame[0] == AF_INET) || (frame[3] == AF_INET))) // host order of the capturing machine
+                    return 4;
+                return {};
+            case linktype_ethernet:
+                for (std::size_t offset = 12; (offset + 2) <= frame.size(); offset += 4)
+                {
+                    auto etherType = get_network_uint16(frame.data() + offset);
+                    if ((etherType != ethertype_vlan) && (etherType != ethertype_qinq))
+                        return (etherType == ethertype_ipv4) ? std::optional<std::size_t>(offset + 2) : std::nullopt;
+                }
+                return {};
+            case linktype_linux_sll:
+                if ((frame.size() >= 16) && (get_network_uint16(frame.data() + 14) == ethertype_ipv4))
+                    return 16;
+                return {};
+            case linktype_linux_sll2:
+                if ((frame.size() >= 20) && (get_network_uint16(frame.data()) == ethertype_ipv4))
+                    return 20;
+                return {};
+            default:
+                return {};
+        }
+    }
+
+
+    //=========================================================================
+    void add_packet
+    (
+        // decode the frame at 'offset' and add its udp payload (if any) to the
+        // packets to replay.  fragments can not be replayed and are skipped.
+        capture_contents & captureContents,
+        std::uint32_t linkType,
+        std::size_t offset,
+        std::size_t capturedLength,
+        std::uint64_t timeStamp
+    )
+    {
+        std::span<std::uint8_t const> frame(captureContents.data_.data() + offset, capturedLength);
+        auto ipOffset = get_ip_offset(linkType, frame);
+        if ((!ipOffset) || ((*ipOffset + 20) > frame.size()))
+        {
+            ++captureContents.skipped_;
+            return;
+        }
+        auto ip = frame.subspan(*ipOffset);
+        auto ipHeaderLength = static_cast<std::size_t>((ip[0] & 0x0f) * 4);
+        if (((ip[0] >> 4) != 4) || (ip[9] != IPPROTO_UDP) || ((get_network_uint16(ip.data() + 6) & 0x3fff) != 0) ||
+                ((ipHeaderLength + 8) > ip.size()))
+        {
+            ++captureContents.skipped_;
+            return;
+        }
+        auto udp = ip.subspan(ipHeaderLength);
+        auto udpLength = static_cast<std::size_t>(get_network_uint16(udp.data() + 4));
+        if ((udpLength < 8) || (udpLength > udp.size()))
+        {
+            ++captureContents.skipped_; // truncated by the snap length
+            return;
+        }
+        ::in_addr destinationAddress;
+        std::memcpy(&destinationAddress, ip.data() + 16, sizeof(destinationAddress));
+        captureContents.packets_.push_back({.timeStamp_ = timeStamp,
+                .destination_ = {ip_address(destinationAddress), port_id(get_network_uint16(udp.data() + 2))},
+                .offset_ = (offset + *ipOffset + ipHeaderLength + 8), .length_ = (udpLength - 8)});
+    }
+
+
+    //=========================================================================
+    void read_pcap
+    (
+        capture_contents & captureContents,
+        bool swap,
+        bool nanosecond
+    )
+    {
+        auto const & data = captureContents.data_;
+        auto linkType = (get_uint32(data.data() + 20, swap) & 0xffff); // upper bits carry fcs information
+        for (std::size_t offset = sizeof(pcap::file_header); (offset + sizeof(pcap::record_header)) <= data.size(); )
+        {
+            auto seconds = get_uint32(data.data() + offset, swap);
+            auto subSeconds = get_uint32(data.data() + offset + 4, swap);
+            auto capturedLength = get_uint32(data.data() + offset + 8, swap);
+            offset += sizeof(pcap::record_header);
+            if ((offset + capturedLength) > data.size())
+            {
+                std::cerr << "truncated capture file\n";
+                return;
+            }
+            add_packet(captureContents, linkType, offset, capturedLength,
+                    (seconds * 1'000'000'000ull) + (nanosecond ? subSeconds : (subSeconds * 1'000ull)));
+            offset += capturedLength;
+        }
+    }
+
+
+    //=========================================================================
+    void read_pcapng
+    (
+        // section header, interface description, enhanced and simple packet
+        // blocks are decoded.  all other blocks are ignored.
+        capture_contents & captureContents
+    )
+    {
+        struct interface
+        {
+            std::uint32_t   linkType_;
+            std::uint64_t   ticksPerSecond_;
+        };
+
+        auto const & data = captureContents.data_;
+        std::vector<interface> interfaces;
+        auto swap = false;
+        std::uint64_t timeStamp = 0; // simple packet blocks have no time stamp of their own
+        for (std::size_t offset = 0; (offset + sizeof(pcapng::block_header)) <= data.size(); )
+        {
+            if (get_uint32(data.data() + offset, false) == pcapng::section_header_block_type)
+            {
+                if ((offset + 12) > data.size())
+                    break;
+                swap = (get_uint32(data.data() + offset + 8, false) != pcapng::byte_order_magic);
+                interfaces.clear();
+            }
+            auto type = get_uint32(data.data() + offset, swap);
+            auto totalLength = get_uint32(data.data() + offset + 4, swap);
+            if ((totalLength < 12) || ((offset + totalLength) > data.size()))
+            {
+                std::cerr << "truncated capture file\n";
+                return;
+            }
+            auto body = (offset + sizeof(pcapng::block_header));
+            auto bodyEnd = (offset + totalLength - 4);
+            if ((type == pcapng::interface_description_block_type) && ((body + 8) <= bodyEnd))
+            {
+                interface newInterface{.linkType_ = get_uint16(data.data() + body, swap), .ticksPerSecond_ = 1'000'000};
+                for (auto option = (body + 8); (option + 4) <= bodyEnd; )
+                {
+                    auto code = get_uint16(data.data() + option, swap);
+                    auto length = get_uint16(data.data() + option + 2, swap);
+                    if (code == pcapng::option_end)
+                        break;
+                    if ((code == pcapng::option_if_tsresol) && (length >= 1) && ((option + 5) <= bodyEnd))
+                    {
+                        auto resolution = data[option + 4];
+                        newInterface.ticksPerSecond_ = (resolution & 0x80) ? (1ull << (resolution & 0x7f)) :
+                                static_cast<std::uint64_t>(std::pow(10.0, resolution));
+                    }
+                    option += (4 + ((length + 3) & ~3));
+                }
+                interfaces.push_back(newInterface);
+            }
+            else if ((type == pcapng::enhanced_packet_block_type) && ((body + 20) <= bodyEnd))
+            {
+                auto interfaceId = get_uint32(data.data() + body, swap);
+                auto ticks = ((static_cast<std::uint64_t>(get_uint32(data.data() + body + 4, swap)) << 32) | get_uint32(data.data() + body + 8, swap));
+                auto capturedLength = get_uint32(data.data() + body + 12, swap);
+                if ((interfaceId < interfaces.size()) && ((body + 20 + capturedLength) <= bodyEnd))
+                {
+                    auto ticksPerSecond = interfaces[interfaceId].ticksPerSecond_;
+                    timeStamp = ((ticks / ticksPerSecond) * 1'000'000'000ull) +
+                            static_cast<std::uint64_t>((ticks % ticksPerSecond) * (1e9 / ticksPerSecond));
+                    add_packet(captureContents, interfaces[interfaceId].linkType_, body + 20, capturedLength, timeStamp);
+                }
+                else
+                {
+                    ++captureContents.skipped_;
+                }
+            }
+            else if ((type == pcapng::simple_packet_block_type) && ((body + 4) <= bodyEnd) && (!interfaces.empty()))
+            {
+                auto capturedLength = std::min<std::size_t>(get_uint32(data.data() + body, swap), bodyEnd - (body + 4));
+                add_packet(captureContents, interfaces.front().linkType_, body + 4, capturedLength, timeStamp);
+            }
+            offset += totalLength;
+        }
+    }
+
+
+    //=========================================================================
+    std::optional<capture_contents> read_capture_file
+    (
+        // the udp payloads of a pcap (micro or nanosecond, either byte order)
+        // or pcapng file in file order
+        std::string const & path
+    )
+    {
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream)
+        {
+            std::cerr << "failed to open " << path << "\n";
+            return {};
+        }
+        capture_contents captureContents;
+        captureContents.data_.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        if (captureContents.data_.size() < sizeof(pcap::file_header))
+        {
+            std::cerr << path << " is not a capture file\n";
+            return {};
+        }
+        switch (auto magic = get_uint32(captureContents.data_.data(), false); magic)
+        {
+            case pcap::microsecond_magic: read_pcap(captureContents, false, false); break;
+            case pcap::nanosecond_magic: read_pcap(captureContents, false, true); break;
+            case pcapng::section_header_block_type: read_pcapng(captureContents); break;
+            default:
+                if (get_uint32(captureContents.data_.data(), true) == pcap::microsecond_magic)
+                    read_pcap(captureContents, true, false);
+                else if (get_uint32(captureContents.data_.data(), true) == pcap::nanosecond_magic)
+                    read_pcap(captureContents, true, true);
+                else
+                {
+                    std::cerr << path << " is not a capture file\n";
+                    return {};
+                }
+                break;
+        }
+        return captureContents;
+    }
+
+
+    //=========================================================================
+    void wait_until
+    (
+        // sleep while the deadline is distant then spin for the final stretch
+        // so that the send is released within a microsecond or so of the
+        // deadline (sleep alone is only accurate to tens of microseconds)
+        std::chrono::steady_clock::time_point deadline
+    )
+    {
+        if (auto remaining = (deadline - std::chrono::steady_clock::now()); remaining > spin_threshold)
+            std::this_thread::sleep_for(remaining - spin_threshold);
+        while (std::chrono::steady_clock::now() < deadline)
+            ;
+    }
+
+
+    //=========================================================================
+    packet create_packet
+    (
+        capture_contents const & captureContents,
+        replay_packet const & replayPacket
+    )
+    {
+        packet result(replayPacket.length_);
+        result.resize(replayPacket.length_);
+        std::memcpy(result.data(), captureContents.data_.data() + replayPacket.offset_, replayPacket.length_);
+        return result;
+    }
+
+
+    //=========================================================================
+    void print_lateness
+    (
+        // percentiles of the delay (microseconds) between each packet's
+        // scheduled time and the time that it was queued or sent
+        char const * name,
+        std::vector<std::int64_t> lateness
+    )
+    {
+        std::erase(lateness, std::numeric_limits<std::int64_t>::min()); // failed sends
+        if (lateness.empty())
+            return;
+        std::sort(lateness.begin(), lateness.end());
+        auto percentile = [&](double p){return lateness[std::min(static_cast<std::size_t>(p * lateness.size()), lateness.size() - 1)] / 1000.0;};
+        std::cout << name << "_lateness_us: p50 = " << percentile(0.5) << ", p99 = " << percentile(0.99) <<
+                ", p999 = " << percentile(0.999) << ", max = " << (lateness.back() / 1000.0) << "\n";
+    }
+
+
+    //=========================================================================
+    socket_address parse_socket_address
+    (
+        std::string const & value
+    )
+    {
+        return socket_address(std::span<char const>(value.data(), value.size()));
+    }
+
+
+    //=========================================================================
+    bool is_same_address
+    (
+        socket_address a,
+        socket_address b
+    )
+    {
+        return ((a.get_ip_address() == b.get_ip_address()) && (a.get_port_id().get() == b.get_port_id().get()));
+    }
+
+
+    //=========================================================================
+    void print_usage
+    (
+    )
+    {
+        std::cout << "usage: pcap_replay <capture file> [options]\n"
+                "  replays the udp payloads of a pcap or pcapng capture via a udp socket\n"
+                "  --interface=<name>       network interface to send from (default lo)\n"
+                "  --speed=<factor>         replay at this multiple of the captured rate (default 1)\n"
+                "  --max-rate               ignore the captured timing and send as fast as possible\n"
+                "  --destination=<ip:port>  send every payload to this address rather than its captured destination\n"
+                "  --filter=<ip:port>       only replay payloads which were captured with this destination\n"
+                "  --loop=<count>           replay the capture this many times (default 1)\n"
+                "  multicast destinations require a multicast capable interface (on linux: ip link set lo multicast on)\n";
+    }
+
+} // namespace
+
+
+//=============================================================================
+int main
+(
+    int argc,
+    char ** argv
+)
+{
+    using namespace std::chrono;
+
+    std::string path;
+    std::string interfaceName = "lo";
+    auto speed = 1.0;
+    auto maxRate = false;
+    socket_address destination;
+    std::optional<socket_address> filter;
+    std::uint64_t loops = 1;
+    for (auto i = 1; i < argc; ++i)
+    {
+        std::string argument(argv[i]);
+        if (argument == "--help")
+        {
+            print_usage();
+            return 0;
+        }
+        else if (argument.starts_with("--interface="))
+            interfaceName = argument.substr(std::strlen("--interface="));
+        else if (argument.starts_with("--speed="))
+            speed = std::stod(argument.substr(std::strlen("--speed=")));
+        else if (argument == "--max-rate")
+            maxRate = true;
+        else if (argument.starts_with("--destination="))
+            destination = parse_socket_address(argument.substr(std::strlen("--destination=")));
+        else if (argument.starts_with("--filter="))
+            filter = parse_socket_address(argument.substr(std::strlen("--filter=")));
+        else if (argument.starts_with("--loop="))
+            loops = std::max(std::stoull(argument.substr(std::strlen("--loop="))), 1ull);
+        else if ((!argument.starts_with("--")) && (path.empty()))
+            path = argument;
+        else
+        {
+            std::cerr << "unknown argument: " << argument << "\n";
+            print_usage();
+            return -1;
+        }
+    }
+    if ((path.empty()) || (speed <= 0))
+    {
+        print_usage();
+        return -1;
+    }
+
+    auto captureContents = read_capture_file(path);
+    if (!captureContents)
+        return -1;
+    auto & packets = captureContents->packets_;
+    if (filter)
+        std::erase_if(packets, [&](auto const & replayPacket){return !is_same_address(replayPacket.destination_, *filter);});
+    if (packets.empty())
+    {
+        std::cerr << "no udp packets to replay\n";
+        return -1;
+    }
+
+    auto networkInterfaceConfiguration = get_network_interface_configuration(interfaceName);
+    if (!networkInterfaceConfiguration.ipAddress_.is_valid())
+    {
+        std::cerr << "network interface " << interfaceName << " not found\n";
+        return -1;
+    }
+    virtual_network_interface networkInterface({.networkInterfaceConfiguration_ = networkInterfaceConfiguration});
+    std::jthread serviceThread([&](std::stop_token const & stopToken){while (!stopToken.stop_requested()) networkInterface.service_sockets();});
+    auto udpSocket = networkInterface.create_udp_socket({.sendQueueSize_ = send_queue_size, .multicastLoop_ = true}, {});
+    if (!udpSocket.is_valid())
+    {
+        std::cerr << "failed to create udp socket\n";
+        return -1;
+    }
+
+    // the schedule of each packet relative to the start of its loop.  captures
+    // are not always in time order so the schedule is kept monotonic.  loops
+    // are separated by the mean interval between packets.
+    std::vector<nanoseconds> schedule(packets.size());
+    for (std::size_t i = 1; i < packets.size(); ++i)
+    {
+        auto elapsed = (packets[i].timeStamp_ > packets[0].timeStamp_) ? (packets[i].timeStamp_ - packets[0].timeStamp_) : 0;
+        schedule[i] = std::max(schedule[i - 1], nanoseconds(static_cast<std::int64_t>(elapsed / speed)));
+    }
+    auto loopDuration = schedule.back() + ((packets.size() > 1) ? (schedule.back() / static_cast<std::int64_t>(packets.size() - 1)) : nanoseconds(0));
+
+    // lateness upon send is recorded by the send completion on the service thread
+    struct send_state
+    {
+        std::vector<steady_clock::time_point>   deadlines_;
+        std::vector<std::int64_t>               sendLateness_;
+        std::atomic<std::uint64_t>              completed_{0};
+        std::atomic<std::uint64_t>              failed_{0};
+    } sendState;
+    auto totalPackets = (packets.size() * loops);
+    sendState.deadlines_.resize(totalPackets);
+    sendState.sendLateness_.resize(totalPackets, std::numeric_limits<std::int64_t>::min());
+    std::vector<std::int64_t> queueLateness;
+    queueLateness.reserve(maxRate ? 0 : totalPackets);
+
+    std::uint64_t bytes = 0;
+    std::uint64_t sendQueueFull = 0;
+    auto start = steady_clock::now();
+    for (std::uint64_t loop = 0; loop < loops; ++loop)
+    {
+        for (std::size_t i = 0; i < packets.size(); ++i)
+        {
+            auto index = ((loop * packets.size()) + i);
+            auto const & replayPacket = packets[i];
+            auto packetDestination = destination.is_valid() ? destination : replayPacket.destination_;
+            auto p = create_packet(*captureContents, replayPacket); // prior to the deadline
+            if (maxRate)
+            {
+                sendState.deadlines_[index] = steady_clock::now();
+            }
+            else
+            {
+                auto deadline = (start + (static_cast<std::int64_t>(loop) * loopDuration) + schedule[i]);
+                sendState.deadlines_[index] = deadline;
+                wait_until(deadline);
+                queueLateness.push_back(duration_cast<nanoseconds>(steady_clock::now() - deadline).count());
+            }
+            send_completion_token sendCompletionToken([state = &sendState, index](void *, std::int32_t errorCode)
+                    {
+                        if (errorCode == 0)
+                            state->sendLateness_[index] = duration_cast<nanoseconds>(steady_clock::now() - state->deadlines_[index]).count();
+                        else
+                            state->failed_.fetch_add(1, std::memory_order_relaxed);
+                        state->completed_.fetch_add(1, std::memory_order_release);
+                    });
+            while (!udpSocket.send_to(packetDestination, std::move(p), sendCompletionToken))
+            {
+                if (!udpSocket.is_valid())
+                {
+                    // the send was rejected because the socket is closed rather than because its queue is full
+                    serviceThread.request_stop();
+                    serviceThread.join();
+                    std::cerr << "udp socket closed\n";
+                    return -1;
+                }
+                ++sendQueueFull;
+                std::this_thread::yield();
+                p = create_packet(*captureContents, replayPacket); // a rejected packet is consumed
+            }
+            bytes += replayPacket.length_;
+        }
+    }
+    for (auto deadline = steady_clock::now() + completion_timeout;
+            (sendState.completed_.load(std::memory_order_acquire) < totalPackets) && (steady_clock::now() < deadline); )
+        std::this_thread::yield();
+    auto elapsed = duration_cast<duration<double>>(steady_clock::now() - start).count();
+    // sends which did not complete within the timeout could otherwise still be 
+    // recording their lateness while it is reported
+    serviceThread.request_stop();
+    serviceThread.join();
+
+    std::cout << "packets: " << totalPackets << "\n"
+            << "bytes: " << bytes << "\n"
+            << "skipped: " << captureContents->skipped_ << " (not ipv4 udp, fragmented or truncated)\n"
+            << "completed: " << sendState.completed_ << "\n"
+            << "failed: " << sendState.failed_ << "\n"
+            << "send_queue_full: " << sendQueueFull << "\n"
+            << "elapsed_seconds: " << elapsed << "\n"
+            << "packets_per_second: " << (totalPackets / elapsed) << "\n"
+            << "megabits_per_second: " << ((bytes * 8) / elapsed / 1e6) << "\n";
+    if (!maxRate)
+    {
+        print_lateness("queue", std::move(queueLateness));
+        print_lateness("send", std::move(sendState.sendLateness_));
+    }
+    return (sendState.failed_ == 0) ? 0 : -1;
+}
@@ -0,0 +1,177 @@
+#include <library/network/instrumentation/trace.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <vector>
+
+
+namespace
+{
+
+    using namespace bcpp::network;
+
+
+    //=========================================================================
+    struct decoded_event
+    {
+        std::uint32_t   threadIndex_;
+        trace_event     traceEvent_;
+    };
+
+
+    //=========================================================================
+    // read every ring of a trace file (see trace_recorder::dump).  returns the
+    // events of all threads in time order.
+    std::optional<std::vector<decoded_event>> read_trace_file
+    (
+        std::string const & path,
+        double & ticksPerNanosecond
+    )
+    {
+        std::ifstream stream(path, std::ios::binary);
+        if (!stream)
+        {
+            std::cerr << "failed to open " << path << "\n";
+            return {};
+        }
+
+        trace_file_header fileHeader;
+        if ((!stream.read(reinterpret_cast<char *>(&fileHeader), sizeof(fileHeader))) ||
+                (std::memcmp(fileHeader.magic_, trace_file_header::magic, sizeof(fileHeader.magic_)) != 0))
+        {
+            std::cerr << path << " is not a trace file\n";
+            return {};
+        }
+        if ((fileHeader.version_ != trace_file_header::current_version) || (fileHeader.eventSize_ != sizeof(trace_event)))
+        {
+            std::cerr << "unsupported trace file version " << fileHeader.version_ << "\n";
+            return {};
+        }
+        ticksPerNanosecond = (fileHeader.ticksPerNanosecond_ > 0) ? fileHeader.ticksPerNanosecond_ : 1.0;
+
+        std::vector<decoded_event> events;
+        for (auto i = 0u; i < fileHeader.ringCount_; ++i)
+        {
+            trace_ring_header ringHeader;
+            if (!stream.read(reinterpret_cast<char *>(&ringHeader), sizeof(ringHeader)))
+            {
+                std::cerr << "truncated trace file\n";
+                return {};
+            }
+            for (auto j = 0ull; j < ringHeader.eventCount_; ++j)
+            {
+                decoded_event decodedEvent{.threadIndex_ = ringHeader.threadIndex_};
+                if (!stream.read(reinterpret_cast<char *>(&decodedEvent.traceEvent_), sizeof(trace_event)))
+                {
+                    std::cerr << "truncated trace file\n";
+                    return {};
+                }
+                events.push_back(decodedEvent);
+            }
+        }
+        std::stable_sort(events.begin(), events.end(), [](auto const & a, auto const & b){return (a.traceEvent_.tsc_ < b.traceEvent_.tsc_);});
+        return events;
+    }
+
+
+    //=========================================================================
+    void print_usage
+    (
+    )
+    {
+        std::cout << "usage: trace_decoder <trace file> [options]\n"
+                "  --socket=<id>            only events of the specified socket\n"
+                "  --format=<format>        text or csv (default text)\n"
+                "  --summary                print only the number of events of each type\n";
+    }
+
+} // namespace
+
+
+//=============================================================================
+int main
+(
+    int argc,
+    char ** argv
+)
+{
+    std::string path;
+    std::optional<std::uint64_t> socketId;
+    auto csv = false;
+    auto summary = false;
+    for (auto i = 1; i < argc; ++i)
+    {
+        std::string argument(argv[i]);
+        if (argument == "--help")
+        {
+            print_usage();
+            return 0;
+        }
+        else if (argument.starts_with("--socket="))
+            socketId = std::stoull(argument.substr(std::strlen("--socket=")));
+        else if (argument == "--format=csv")
+            csv = true;
+        else if (argument == "--format=text")
+            csv = false;
+        else if (argument == "--summary")
+            summary = true;
+        else if ((!argument.starts_with("--")) && (path.empty()))
+            path = argument;
+        else
+        {
+            std::cerr << "unknown argument: " << argument << "\n";
+            print_usage();
+            return -1;
+        }
+    }
+    if (path.empty())
+    {
+        print_usage();
+        return -1;
+    }
+
+    double ticksPerNanosecond = 1.0;
+    auto events = read_trace_file(path, ticksPerNanosecond);
+    if (!events)
+        return -1;
+    if (socketId)
+        std::erase_if(*events, [&](auto const & decodedEvent){return (decodedEvent.traceEvent_.socketId_ != *socketId);});
+
+    if (summary)
+    {
+        std::array<std::uint64_t, 16> counts{};
+        for (auto const & decodedEvent : *events)
+            ++counts[static_cast<std::size_t>(decodedEvent.traceEvent_.type_) % counts.size()];
+        for (auto i = 0u; i < counts.size(); ++i)
+            if (counts[i] > 0)
+                std::cout << std::left << std::setw(24) << to_string(static_cast<trace_event_type>(i)) << counts[i] << "\n";
+        return 0;
+    }
+
+    // times are reported in nanoseconds relative to the first event
+    auto firstTsc = (events->empty()) ? 0 : events->front().traceEvent_.tsc_;
+    if (csv)
+        std::cout << "time_ns,thread,event,socket,value\n";
+    for (auto const & [threadIndex, traceEvent] : *events)
+    {
+        auto time = static_cast<std::uint64_t>((traceEvent.tsc_ - firstTsc) / ticksPerNanosecond);
+        if (csv)
+        {
+            std::cout << time << "," << threadIndex << "," << to_string(traceEvent.type_) << "," << traceEvent.socketId_ << "," << traceEvent.value_ << "\n";
+            continue;
+        }
+        std::cout << std::right << std::setw(16) << time << "  " << std::setw(4) << threadIndex << "  " << std::left << std::setw(20) << to_string(traceEvent.type_) 
+                << std::right << std::setw(10) << traceEvent.socketId_ << "  " << traceEvent.value_;
+        if ((traceEvent.type_ == trace_event_type::receive_error) || (traceEvent.type_ == trace_event_type::send_error))
+            std::cout << " (" << std::strerror(traceEvent.value_) << ")";
+        std::cout << "\n";
+    }
+    return 0;
+}